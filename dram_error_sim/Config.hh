@@ -93,74 +93,120 @@ POSSIBILITY OF SUCH DAMAGE.
 #define SAME_BANKIDX_MASK SBANK_MASK
 #elif AutogenMASK == 2
 
-//[Rank][Bank][Bankgroup][Row][Column]
+#include <stdio.h>
+#include <memory>
+#include <string>
+
+/** @class DramGeometry
+ * \brief Organization, address masks and per-chip component counts of one
+ * DRAM type
+ * @details Built once per type (see get()) and never modified afterwards,
+ * so DomainGroups of the same or of different types share them freely. A
+ * DomainGroup keeps the geometry selected by setup_configs() when it was
+ * built and hands it to its FaultDomains, their faults and their fault rate
+ * catalogs.
+ */
+struct DramGeometry {
+  //[Rank][Bank][Bankgroup][Row [Cross_subarray][Within_subarray]][Column]
+  std::string type;  //!< as given to setup_configs(), e.g. "DDR5"
+  bool isComboDRAM;
+  int size_per_DRAMchip;  // Size in Gbit
+  int Burstlen;
+  int byN;
+  int BankperBankGroup;
+  int Bankgroup;
+  int numofBanks;  // number of banks per chip
+  int numofRanks;
+  float row_buffer_size;  // in KB per banks
+
+  int mat_row;
+  int mat_col;
+  int subarray_col_size;
+  int subbank_size;
+  int subarrays_per_subbank;
+  int total_row;
+
+  int row_address;
+  int crosssubarray_address;
+  int combo_bit;
+  int subarray_address;
+  int subarray_per_subbank_address;
+  int column_address;
+  int totalbits;
+
+  int column_address_bits;
+  int row_address_bits;
+  int subarray_address_bits;
+
+  unsigned long long combo_mask;
+  unsigned long long DEFAULT_MASK = 0;
+  unsigned long long SBIT_MASK = 0;
+  unsigned long long SWORD_MASK = 0;
+  unsigned long long SCOL_MASK = 0;
+  unsigned long long SROW_MASK = 0;
+  unsigned long long SBANK_MASK = 0;
+  unsigned long long SBANK_MASK_DEGRADE = 0;
+  unsigned long long MBANK_MASK = 0;
+  unsigned long long SAME_BANKGROUP_MASK = 0;
+  unsigned long long SAME_BANKIDX_MASK = 0;
+  unsigned long long MRANK_MASK = 0;
+  unsigned long long CHANNEL_MASK = 0;
+  unsigned long long BLSA_MASK = 0;
+  unsigned long long BANK_PATTERN_MASK = 0;
+  unsigned long long CDEC_MASK = 0;
+  unsigned long long CSL_MASK = 0;
+  unsigned long long RDEC_MASK = 0;
+  unsigned long long SWD_MASK = 0;
+  unsigned long long LWL_MASK = 0;
+
+  // basic parameter calculation part
+  // Bitline sense amplifier
+  int BLSA_per_subarray;
+  int BLSA_per_bank;
+  int BLSA_per_chip;
+  // Wordline Driver
+  int WLD_per_subarray;
+  int WLD_per_bank;
+  int WLD_per_chip;
+  // Column select line
+  int CSL_per_subbank;
+  int CSL_per_bank;
+  int CSL_per_chip;
+  // Row decoder
+  int RDEC_per_bank;
+  int RDEC_per_chip;
+  int RDEC_SUBBANK_per_chip;
+  // Column decoder
+  int CDEC_per_bank;
+  int CDEC_per_chip;
+  // Bank selector
+  int BSEL_per_chip = 1;
+  // Memory controller <-> Memory
+  int MC2MEM = 1;
+  int BITS_per_chip;
+
+  //! "addressMasks" derives the *_MASK values from the organization.
+  //! Without it they stay zero (combo_mask aside), as in every simulation
+  //! so far: setup_configs() computed them into locals that shadowed the
+  //! globals. Turning them on changes the fault overlap checks and the
+  //! retirement block counts, so it is left to an explicit choice.
+  explicit DramGeometry(const char *type, bool addressMasks = false);
+
+  bool is(const char *name) const { return type == name; }
+  //! address bits within a rank
+  unsigned long long rankAddrMask() const { return MRANK_MASK ^ DEFAULT_MASK; }
+  //! the per-chip component counts the fault rates scale with
+  void printCounts(FILE *fd) const;
+
+  //! shared geometry of "type" (built on first use)
+  static std::shared_ptr<const DramGeometry> get(const char *type);
+  //! geometry of the DomainGroups this thread builds next (setup_configs())
+  static std::shared_ptr<const DramGeometry> getDefault();
+  static void setDefault(std::shared_ptr<const DramGeometry> geometry);
+};
+
+//! select the geometry of "type_char" for the systems built next
 void setup_configs(char* type_char);
-extern unsigned long long DEFAULT_MASK;
-extern  unsigned long long SBIT_MASK ;
-extern  unsigned long long SWORD_MASK;
-extern  unsigned long long SCOL_MASK;
-extern  unsigned long long SROW_MASK ;
-extern  unsigned long long SBANK_MASK;
-extern unsigned long long SBANK_MASK_DEGRADE;
-extern  unsigned long long MBANK_MASK ;
-extern  unsigned long long SAME_BANKGROUP_MASK;
-extern  unsigned long long SAME_BANKIDX_MASK ;
-extern  unsigned long long MRANK_MASK ;
-extern  unsigned long long CHANNEL_MASK;
-extern unsigned long long BLSA_MASK ;
-extern unsigned long long BANK_PATTERN_MASK;
-extern unsigned long long CDEC_MASK;
-extern unsigned long long CSL_MASK;
-extern unsigned long long RDEC_MASK;
-extern unsigned long long SWD_MASK;
-extern unsigned long long LWL_MASK;
-extern unsigned long long combo_mask;
-
-extern int subarray_address_bits;
-extern int row_address_bits;
-extern int column_address_bits;
-
-extern int mat_row;
-extern int mat_col;
-extern int numofBanks;
-
-extern int subarray_col_size;
-extern int subbank_size;
-extern int subarrays_per_subbank;
-extern int total_row;
-
-// basic parameter calculation part
-// Bitline sense amplifier
-extern int BLSA_per_subarray;
-extern int BLSA_per_bank;
-extern int BLSA_per_chip;
-
-// Wordline Driver
-extern int WLD_per_subarray;
-extern int WLD_per_bank;
-extern int WLD_per_chip;
-
-// Column select line
-extern int CSL_per_subbank;
-extern int CSL_per_bank;
-extern int CSL_per_chip;
-
-// Row decoder
-extern int RDEC_per_bank;
-extern int RDEC_per_chip;
-extern int RDEC_SUBBANK_per_chip;
-
-// Column decoder
-extern int CDEC_per_bank;
-extern int CDEC_per_chip;
-
-// Bank selector
-extern int BSEL_per_chip;
-
-// Memory controller <-> Memory
-extern int MC2MEM;
-
-extern int BITS_per_chip;
 
 #endif
 
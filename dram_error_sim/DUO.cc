@@ -39,6 +39,7 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #include "DUO.hh"
 #include "FaultDomain.hh"
+#include "Profile.hh"
 #include "hsiao.hh"
 #include "combination.hh"
 //#define BF_search
@@ -126,9 +127,9 @@ unsigned long long DUO64bx4::getInitialRetiredBlkCount(FaultDomain *fd,
                              (1 - goodSymProb);
 
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 64;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 64;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -179,9 +180,11 @@ ErrorType DUO72bx4::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
       if (decoded.isZero())
         result = CE;
       else {
-        printf("SDC from RS correction\n");
-        msg.print();
-        decoded.print();
+        if (verbose) {
+          printf("SDC from RS correction\n");
+          msg.print();
+          decoded.print();
+        }
       }
     }
   } else if (result == DUE) {
@@ -282,9 +285,9 @@ unsigned long long DUO72bx4::getInitialRetiredBlkCount(FaultDomain *fd,
                              (1 - goodSymProb);
 
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 64;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 64;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -335,9 +338,11 @@ ErrorType DUO72bx8::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
       if (decoded.isZero())
         result = CE;
       else {
-        printf("SDC from RS correction\n");
-        msg.print();
-        decoded.print();
+        if (verbose) {
+          printf("SDC from RS correction\n");
+          msg.print();
+          decoded.print();
+        }
       }
     }
   } else if (result == DUE) {
@@ -475,9 +480,9 @@ unsigned long long DUO72bx8::getInitialRetiredBlkCount(FaultDomain *fd,
                              (1 - goodSymProb);
 
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 64;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 64;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -533,9 +538,11 @@ ErrorType DUO36bx4::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
       if (decoded.isZero())
         result = CE;
       else {
-        printf("SDC from RS correction\n");
-        msg.print();
-        decoded.print();
+        if (verbose) {
+          printf("SDC from RS correction\n");
+          msg.print();
+          decoded.print();
+        }
       }
     }
   } else if (result == DUE) {
@@ -592,9 +599,11 @@ ErrorType DUO36bx4::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
         }
         return CE;
       } else if (tmp_result == SDC) {
-        printf("SDC happen during erasure fix\n\n");
-        tmp_msg.print();
-        tmp_decoded.print();
+        if (verbose) {
+          printf("SDC happen during erasure fix\n\n");
+          tmp_msg.print();
+          tmp_decoded.print();
+        }
         return SDC;
       } else {
         // GONG: testing aggressive correction
@@ -634,9 +643,11 @@ ErrorType DUO36bx4::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
 
         if(tmp_result==CE || tmp_result==SDC){
           if(tmp_result==SDC){
-            printf("SDC happen During 4bit+erasure fix\n\n");
-            tmp_msg.print();
-            tmp_decoded.print();
+            if (verbose) {
+              printf("SDC happen During 4bit+erasure fix\n\n");
+              tmp_msg.print();
+              tmp_decoded.print();
+            }
          }
          return tmp_result;
         }
@@ -650,9 +661,11 @@ ErrorType DUO36bx4::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
     assert(0);  // NE
   }
   if (result == SDC){
-    printf("SDC happen at the END?\n\n");
-    msg.print();
-    decoded.print();
+    if (verbose) {
+      printf("SDC happen at the END?\n\n");
+      msg.print();
+      decoded.print();
+    }
   }
   return result;
 }
@@ -710,9 +723,9 @@ unsigned long long DUO36bx4::getInitialRetiredBlkCount(FaultDomain *fd,
                              (1 - goodSymProb);
 
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 64;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 64;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -842,8 +855,10 @@ ErrorType DUO64bx4_::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
         }
         return CE;
       } else if (tmp_result == SDC) {
-        printf("SDC from erasure RS correction\n");
-        errorBlk.print();
+        if (verbose) {
+          printf("SDC from erasure RS correction\n");
+          errorBlk.print();
+        }
         return SDC;
       }
     } else {  // DUE?
@@ -869,9 +884,9 @@ unsigned long long DUO64bx4_::getInitialRetiredBlkCount(FaultDomain *fd,
                              (1 - goodSymProb);
 
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 64;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 64;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -925,9 +940,11 @@ ErrorType DUO20bx4_34::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
       if (decoded.isZero())
         result = CE;
       else {
-        printf("SDC from RS correction\n");
-        msg.print();
-        decoded.print();
+        if (verbose) {
+          printf("SDC from RS correction\n");
+          msg.print();
+          decoded.print();
+        }
       }
     }
   } else if (result == DUE) {
@@ -970,9 +987,11 @@ ErrorType DUO20bx4_34::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
         }
         return CE;
       } else if (tmp_result == SDC) {
-        printf("SDC happen during erasure fix\n\n");
-        tmp_msg.print();
-        tmp_decoded.print();
+        if (verbose) {
+          printf("SDC happen during erasure fix\n\n");
+          tmp_msg.print();
+          tmp_decoded.print();
+        }
         return SDC;
       } 
     } else {  // DUE?
@@ -981,9 +1000,11 @@ ErrorType DUO20bx4_34::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
     assert(0);  // NE
   }
   if (result == SDC){
-    printf("SDC happen at the END?\n\n");
-    msg.print();
-    decoded.print();
+    if (verbose) {
+      printf("SDC happen at the END?\n\n");
+      msg.print();
+      decoded.print();
+    }
   }
   return result;
 }
@@ -1002,9 +1023,9 @@ unsigned long long DUO20bx4_34::getInitialRetiredBlkCount(FaultDomain *fd,
                              (1 - goodSymProb);
 
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 64;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 64;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -1063,9 +1084,11 @@ ErrorType DUO20bx4_33::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
       if (decoded.isZero())
         result = CE;
       else {
-        printf("SDC from RS correction\n");
-        msg.print();
-        decoded.print();
+        if (verbose) {
+          printf("SDC from RS correction\n");
+          msg.print();
+          decoded.print();
+        }
       }
     }
   } else if (result == DUE) {
@@ -1106,9 +1129,11 @@ ErrorType DUO20bx4_33::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
         }
         return CE;
       } else if (tmp_result == SDC) {
-        printf("SDC happen during erasure fix\n\n");
-        tmp_msg.print();
-        tmp_decoded.print();
+        if (verbose) {
+          printf("SDC happen during erasure fix\n\n");
+          tmp_msg.print();
+          tmp_decoded.print();
+        }
         return SDC;
       } else {
         // GONG: testing aggressive correction
@@ -1139,9 +1164,11 @@ ErrorType DUO20bx4_33::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
 
         if(tmp_result==CE || tmp_result==SDC){
           if(tmp_result==SDC){
-            printf("SDC happen During 4bit+erasure fix\n\n");
-            tmp_msg.print();
-            tmp_decoded.print();
+            if (verbose) {
+              printf("SDC happen During 4bit+erasure fix\n\n");
+              tmp_msg.print();
+              tmp_decoded.print();
+            }
          }
          return tmp_result;
         }
@@ -1156,9 +1183,11 @@ ErrorType DUO20bx4_33::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
   }
 
   if (result == SDC){
-    printf("SDC happen at the END?\n\n");
-    msg.print();
-    decoded.print();
+    if (verbose) {
+      printf("SDC happen at the END?\n\n");
+      msg.print();
+      decoded.print();
+    }
   }
   return result;
 }
@@ -1200,9 +1229,9 @@ unsigned long long DUO20bx4_33::getInitialRetiredBlkCount(FaultDomain *fd,
                              (1 - goodSymProb);
 
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 64;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 64;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -1217,7 +1246,7 @@ void DUO20bx4_33::getErasureLocation_internal(std::list<int>* ErasureLocation,in
 
 int DUO::bruteForceSearch(FaultDomain *fd, list<int> *chip_list,
                 CacheLine* blk,int num_chips){
-  
+  PROFILE_SCOPE(PROF_BRUTE_FORCE);
   //Initialization
   ECCWord msg = {codec->getBitN(), codec->getBitK()};
   ECCWord decoded = {codec->getBitN(), codec->getBitK()};
@@ -1246,6 +1275,8 @@ int DUO::bruteForceSearch(FaultDomain *fd, list<int> *chip_list,
   Combination< int,vector<int> >(lists,1,candidates);
   //candidates == {0,1,2,3,4,5,6,7,8}
   
+  // the other blocks of the row are drawn by the decoder
+  DecoderDraws draws;
   const int MAX_TRIAL = 16;
   for (int trial=0 ; trial<MAX_TRIAL; trial++){  
     std::vector< vector <int> > tmp_candidates;
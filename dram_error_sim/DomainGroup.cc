@@ -51,7 +51,18 @@ char ErrorENUMNAME[][16] = {"SBIT ", "SWORD ", "SCOL ", "SROW ", "LOCALWORDLINE"
 "INHERENT2 ","INHERENT3 ","INHERENT4 ","INHERENT5 ","INHERENT6 "};
 
 
-FaultDomain *DomainGroup::pickRandomFD() {
+void DomainGroup::initRateTree() {
+  FDVec.assign(FDList.begin(), FDList.end());
+  rateTree.resize(FDVec.size());
+  biasedRates = FaultRateCatalog::isBiased();
+  if (biasedRates) nominalTree.resize(FDVec.size());
+  for (int i = 0; i < (int)FDVec.size(); i++) {
+    FDVec[i]->groupIdx = i;
+    updateRate(FDVec[i]);
+  }
+}
+
+FaultDomain *DomainGroup::pickRandomFD(double hr) {
   // ErrorType result;
   // int posFD = rand() % FDList.size();
   // auto it = FDList.begin();
@@ -59,28 +70,70 @@ FaultDomain *DomainGroup::pickRandomFD() {
   //    ++it;
   //}
   // return *it;
-  double totalRate = getFaultRate();
+  double draw = (double)timelineRand() / RAND_MAX;
+  return getFD(rateTree.find(draw * rateTree.total()), hr);
+}
 
-  double draw = (double)rand() / RAND_MAX;
-  double sum = .0;
-  for (auto it = FDList.begin(); it != FDList.end(); it++) {
-    sum += (*it)->getFaultRate();
-    if ((sum / totalRate) >= draw) {
-      return *it;
-    }
+FaultDomain *DomainGroup::getFD(int idx, double hr) {
+  FaultDomain *fd = FDVec[idx];
+  if (!fd->touched) {
+    fd->touched = true;
+    touchedFDs.push_back(fd);
+    if (initialRetireECC != NULL)
+      fd->setInitialRetiredBlkCount(initialRetireECC, initialRetireRate);
+  }
+  fd->expireTransients(hr);
+  return fd;
+}
+
+// Only the domains picked during the run can hold faults or a raised inherent
+// rate, so a run with few events is cleared in O(1) instead of O(#domains).
+void DomainGroup::clear() {
+  for (auto it = touchedFDs.begin(); it != touchedFDs.end(); ++it) {
+    clearDomain(*it);
+  }
+  touchedFDs.clear();
+}
+
+void DomainGroup::clearDomain(FaultDomain *fd) {
+  fd->clear();
+  if (inherentFault != NULL) {
+    fd->resetInherentFault(inherentFault, inherentECC);
+    updateRate(fd);
+  }
+  fd->touched = false;
+}
+
+void DomainGroup::saveState(DomainGroupState *state) const {
+  state->touchedFDs = touchedFDs;
+  state->domains.clear();
+  for (auto it = touchedFDs.begin(); it != touchedFDs.end(); ++it) {
+    state->domains.emplace_back(new FaultDomainState());
+    (*it)->saveState(state->domains.back().get());
+  }
+}
+
+void DomainGroup::restoreState(const DomainGroupState &state) {
+  // touchedFDs only grows during a run: the saved domains are a prefix
+  for (size_t i = state.touchedFDs.size(); i < touchedFDs.size(); i++) {
+    clearDomain(touchedFDs[i]);
+  }
+  touchedFDs = state.touchedFDs;
+  for (size_t i = 0; i < touchedFDs.size(); i++) {
+    touchedFDs[i]->restoreState(*state.domains[i]);
+    updateRate(touchedFDs[i]);
   }
-  assert(0);
 }
 
 double DomainGroup::getFaultRate() {
-  if (FDList.size() == 0)
-    return 0;
-  else {
-    double rate = 0;
-    for (auto it = FDList.begin(); it != FDList.end(); ++it) {
-      rate += (*it)->getFaultRate();
-    }
-    return rate;
+  return rateTree.total();
+}
+
+void DomainGroup::sumFaultStats(ErrorType type, int year, double *result) {
+  for (int i = 0; i < ERRORENUM; i++) result[i] = 0.;
+  for (auto it = FDList.begin(); it != FDList.end(); it++) {
+    float *tmp = (*it)->getFaultStats(type, year);
+    for (int i = 0; i < ERRORENUM; i++) result[i] += tmp[i];
   }
 }
 
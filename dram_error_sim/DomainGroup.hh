@@ -47,11 +47,25 @@ POSSIBILITY OF SUCH DAMAGE.
 #define __DOMAIN_GROUP_HH__
 
 #include <list>
+#include <memory>
+#include <vector>
 
 #include "FaultDomain.hh"
+#include "RateTree.hh"
 #include "common.hh"
 
 
+extern char ErrorENUMNAME[][16];
+
+/** @class DomainGroupState
+ * \brief Per-run state of the domains picked so far (see
+ * DomainGroup::saveState)
+ */
+struct DomainGroupState {
+  std::vector<FaultDomain *> touchedFDs;
+  std::vector<std::unique_ptr<FaultDomainState>> domains;
+};
+
 /**
  * @brief DomainGroup class
  * @details This class defines the target DRAM configuration using parameters
@@ -62,7 +76,9 @@ POSSIBILITY OF SUCH DAMAGE.
  */
 class DomainGroup {  // Corresponds to a cluster
  public:
-  DomainGroup() {}
+  //! every domain of the group shares the geometry selected by
+  //! setup_configs() at construction time
+  DomainGroup() : geometry(DramGeometry::getDefault()) {}
   ~DomainGroup() {
     for (auto& domain : FDList) {
       delete domain;
@@ -75,7 +91,13 @@ class DomainGroup {  // Corresponds to a cluster
     }
   }
 
+  const DramGeometry *getGeometry() const { return geometry.get(); }
   double getFaultRate();  //!< overall fault rate of domain group
+  //! unbiased overall fault rate (differs from getFaultRate() only under
+  //! importance sampling, where domains are picked by their biased rates)
+  double getNominalFaultRate() {
+    return biasedRates ? nominalTree.total() : rateTree.total();
+  }
   void setSingleChipFault() {
     for (auto it = FDList.begin(); it != FDList.end(); ++it) {
       (*it)->setSingleChipFault();
@@ -84,18 +106,21 @@ class DomainGroup {  // Corresponds to a cluster
   void resetInherentFault(Fault *fault, ECC *ecc) {
     for (auto it = FDList.begin(); it != FDList.end(); ++it) {
       (*it)->resetInherentFault(fault, ecc);
+      updateRate(*it);
     }
   }  //!< reset of inherent fault rate (at the beginning of iterations)
   void setInherentFault(Fault *fault, ECC *ecc, bool first) {
+    inherentFault = fault;
+    inherentECC = ecc;
     for (auto it = FDList.begin(); it != FDList.end(); ++it) {
       (*it)->setInherentFault(fault, ecc, first);
+      updateRate(*it);
     }
   }  //!< set inherent fault rate
-  void updateInherentFault(ECC *ecc) {
-    for (auto it = FDList.begin(); it != FDList.end(); it++) {
-      (*it)->updateInherentFault(ecc);
-    }
-  }  //!< update inherent fault rate due to operational fault overlap
+  void updateInherentFault(FaultDomain *fd, ECC *ecc) {
+    fd->updateInherentFault(ecc);
+    updateRate(fd);
+  }  //!< update inherent fault rate of fd due to operational fault overlap
   bool getBadCount(ECC *ecc) {
     for (auto it = FDList.begin(); it != FDList.end(); it++) {
       if ((*it)->getBadCount(ecc)) return true;
@@ -104,25 +129,31 @@ class DomainGroup {  // Corresponds to a cluster
   }  //!< old functionality
 
   void setInitialRetiredBlkCount(ECC *ecc, double rate) {
-    for (auto it = FDList.begin(); it != FDList.end(); ++it) {
-      (*it)->setInitialRetiredBlkCount(ecc, rate);
-    }
+    initialRetireECC = ecc;
+    initialRetireRate = rate;
   }  //!< count number of blocks that needs to be retired even at the initial
-     //! state
+     //! state (drawn for each domain when it is first picked in a run)
 
-  FaultDomain *pickRandomFD();  //!< pick randomly one of FaultDomains
+  //! pick randomly one of FaultDomains, expiring its transient faults
+  //! scrubbed by time "hr"
+  FaultDomain *pickRandomFD(double hr);
 
   void scrub() {
     for (auto it = FDList.begin(); it != FDList.end(); ++it) {
       (*it)->scrub();
     }
   }  //!< scrubbing wrapper
-  void clear() {
-    for (auto it = FDList.begin(); it != FDList.end(); ++it) {
-      (*it)->clear();
-    }
-  }  //!< clearing wrapper
+  void clear();  //!< clearing wrapper (end of a run)
+  //! copy the state of the domains picked during the current run
+  void saveState(DomainGroupState *state) const;
+  //! return to a state saved by saveState() (domains picked since then are
+  //! cleared)
+  void restoreState(const DomainGroupState &state);
   FaultDomain *getFD() { return FDList.front(); }
+  //! domain "idx" (FaultDomain::groupIdx), prepared for an arrival at "hr"
+  //! like pickRandomFD()
+  FaultDomain *getFD(int idx, double hr);
+  int getFDCount() { return FDVec.size(); }
 
   void printFaultRate() {
     for (auto it = FDList.begin(); it != FDList.end(); it++) {
@@ -130,6 +161,12 @@ class DomainGroup {  // Corresponds to a cluster
     }
   }
 
+  void setScrubber(Scrubber *scrubber) {
+    for (auto it = FDList.begin(); it != FDList.end(); it++) {
+      (*it)->setScrubber(scrubber);
+    }
+  }
+
   void setTester(class TesterSystem *tester, ECC *ecc) {
     _tester = tester;
     for (auto it = FDList.begin(); it != FDList.end(); it++) {
@@ -139,9 +176,35 @@ class DomainGroup {  // Corresponds to a cluster
 
   void printFaultStats(FILE *fd, long DUECntYear, long SDCCntYear, int year);
   void printFaultStatsAll(FILE *fd, long* DUECntYears, long* SDCCntYears, int MAXYEAR);
+  //! attribution of DUE/SDC to fault types in "year", summed over domains
+  void sumFaultStats(ErrorType type, int year, double *result);
+
+ protected:
+  void initRateTree();  //!< index domains and build the rate tree
+  void clearDomain(FaultDomain *fd);  //!< return a picked domain to idle
+  //! refresh the rate of a domain after its inherent rate changed
+  void updateRate(FaultDomain *fd) {
+    if (biasedRates) {
+      rateTree.set(fd->groupIdx, fd->getBiasedFaultRate());
+      nominalTree.set(fd->groupIdx, fd->getFaultRate());
+    } else {
+      rateTree.set(fd->groupIdx, fd->getFaultRate());
+    }
+  }
 
  protected:
+  std::shared_ptr<const DramGeometry> geometry;  //<! DRAM type of the group
   class TesterSystem *_tester;  //<! tester system class
+  std::vector<FaultDomain *> FDVec;  //<! FDList indexed by FaultDomain::groupIdx
+  RateTree rateTree;  //<! per-domain fault rates for O(log N) selection
+  RateTree nominalTree;  //<! unbiased rates (importance sampling only)
+  bool biasedRates = false;
+  //! domains picked during the current run; only these have state to clear
+  std::vector<FaultDomain *> touchedFDs;
+  Fault *inherentFault = NULL;  //<! inherent fault restored by clear()
+  ECC *inherentECC = NULL;
+  ECC *initialRetireECC = NULL;  //<! see setInitialRetiredBlkCount()
+  double initialRetireRate = .0;
 
  protected:
   std::list<FaultDomain *>
@@ -156,34 +219,38 @@ class DomainGroupDDR : public DomainGroup {
   DomainGroupDDR(int domainsPerGroup, int ranksPerDomain, int devicesPerRank,
                  int pinsPerDevice, int blkHeight) {
     for (int i = 0; i < domainsPerGroup; i++) {
-      FDList.push_back(new FaultDomainDDR(ranksPerDomain, devicesPerRank,
+      FDList.push_back(new FaultDomainDDR(geometry.get(), ranksPerDomain, devicesPerRank,
                                           pinsPerDevice, blkHeight));
     }
+    initRateTree();
   }
 
   
   DomainGroupDDR(int domainsPerGroup, int ranksPerDomain, int devicesPerRank,
                  int pinsPerDevice, int blkHeight, MSGConfig message_config) {
     for (int i = 0; i < domainsPerGroup; i++) {
-      FDList.push_back(new FaultDomainDDR(ranksPerDomain, devicesPerRank,
+      FDList.push_back(new FaultDomainDDR(geometry.get(), ranksPerDomain, devicesPerRank,
                                           pinsPerDevice, blkHeight, message_config));
     }
+    initRateTree();
   }
 
   DomainGroupDDR(int domainsPerGroup, int ranksPerDomain, int devicesPerRank,
                  int pinsPerDevice, int blkHeight, MSGConfig message_config, bool HBM) {
     for (int i = 0; i < domainsPerGroup; i++) {
-      FDList.push_back(new FaultDomainDDR(ranksPerDomain, devicesPerRank,
+      FDList.push_back(new FaultDomainDDR(geometry.get(), ranksPerDomain, devicesPerRank,
                                           pinsPerDevice, blkHeight, message_config, HBM));
     }
+    initRateTree();
   }
 
   DomainGroupDDR(int domainsPerGroup, int ranksPerDomain, int devicesPerRank,
                  int pinsPerDevice, int blkHeight, MSGConfig message_config, bool HBM, bool detailed) {
     for (int i = 0; i < domainsPerGroup; i++) {
-      FDList.push_back(new FaultDomainDDR(ranksPerDomain, devicesPerRank,
+      FDList.push_back(new FaultDomainDDR(geometry.get(), ranksPerDomain, devicesPerRank,
                                           pinsPerDevice, blkHeight, message_config, HBM, detailed));
     }
+    initRateTree();
   }
 
   void setHBM(bool HBM) {
@@ -42,11 +42,14 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "DomainGroup.hh"
 #include "ECC.hh"
 #include "FaultDomain.hh"
+#include "Profile.hh"
 #include "codec.hh"
 #include "hsiao.hh"
 #include "rs.hh"
 
-extern std::default_random_engine randomGenerator;
+extern std::default_random_engine decoderGenerator;
+
+bool ECC::verbose = true;
 
 //------------------------------------------------------------------------------
 ErrorType worse2ErrorType(ErrorType a, ErrorType b) {
@@ -67,9 +70,13 @@ ErrorType ECC::decode(FaultDomain *fd, CacheLine &errorBlk) {
   clear();
 
   // do decoding
-  result = decodeInternal(fd, errorBlk);
+  {
+    PROFILE_SCOPE(PROF_DECODE);
+    result = decodeInternal(fd, errorBlk);
+  }
 
   if (doPostprocess) {
+    PROFILE_SCOPE(PROF_POSTPROCESS);
     result = postprocess(fd, result);
   }
   return result;
@@ -126,9 +133,9 @@ unsigned long long ECC::getInitialRetiredBlkCount(FaultDomain *fd,
     int blkSize = fd->getChannelWidth() * fd->getBeatHeight();
     double goodBlkProb = pow(1 - cellFaultRate, blkSize);
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChannelWidth() / blkSize;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChannelWidth() / blkSize;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -143,9 +150,9 @@ unsigned long long ECC::getInitialRetiredBlkCount(FaultDomain *fd,
     int blkSize = fd->getChannelWidth() * fd->getBeatHeight();
     double goodBlkProb = pow(1 - cellFaultRate, blkSize);
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChannelWidth() / blkSize;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChannelWidth() / blkSize;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -104,6 +104,10 @@ class ECC {
         maxRetiredBlkCount(_maxRetiredBlkCount) {}
   virtual ~ECC() {}
 
+  //! print the blocks of miscorrections found while decoding (DUO); off
+  //! when the outcomes go to a structured event log (see EventLog.hh)
+  static bool verbose;
+
   //! The decoding function defined in a general way.
   /*!
           \param fd fault domain pointer
@@ -151,6 +155,11 @@ class ECC {
 
   //! Reset (remove all elements of) the corrected position set
   void clear() { correctedPosSet.clear(); }
+  //! Corrected position set of the current run (e.g., to restart a run)
+  const std::set<int> &getCorrectedPosSet() { return correctedPosSet; }
+  void setCorrectedPosSet(const std::set<int> &posSet) {
+    correctedPosSet = posSet;
+  }
 
   //! ECC configuration
   /*! \param maxDeviceRetirement Retirement capacity in terms of number of
@@ -191,6 +200,9 @@ class ECC {
     }
     printf("\n");
   };
+  //! brute-force histogram bins, for merging the counts of worker processes
+  int *getHistogram() { return BF_Stat; }
+  int getHistogramSize() { return sizeof(BF_Stat) / sizeof(int); }
 
  protected:
   //! List of configuration that will be required for graceful downgrade
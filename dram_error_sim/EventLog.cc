@@ -0,0 +1,242 @@
+/*
+Copyright 2023, The University of Texas at Austin
+All rights reserved.
+
+THIS FILE IS PART OF THE DRAM FAULT ERROR SIMULATION FRAMEWORK
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * @file: EventLog.cc
+ * @brief Binary log of the DUE/SDC/retirement events of system-level runs
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <new>
+
+#include "EventLog.hh"
+
+static const char EVENT_LOG_MAGIC[8] = {'E', 'V', 'T', 'L', 'O', 'G', '0', '1'};
+
+//------------------------------------------------------------------------------
+size_t EventRing::pop(EventRecord *out, size_t max)
+{
+  uint64_t t = tail.load(std::memory_order_relaxed);
+  uint64_t count = std::min<uint64_t>(
+      head.load(std::memory_order_acquire) - t, max);
+  for (uint64_t i = 0; i < count; i++)
+    out[i] = slots[(t + i) & (CAPACITY - 1)];
+  tail.store(t + count, std::memory_order_release);
+  return count;
+}
+
+//------------------------------------------------------------------------------
+bool EventLogWriter::open(const char *fileName, uint64_t _sample,
+                          uint64_t _maxRecords)
+{
+  assert(_sample >= 1);
+  fd = fopen(fileName, "wb");
+  if (fd == NULL) return false;
+  setvbuf(fd, NULL, _IOFBF, 1 << 20);
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, EVENT_LOG_MAGIC, sizeof(header.magic));
+  header.recordSize = sizeof(EventRecord);
+  // rewritten by close()
+  fwrite(&header, sizeof(header), 1, fd);
+  sample = _sample;
+  maxRecords = _maxRecords;
+  // new only guarantees the alignment of max_align_t before C++17, and the
+  // cursors and slots of the ring sit on their own cache lines
+  void *mem;
+  if (posix_memalign(&mem, alignof(EventRing), sizeof(EventRing)) != 0)
+  {
+    fclose(fd);
+    fd = NULL;
+    return false;
+  }
+  ring = new (mem) EventRing();
+  closing = false;
+  writer = std::thread(&EventLogWriter::drain, this);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void EventLogWriter::append(const EventRecord &record)
+{
+  bool keep = wants();
+  header.eventCount++;
+  if (!keep) return;
+  header.recordCount++;
+  // lossless: wait for the writer rather than drop the event
+  while (!ring->push(record))
+  {
+    stalls++;
+    std::this_thread::yield();
+  }
+}
+
+//------------------------------------------------------------------------------
+int16_t EventLogWriter::getTypeID(const std::string &name)
+{
+  auto it = typeIDs.find(name);
+  if (it != typeIDs.end()) return it->second;
+  assert(typeNames.size() < INT16_MAX);
+  int16_t id = typeNames.size();
+  typeIDs[name] = id;
+  typeNames.push_back(name);
+  return id;
+}
+
+//------------------------------------------------------------------------------
+// background thread: copy batches out of the ring and write them
+void EventLogWriter::drain()
+{
+  const size_t BATCH = 1024;
+  EventRecord batch[BATCH];
+  while (true)
+  {
+    // read the flag first so that nothing pushed before it is missed
+    bool done = closing.load(std::memory_order_acquire);
+    size_t count = ring->pop(batch, BATCH);
+    if (count > 0)
+      fwrite(batch, sizeof(EventRecord), count, fd);
+    else if (done)
+      break;
+    else
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+}
+
+//------------------------------------------------------------------------------
+void EventLogWriter::close()
+{
+  if (fd == NULL) return;
+  closing.store(true, std::memory_order_release);
+  writer.join();
+  ring->~EventRing();
+  free(ring);
+  ring = NULL;
+
+  header.namesOffset = ftell(fd);
+  header.nameCount = typeNames.size();
+  for (size_t i = 0; i < typeNames.size(); i++)
+  {
+    uint16_t length = typeNames[i].size();
+    fwrite(&length, sizeof(length), 1, fd);
+    fwrite(typeNames[i].data(), 1, length, fd);
+  }
+  fseek(fd, 0, SEEK_SET);
+  fwrite(&header, sizeof(header), 1, fd);
+  fclose(fd);
+  fd = NULL;
+  if (stalls > 0)
+    printf("Event log: the simulation waited %lu times for the writer\n",
+           (unsigned long)stalls);
+}
+
+//------------------------------------------------------------------------------
+bool eventLogToCsv(const char *fileName, FILE *out)
+{
+  FILE *fd = fopen(fileName, "rb");
+  if (fd == NULL) return false;
+  EventLogHeader header;
+  if ((fread(&header, sizeof(header), 1, fd) != 1) ||
+      (memcmp(header.magic, EVENT_LOG_MAGIC, sizeof(EVENT_LOG_MAGIC)) != 0) ||
+      (header.recordSize != sizeof(EventRecord)))
+  {
+    fclose(fd);
+    return false;
+  }
+
+  std::vector<std::string> names(header.nameCount);
+  fseek(fd, header.namesOffset, SEEK_SET);
+  for (uint32_t i = 0; i < header.nameCount; i++)
+  {
+    uint16_t length = 0;
+    if (fread(&length, sizeof(length), 1, fd) != 1) break;
+    names[i].resize(length);
+    if (length > 0 && fread(&names[i][0], 1, length, fd) != length) break;
+  }
+
+  static const char *outcomeName[] = {"RETIRE", "DUE", "SDC"};
+  fprintf(out, "trial,hours,outcome,weight,domain,faults,combo");
+  for (int f = 0; f < EVENT_LOG_FAULTS; f++)
+    fprintf(out, ",type%d,chip%d,pin%d,dq%d,transient%d", f, f, f, f, f);
+  fprintf(out, "\n");
+
+  fseek(fd, sizeof(header), SEEK_SET);
+  EventRecord record;
+  for (uint64_t r = 0; r < header.recordCount; r++)
+  {
+    if (fread(&record, sizeof(record), 1, fd) != 1) break;
+    int listed = std::min<int>(record.faultCount, EVENT_LOG_FAULTS);
+    // combination of the listed fault types, in a stable order
+    std::vector<std::string> combo;
+    for (int f = 0; f < listed; f++)
+      combo.push_back(names.at(record.faults[f].type));
+    std::sort(combo.begin(), combo.end());
+    std::string comboName;
+    for (size_t f = 0; f < combo.size(); f++)
+      comboName += (f ? "+" : "") + combo[f];
+    if (record.faultCount > listed) comboName += "+...";
+
+    fprintf(out, "%lu,%lf,%s,%g,%u,%u,%s", (unsigned long)record.trial,
+            record.hr, outcomeName[record.outcome], record.weight,
+            record.domain, record.faultCount, comboName.c_str());
+    for (int f = 0; f < EVENT_LOG_FAULTS; f++)
+    {
+      if (f < listed)
+      {
+        const EventFault &fault = record.faults[f];
+        fprintf(out, ",%s,%d,%d,%u,%u", names.at(fault.type).c_str(),
+                fault.chipID, fault.pinID, fault.numDQ, fault.transient);
+      }
+      else
+      {
+        fprintf(out, ",,,,,");
+      }
+    }
+    fprintf(out, "\n");
+  }
+  fclose(fd);
+  if (header.eventCount > header.recordCount)
+    fprintf(stderr, "%lu of %lu events were sampled out or over the cap\n",
+            (unsigned long)(header.eventCount - header.recordCount),
+            (unsigned long)header.eventCount);
+  return true;
+}
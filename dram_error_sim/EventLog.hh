@@ -0,0 +1,172 @@
+/*
+Copyright 2023, The University of Texas at Austin
+All rights reserved.
+
+THIS FILE IS PART OF THE DRAM FAULT ERROR SIMULATION FRAMEWORK
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * @file: EventLog.hh
+ * @brief Binary log of the DUE/SDC/retirement events of system-level runs
+ * @details In place of the "<hr> DUE-<faults>" lines on stdout, each event
+ * becomes a fixed-size EventRecord (run, time, outcome, domain and up to
+ * EVENT_LOG_FAULTS operational faults with their type, chip and pin). The
+ * simulation thread only copies records into a single-producer,
+ * single-consumer ring; a background thread drains the ring to the file.
+ * The fault type names are stored once, in a table after the records.
+ * "faulterrorsim log2csv" converts a log to CSV.
+ */
+
+#ifndef __EVENT_LOG_HH__
+#define __EVENT_LOG_HH__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#define EVENT_LOG_FAULTS 4
+
+/** @class EventFault
+ * \brief One operational fault of the failing domain
+ */
+struct EventFault {
+  int16_t type;       //!< index into the name table of the log
+  int16_t chipID;
+  int16_t pinID;      //!< -1 unless the fault covers a single DQ
+  uint8_t numDQ;
+  uint8_t transient;
+};
+
+/** @class EventRecord
+ * \brief One DUE, SDC or retirement
+ */
+struct EventRecord {
+  uint64_t trial;      //!< run index
+  double hr;           //!< time of the event
+  double weight;       //!< likelihood ratio of the run (1 unless weighted)
+  uint32_t domain;     //!< FaultDomain::groupIdx
+  uint8_t outcome;     //!< 0: retirement, 1: DUE, 2: SDC
+  uint8_t faultCount;  //!< operational faults, of which the first
+                       //!< EVENT_LOG_FAULTS are listed
+  uint16_t reserved;
+  EventFault faults[EVENT_LOG_FAULTS];
+};
+static_assert(sizeof(EventRecord) == 64, "EventRecord layout changed");
+
+/** @class EventLogHeader
+ * \brief Header of a log file, followed by recordCount EventRecords and
+ * nameCount fault type names (uint16_t length, then the characters)
+ */
+struct EventLogHeader {
+  char magic[8];         //!< "EVTLOG01"
+  uint32_t recordSize;   //!< sizeof(EventRecord)
+  uint32_t nameCount;
+  uint64_t recordCount;  //!< records written
+  uint64_t eventCount;   //!< events before sampling and the cap
+  uint64_t namesOffset;  //!< file offset of the name table
+};
+
+/** @class EventRing
+ * \brief Bounded single-producer, single-consumer queue of EventRecords
+ */
+class EventRing {
+ public:
+  static const uint64_t CAPACITY = 1 << 14;  //!< records (power of two)
+
+  //! producer: false if the ring is full
+  bool push(const EventRecord &record) {
+    uint64_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) == CAPACITY) return false;
+    slots[h & (CAPACITY - 1)] = record;
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+  //! consumer: move up to "max" records to "out", returns their count
+  size_t pop(EventRecord *out, size_t max);
+
+ protected:
+  alignas(64) std::atomic<uint64_t> head{0};  //!< next slot to fill
+  alignas(64) std::atomic<uint64_t> tail{0};  //!< next slot to drain
+  alignas(64) EventRecord slots[CAPACITY];
+};
+
+/** @class EventLogWriter
+ * \brief Writes the events of a simulation from a background thread
+ */
+class EventLogWriter {
+ public:
+  EventLogWriter() {}
+  ~EventLogWriter() { close(); }
+
+  //! keep every "sample"-th event, and at most "maxRecords" of them
+  //! (0: no cap); neither draws random numbers
+  bool open(const char *fileName, uint64_t sample, uint64_t maxRecords);
+  //! whether the next append() will keep its event; lets the caller skip
+  //! filling records that would be dropped
+  bool wants() const {
+    return ((maxRecords == 0) || (header.recordCount < maxRecords)) &&
+           (header.eventCount % sample == 0);
+  }
+  //! offer an event (the record of a dropped one may be left unfilled)
+  void append(const EventRecord &record);
+  //! index of a fault type name in the name table
+  int16_t getTypeID(const std::string &name);
+  //! drain the ring, write the name table and the final header
+  void close();
+
+ protected:
+  void drain();
+
+  FILE *fd = NULL;
+  EventLogHeader header;
+  uint64_t sample = 1;
+  uint64_t maxRecords = 0;
+  uint64_t stalls = 0;  //!< appends that waited for a full ring
+  std::unordered_map<std::string, int16_t> typeIDs;
+  std::vector<std::string> typeNames;
+  EventRing *ring = NULL;
+  std::thread writer;
+  std::atomic<bool> closing{false};
+};
+
+//! write the records of log "fileName" to "out" as CSV; false if the file
+//! is not an event log
+bool eventLogToCsv(const char *fileName, FILE *out);
+
+#endif /* __EVENT_LOG_HH__ */
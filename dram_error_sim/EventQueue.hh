@@ -0,0 +1,106 @@
+/*
+Copyright 2023, The University of Texas at Austin
+All rights reserved.
+
+THIS FILE IS PART OF THE DRAM FAULT ERROR SIMULATION FRAMEWORK
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * @file: EventQueue.hh
+ * @brief Future event list of the system-level (discrete-event) simulation
+ */
+
+#ifndef __EVENT_QUEUE_HH__
+#define __EVENT_QUEUE_HH__
+
+#include <algorithm>
+#include <vector>
+
+class FaultDomain;
+
+/**
+ * Event types, in the order they are processed when they share a time stamp
+ */
+typedef enum {
+  EV_RETIRE = 0,     //!< retirement budget of a domain exhausted
+  EV_SCRUB,          //!< scrub deadline of a domain's transient faults
+  EV_RATE_CHANGE,    //!< fault rates change (e.g., bathtub/aging curve)
+  EV_FAULT_ARRIVAL,  //!< next fault arrival in the domain group
+  EV_HORIZON,        //!< end of the simulated lifetime
+  NUM_EVENT_TYPES
+} SimEventType;
+
+/** @class SimEvent
+ * \brief A typed future event
+ */
+struct SimEvent {
+  double time;      //!< hours from the beginning of the run
+  SimEventType type;
+  FaultDomain *fd;  //!< domain that scheduled the event (if any)
+  long seq;         //!< sequence number, used to supersede fault arrivals
+  double value;     //!< event-specific value (e.g., new rate multiplier)
+
+  bool operator>(const SimEvent &other) const {
+    return (time > other.time) || ((time == other.time) && (type > other.type));
+  }
+};
+
+/** @class EventQueue
+ * \brief Min-heap of future events ordered by time (then by type)
+ */
+class EventQueue {
+ public:
+  EventQueue() {}
+
+  void push(const SimEvent &event) {
+    heap.push_back(event);
+    std::push_heap(heap.begin(), heap.end(), std::greater<SimEvent>());
+  }
+  SimEvent pop() {
+    std::pop_heap(heap.begin(), heap.end(), std::greater<SimEvent>());
+    SimEvent event = heap.back();
+    heap.pop_back();
+    return event;
+  }
+  const SimEvent &top() const { return heap.front(); }
+  bool empty() const { return heap.empty(); }
+  size_t size() const { return heap.size(); }
+  void clear() { heap.clear(); }
+
+ protected:
+  std::vector<SimEvent> heap;
+};
+
+#endif /* __EVENT_QUEUE_HH__ */
@@ -0,0 +1,181 @@
+/*
+Copyright 2023, The University of Texas at Austin
+All rights reserved.
+
+THIS FILE IS PART OF THE DRAM FAULT ERROR SIMULATION FRAMEWORK
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * @file: FailureHistogram.cc
+ * @brief Histogram of the first-failure times of the runs
+ */
+
+#include <assert.h>
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+
+#include "FailureHistogram.hh"
+
+//------------------------------------------------------------------------------
+void FailureHistogram::resize(double horizonHr)
+{
+  assert(binHr > 0);
+  size_t binCnt = (size_t)ceil(horizonHr / binHr);
+  for (int k = 0; k < NUM_KINDS; k++)
+  {
+    if (bins[k].size() < binCnt)
+      bins[k].resize(binCnt, 0.);
+  }
+}
+
+//------------------------------------------------------------------------------
+void FailureHistogram::clear()
+{
+  trials = 0;
+  for (int k = 0; k < NUM_KINDS; k++)
+    std::fill(bins[k].begin(), bins[k].end(), 0.);
+}
+
+//------------------------------------------------------------------------------
+void FailureHistogram::addGeometric(int kind, double hr, double weight,
+                                    double period, double q)
+{
+  // P(J = j) = (1 - q) q^j, until the remaining mass is negligible
+  double mass = weight * (1. - q);
+  double end = bins[kind].size() * binHr;
+  for (double t = hr; (t < end) && (mass > weight * 1e-15); t += period)
+  {
+    add(kind, t, mass);
+    mass *= q;
+  }
+}
+
+//------------------------------------------------------------------------------
+void FailureHistogram::addExponential(int kind, double hr, double weight,
+                                      double rate)
+{
+  if (hr < 0) return;
+  // mass of each bin: P(lo <= hr + T < hi) = e^-rate(lo-hr) - e^-rate(hi-hr)
+  double survive = 1.;
+  for (size_t bin = (size_t)(hr / binHr); bin < bins[kind].size(); bin++)
+  {
+    double next = exp(-rate * ((bin + 1) * binHr - hr));
+    bins[kind][bin] += weight * (survive - next);
+    survive = next;
+    if (survive < 1e-15) break;
+  }
+}
+
+//------------------------------------------------------------------------------
+double FailureHistogram::cumulative(int kind, double hr) const
+{
+  if (trials == 0) return 0.;
+  size_t binCnt = std::min(bins[kind].size(), (size_t)floor(hr / binHr));
+  double sum = 0.;
+  for (size_t bin = 0; bin < binCnt; bin++)
+    sum += bins[kind][bin];
+  return sum / trials;
+}
+
+//------------------------------------------------------------------------------
+Interval FailureHistogram::cumulativeInterval(int kind, double hr) const
+{
+  return wilsonInterval(cumulative(kind, hr) * trials, trials);
+}
+
+//------------------------------------------------------------------------------
+void FailureHistogram::merge(const FailureHistogram &other)
+{
+  assert(binHr == other.binHr);
+  trials += other.trials;
+  for (int k = 0; k < NUM_KINDS; k++)
+  {
+    if (bins[k].size() < other.bins[k].size())
+      bins[k].resize(other.bins[k].size(), 0.);
+    for (size_t bin = 0; bin < other.bins[k].size(); bin++)
+      bins[k][bin] += other.bins[k][bin];
+  }
+}
+
+//------------------------------------------------------------------------------
+bool FailureHistogram::save(const char *fileName) const
+{
+  FILE *fd = fopen(fileName, "w");
+  if (fd == NULL) return false;
+  size_t binCnt = bins[0].size();
+  fprintf(fd, "trials %ld\nbin_hours %.17g\nbins %zu\n", trials, binHr,
+          binCnt);
+  for (size_t bin = 0; bin < binCnt; bin++)
+  {
+    if ((bins[0][bin] == 0) && (bins[1][bin] == 0) && (bins[2][bin] == 0))
+      continue;
+    fprintf(fd, "%zu %.17g %.17g %.17g\n", bin, bins[0][bin], bins[1][bin],
+            bins[2][bin]);
+  }
+  fclose(fd);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool FailureHistogram::load(const char *fileName)
+{
+  FILE *fd = fopen(fileName, "r");
+  if (fd == NULL) return false;
+  long _trials;
+  double _binHr;
+  size_t binCnt;
+  if (fscanf(fd, "trials %ld bin_hours %lf bins %zu", &_trials, &_binHr,
+             &binCnt) != 3)
+  {
+    fclose(fd);
+    return false;
+  }
+  binHr = _binHr;
+  trials = _trials;
+  for (int k = 0; k < NUM_KINDS; k++)
+    bins[k].assign(binCnt, 0.);
+  size_t bin;
+  double retire, due, sdc;
+  while (fscanf(fd, "%zu %lf %lf %lf", &bin, &retire, &due, &sdc) == 4)
+  {
+    if (bin >= binCnt) continue;
+    bins[0][bin] = retire;
+    bins[1][bin] = due;
+    bins[2][bin] = sdc;
+  }
+  fclose(fd);
+  return true;
+}
@@ -0,0 +1,108 @@
+/*
+Copyright 2023, The University of Texas at Austin
+All rights reserved.
+
+THIS FILE IS PART OF THE DRAM FAULT ERROR SIMULATION FRAMEWORK
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * @file: FailureHistogram.hh
+ * @brief Histogram of the first-failure times of the runs
+ */
+
+#ifndef __FAILURE_HISTOGRAM_HH__
+#define __FAILURE_HISTOGRAM_HH__
+
+#include <stdio.h>
+#include <vector>
+
+#include "Stats.hh"
+
+/** @class FailureHistogram
+ * \brief Weighted counts of the runs ending in a Retire (kind 0), DUE (1) or
+ * SDC (2) per time bin
+ * @details The cumulative probability of any horizon (e.g. 3 months or 7
+ * years) is derived from one simulation at print time, to the resolution of
+ * a bin. Histograms of the same bin width are merged by adding them up, so
+ * shards (or threads) can be simulated separately and combined afterwards.
+ */
+class FailureHistogram {
+ public:
+  static const int NUM_KINDS = 3;
+
+  FailureHistogram(double _binHr = 1., double horizonHr = 0.) : binHr(_binHr) {
+    resize(horizonHr);
+  }
+
+  //! cover [0, horizonHr) hours
+  void resize(double horizonHr);
+  void clear();
+
+  //! a run ending in "kind" at "hr" hours with weight "weight"
+  void add(int kind, double hr, double weight = 1.) {
+    if (hr < 0) return;
+    size_t bin = (size_t)(hr / binHr);
+    if (bin < bins[kind].size()) bins[kind][bin] += weight;
+  }
+  //! "weight" spread over hr + J * period, J ~ Geometric(1 - q)
+  void addGeometric(int kind, double hr, double weight, double period,
+                    double q);
+  //! "weight" spread over hr + T, T ~ Exponential(rate)
+  void addExponential(int kind, double hr, double weight, double rate);
+  //! runs simulated so far (including those that did not fail)
+  void addTrials(long n) { trials += n; }
+  long getTrials() const { return trials; }
+  double getBinHr() const { return binHr; }
+
+  //! probability of a "kind" failure before "hr" hours (rounded down to a
+  //! bin boundary)
+  double cumulative(int kind, double hr) const;
+  //! Wilson interval of cumulative(); only meaningful for unweighted runs
+  Interval cumulativeInterval(int kind, double hr) const;
+
+  //! add the counts of another histogram of the same bin width
+  void merge(const FailureHistogram &other);
+
+  //! text format, nonzero bins only: "bin retire due sdc" per line
+  bool save(const char *fileName) const;
+  bool load(const char *fileName);
+
+ protected:
+  double binHr;  //!< width of a bin in hours
+  long trials = 0;
+  std::vector<double> bins[NUM_KINDS];
+};
+
+#endif /* __FAILURE_HISTOGRAM_HH__ */
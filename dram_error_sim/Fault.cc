@@ -50,9 +50,19 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "Config.hh"
 #include "Fault.hh"
 #include "common.hh"
+#include "util.hh"
 
 //----------------------------------------------------------
 std::default_random_engine randomGenerator;
+std::default_random_engine decoderGenerator;
+
+void seedRandom(uint64_t seed) {
+  // small seeds such as 1 and 2 must give different streams, so the
+  // engines are seeded from mixes of the whole seed
+  srand((unsigned)seed);
+  randomGenerator.seed((unsigned)splitmix64(seed));
+  decoderGenerator.seed((unsigned)splitmix64(splitmix64(seed)));
+}
 
 //----------------------------------------------------------
 Fault::~Fault(){
@@ -63,8 +73,9 @@ Fault::~Fault(){
 
 Fault::Fault(std::string _name)
     : name(_name),
+      typeIdx(getTypeIdx(_name)),
       fd(NULL),
-      mask(SBIT_MASK),
+      mask(0),  // inherent faults are not bound to a domain (or geometry)
       effective_mask(0),
       isInherent(true),
       isTransient(PERMANENT),
@@ -76,7 +87,44 @@ Fault::Fault(std::string _name)
       affectedBlkCount(0),
       numInherentFaults(0),
       numBanks_perBeat(1),
-      isMultipleBanks_perBeat(false) {}
+      isMultipleBanks_perBeat(false),
+      bank_list(NULL) {}
+
+// detailed faults are never modified after creation, so clones share them
+Fault::Fault(const Fault &other)
+    : overlapped(other.overlapped),
+      scrubDeadline(other.scrubDeadline),
+      fd(other.fd),
+      name(other.name),
+      typeIdx(other.typeIdx),
+      addr(other.addr),
+      mask(other.mask),
+      effective_mask(other.effective_mask),
+      isInherent(other.isInherent),
+      isTransient(other.isTransient),
+      numDQ(other.numDQ),
+      isSingleBeat(other.isSingleBeat),
+      isMultiColumn(other.isMultiColumn),
+      isMultiRow(other.isMultiRow),
+      isChannel(other.isChannel),
+      isMultipleBanks_perBeat(other.isMultipleBanks_perBeat),
+      numBanks_perBeat(other.numBanks_perBeat),
+      affectedBlkCount(other.affectedBlkCount),
+      beatStart(other.beatStart),
+      beatEnd(other.beatEnd),
+      beatCount(other.beatCount),
+      chipPos(other.chipPos),
+      cellFaultRate(other.cellFaultRate),
+      numInherentFaults(other.numInherentFaults),
+      bank_list(NULL),
+      numBank_errors(other.numBank_errors) {
+  detailed_faults = other.detailed_faults;
+  memcpy(pinPos, other.pinPos, sizeof(pinPos));
+  if (other.bank_list != NULL) {
+    bank_list = new int[numBanks_perBeat];
+    memcpy(bank_list, other.bank_list, sizeof(int) * numBanks_perBeat);
+  }
+}
 
 Fault::Fault(FaultDomain *_fd, std::string _name, ADDR _mask, bool _isInherent,
              bool _isTransient, int _numDQ, bool _isSingleBeat,
@@ -84,6 +132,7 @@ Fault::Fault(FaultDomain *_fd, std::string _name, ADDR _mask, bool _isInherent,
              unsigned long long _affectedBlkCount, int _banksperBeat)
     : fd(_fd),
       name(_name),
+      typeIdx(getTypeIdx(_name)),
       mask(_mask),
       effective_mask(0),
       isInherent(_isInherent),
@@ -105,14 +154,14 @@ Fault::Fault(FaultDomain *_fd, std::string _name, ADDR _mask, bool _isInherent,
   for (int i=0;i<_banksperBeat;i++){
     bank_list[i] = i;
   }
-  if(_mask == MBANK_MASK){
+  if(_mask == fd->getGeometry()->MBANK_MASK){
     if (_banksperBeat > 1){
-      numBank_errors = rand()%(_banksperBeat-1) + 2;
+      numBank_errors = timelineRand()%(_banksperBeat-1) + 2;
     }
     else{
       numBank_errors = 1; 
     }
-  }else if(_mask == MRANK_MASK){
+  }else if(_mask == fd->getGeometry()->MRANK_MASK){
     numBank_errors = _banksperBeat;
   }else{
     numBank_errors = 1;
@@ -120,7 +169,7 @@ Fault::Fault(FaultDomain *_fd, std::string _name, ADDR _mask, bool _isInherent,
 
   if (isSingleBeat) {
     // start = end, count = 1
-    beatStart = rand() % fd->getBeatHeight();
+    beatStart = timelineRand() % fd->getBeatHeight();
     beatEnd = beatStart;
     beatCount = 1;
   } else {
@@ -129,15 +178,15 @@ Fault::Fault(FaultDomain *_fd, std::string _name, ADDR _mask, bool _isInherent,
     beatCount = fd->getBeatHeight();
   }
   update_pinpos();
-  addr = RAND_MAX * ((ADDR)rand()) + rand();  // 64-bit
+  addr = RAND_MAX * ((ADDR)timelineRand()) + timelineRand();  // 64-bit
   cellFaultRate = .0;
 }
 
 
 void Fault::update_pinpos(bool group,int group_size){
-  chipPos = rand() % fd->getChannelWidth() / fd->getChipWidth();
+  chipPos = timelineRand() % fd->getChannelWidth() / fd->getChipWidth();
   if (numDQ ==2){
-    int pin = rand() % (fd->getChipWidth()-1) + chipPos * fd->getChipWidth();    
+    int pin = timelineRand() % (fd->getChipWidth()-1) + chipPos * fd->getChipWidth();    
     if (! group){
       pinPos[0] = pin;
       pinPos[1] = pin+1;
@@ -171,7 +220,7 @@ void Fault::update_pinpos(bool group,int group_size){
       bool isConflict;
       int pin;
       do {
-        pin = rand() % fd->getChipWidth() + chipPos * fd->getChipWidth();
+        pin = timelineRand() % fd->getChipWidth() + chipPos * fd->getChipWidth();
         isConflict = false;
         for (int j = 0; j < i; j++) {
           if (pinPos[j] == pin) {
@@ -184,6 +233,39 @@ void Fault::update_pinpos(bool group,int group_size){
   }
 }
 
+void Fault::moveToChip(int chip) {
+  int shift = (chip - chipPos) * fd->getChipWidth();
+  // the pins update_pinpos() filled in
+  int pinCount = (numDQ == 2) ? 2 : std::max(numDQ, fd->getChipWidth());
+  for (int i = 0; i < pinCount; i++) {
+    pinPos[i] += shift;
+  }
+  chipPos = chip;
+}
+
+int Fault::getTypeIdx(const std::string &name) {
+  if (name == "Sbit" || name == "Spin") return SBITENUM;
+  if (name == "Sword") return SWORDENUM;
+  if (name == "Scol") return SCOLENUM;
+  if (name == "Srow") return SROWENUM;
+  if (name == "Lwordline") return LWLNUM;
+  if (name == "Sbank") return SBANKENUM;
+  if (name == "Mbank") return MBANKENUM;
+  if (name == "Mrank") return MRANKENUM;
+  if (name == "Channel") return CHANNELENUM;
+  if (name == "BLSA") return BLSA;
+  if (name == "Bank_pattern") return BANKPATTERN;
+  if (name == "CDEC") return CDEC;
+  if (name == "CSL") return CSL;
+  if (name == "Multi_module") return MMODULE;
+  if (name == "RDEC") return RDEC;
+  if (name == "SWD") return SWD;
+  if (name == "Dist_bit") return DISTBIT;
+  if (name == "CMUX") return CMUX;
+  if (name == "MWL") return MWL;
+  return ERRORENUM;
+}
+
 Fault *Fault::genRandomFault(std::string type, FaultDomain *fd) {
   if (type == "b") {
     return new SingleBitFault(fd, false);
@@ -604,11 +686,11 @@ Fault *Fault::genRandomFault(std::string type, FaultDomain *fd) {
     //return new two_row_overlapFault(fd, false);
   }
 
-  double r = (double)rand()/RAND_MAX;
+  double r = (double)timelineRand()/RAND_MAX;
 
   if (type =="scol-t"){
     if (fd->HBM_setup){
-      int pins = (rand() % fd->getChannelWidth()-1) + 2;
+      int pins = (timelineRand() % fd->getChannelWidth()-1) + 2;
       if (r<0.8580) return new SingleColumnFault(fd, true,1);
       else return new SingleColumnFault(fd, true,pins);
     }else {
@@ -619,7 +701,7 @@ Fault *Fault::genRandomFault(std::string type, FaultDomain *fd) {
     }
   } else if (type =="scol-p"){
     if (fd->HBM_setup){
-      int pins = (rand() % fd->getChannelWidth()-1) + 2;
+      int pins = (timelineRand() % fd->getChannelWidth()-1) + 2;
       if (r<0.8580) return new SingleColumnFault(fd, false,1);
       else return new SingleColumnFault(fd, false,pins);
     }else {
@@ -630,7 +712,7 @@ Fault *Fault::genRandomFault(std::string type, FaultDomain *fd) {
     }
   } else if (type =="srow-t"){
     if (fd->HBM_setup){
-      int pins = (rand() % fd->getChannelWidth()-1) + 2;
+      int pins = (timelineRand() % fd->getChannelWidth()-1) + 2;
       if (r<0.3110) return new SingleRowFault(fd, true,1);
       else return new SingleRowFault(fd, true,pins);
     }else {
@@ -641,7 +723,7 @@ Fault *Fault::genRandomFault(std::string type, FaultDomain *fd) {
     }
   } else if (type =="srow-p"){
     if (fd->HBM_setup){ 
-      int pins = (rand() % fd->getChannelWidth()-1) + 2;
+      int pins = (timelineRand() % fd->getChannelWidth()-1) + 2;
       if (r<0.3110) return new SingleRowFault(fd, false,1);
       else return new SingleRowFault(fd, false,pins);
     } else {
@@ -652,7 +734,7 @@ Fault *Fault::genRandomFault(std::string type, FaultDomain *fd) {
     }
   } else if (type =="sbank-t"){
     if (fd->HBM_setup){
-      int pins = (rand() % fd->getChannelWidth()-1) + 2;
+      int pins = (timelineRand() % fd->getChannelWidth()-1) + 2;
       if (r<0.5550) return new SingleBankFault(fd, true,4);
       else return new SingleBankFault(fd, true,pins);
     }else {
@@ -663,7 +745,7 @@ Fault *Fault::genRandomFault(std::string type, FaultDomain *fd) {
     }
   } else if (type =="sbank-p"){
     if (fd->HBM_setup){
-      int pins = (rand() % fd->getChannelWidth()-1) + 2;
+      int pins = (timelineRand() % fd->getChannelWidth()-1) + 2;
       if (r<0.5550) return new SingleBankFault(fd, false,4);
       else return new SingleBankFault(fd, false,pins);
     } else {
@@ -674,7 +756,7 @@ Fault *Fault::genRandomFault(std::string type, FaultDomain *fd) {
     }
   } else if (type =="mbank-t"){
     if (fd->HBM_setup){
-      int pins = (rand() % fd->getChannelWidth()-1) + 2;
+      int pins = (timelineRand() % fd->getChannelWidth()-1) + 2;
       if (r<0.1750) return new MultiBankFault(fd, true,1);
       else return new MultiBankFault(fd, true,pins);
     }else {
@@ -685,7 +767,7 @@ Fault *Fault::genRandomFault(std::string type, FaultDomain *fd) {
     }
   } else if (type =="mbank-p"){
     if (fd->HBM_setup){
-      int pins = (rand() % fd->getChannelWidth()-1) + 2;
+      int pins = (timelineRand() % fd->getChannelWidth()-1) + 2;
       if (r<0.1750) return new MultiBankFault(fd, false,1);
       else return new MultiBankFault(fd, false,pins);
       }else {
@@ -696,7 +778,7 @@ Fault *Fault::genRandomFault(std::string type, FaultDomain *fd) {
     }
   } else if (type =="mrank-t"){
     if (fd->HBM_setup){
-      int pins = (rand() % fd->getChannelWidth()-1) + 2;
+      int pins = (timelineRand() % fd->getChannelWidth()-1) + 2;
       if (r<0.0750) return new MultiRankFault(fd, true,1);
       else return new MultiRankFault(fd, true,pins);
     }else {
@@ -707,7 +789,7 @@ Fault *Fault::genRandomFault(std::string type, FaultDomain *fd) {
     }
   } else if (type =="mrank-p"){
     if (fd->HBM_setup){
-      int pins = (rand() % fd->getChannelWidth()-1) + 2;
+      int pins = (timelineRand() % fd->getChannelWidth()-1) + 2;
       if (r<0.0750) return new MultiRankFault(fd, false,1);
       else return new MultiRankFault(fd, false,pins);
     }else {
@@ -51,6 +51,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <string>
 #include <memory>
 #include <cstring>
+#include <math.h>
 #include "Config.hh"
 #include "FaultDomain.hh"
 #include "common.hh"
@@ -58,15 +59,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "message.hh"
 
 extern int BANKSPERBEAT;
-extern unsigned long long SBANK_MASK_DEGRADE;
-extern int column_address_bits; 
-extern int row_address_bits;
 extern int module;
-extern char DRAMTYPE[16];
-extern int numofBanks;
-
-//------------------------------------------------------------------------------
-extern std::default_random_engine randomGenerator;
 
 /**@addtogroup Fault_Management
  * @{
@@ -85,13 +78,20 @@ class Fault {
         bool _isTransient, int _numDQ, bool _isSingleBeat, bool _isMultiRow,
         bool _isMultiColumn, bool _isChannel,
         unsigned long long _affectedBlkCount, int _banksperBeat);
+  Fault(const Fault &other);
   virtual ~Fault();
+  //! copy of this fault (of the same type); classes overriding the error
+  //! generation must override clone() as well
+  virtual Fault *clone() const { return new Fault(*this); }
   
 
  public:
   ADDR getAddr() { return addr; }
   ADDR getMask() { return mask; }
   std::string getName() { return name; }
+  int getTypeIdx() { return typeIdx; }
+  //! ErrorENUM of a fault type name (ERRORENUM if it has none)
+  static int getTypeIdx(const std::string &name);
   ADDR getEffectiveMask() {
     if (effective_mask == 0) {
       return mask;
@@ -120,6 +120,8 @@ class Fault {
     }
   }
   void update_pinpos(bool group = false,int group_size = 4);
+  //! move the fault to chip "chip", keeping its pins within the chip
+  void moveToChip(int chip);
   std::vector<std::shared_ptr<Fault>> detailed_faults;
 
   double getCellFaultRate() { return cellFaultRate; }
@@ -176,7 +178,7 @@ class Fault {
     }
     int beatCountperBank = beatCount/numBanks_perBeat;
     bool noError = true;
-    std::random_shuffle(bank_list, bank_list + numBanks_perBeat);
+    std::shuffle(bank_list, bank_list + numBanks_perBeat, randomGenerator);
     while (noError) {
       for (int idx =0; idx<numBank_errors; idx++){
         int bankidx = bank_list[idx];
@@ -227,9 +229,11 @@ class Fault {
   static Fault *genRandomFault(std::string type,
                                FaultDomain *fd);  //!< random fault generation
   bool overlapped = false;  //!< overlap with inherent faults
+  double scrubDeadline = INFINITY;  //!< time a transient fault is scrubbed
  public:
   FaultDomain *fd;
   std::string name;
+  int typeIdx;         //!< ErrorENUM of this fault type
   ADDR addr;           //!< address used for fault overlap checking
   ADDR mask;           //!< mask used for fault overlap checking
   ADDR effective_mask; //!< mask used for fault overlap checking
@@ -273,7 +277,7 @@ class Fault {
 class SingleBitFault : public Fault {
  public:
   SingleBitFault(FaultDomain *fd, bool _isTransient)
-      : Fault(fd, "Sbit", SBIT_MASK, OPERATIONAL, _isTransient, 1, SINGLE_BEAT,
+      : Fault(fd, "Sbit", fd->getGeometry()->SBIT_MASK, OPERATIONAL, _isTransient, 1, SINGLE_BEAT,
               SINGLE_ROW, SINGLE_COLUMN, NO_CHANNEL, 0, 1) {
               }
 };
@@ -284,7 +288,7 @@ class SingleBitFault : public Fault {
 class SingleWordFault : public Fault {
  public:
   SingleWordFault(FaultDomain *fd, bool _isTransient, int _numDQ)
-      : Fault(fd, "Sword", SWORD_MASK, OPERATIONAL, _isTransient, _numDQ,
+      : Fault(fd, "Sword", fd->getGeometry()->SWORD_MASK, OPERATIONAL, _isTransient, _numDQ,
               SINGLE_BEAT, SINGLE_ROW, SINGLE_COLUMN, NO_CHANNEL, 0, 1) {
     // assert(numDQ != 1);
   }
@@ -296,9 +300,9 @@ class SingleWordFault : public Fault {
 class SinglePinFault : public Fault {
  public:
   SinglePinFault(FaultDomain *fd, bool _isTransient)
-      : Fault(fd, "Spin", CHANNEL_MASK, OPERATIONAL, _isTransient, 1,
+      : Fault(fd, "Spin", fd->getGeometry()->CHANNEL_MASK, OPERATIONAL, _isTransient, 1,
               MULTI_BEAT, MULTI_ROW, MULTI_COLUMN, NO_CHANNEL,
-              ((MRANK_MASK ^ DEFAULT_MASK) + 1) / 8, BANKSPERBEAT) {}
+              (fd->getGeometry()->rankAddrMask() + 1) / 8, BANKSPERBEAT) {}
 };
 
 /**
@@ -307,9 +311,9 @@ class SinglePinFault : public Fault {
 class SingleChipFault : public Fault {
  public:
   SingleChipFault(FaultDomain *fd, bool _isTransient, int _numDQ)
-      : Fault(fd, "Schip", CHANNEL_MASK, OPERATIONAL, _isTransient, _numDQ,
+      : Fault(fd, "Schip", fd->getGeometry()->CHANNEL_MASK, OPERATIONAL, _isTransient, _numDQ,
               MULTI_BEAT, MULTI_ROW, MULTI_COLUMN, NO_CHANNEL,
-              ((MBANK_MASK ^ DEFAULT_MASK) + 1) / 8, BANKSPERBEAT) {}
+              ((fd->getGeometry()->MBANK_MASK ^ fd->getGeometry()->DEFAULT_MASK) + 1) / 8, BANKSPERBEAT) {}
 };
 
 /**
@@ -318,9 +322,10 @@ class SingleChipFault : public Fault {
 class ChannelFault : public Fault {
  public:
   ChannelFault(FaultDomain *fd, bool _isTransient)
-      : Fault(fd, "Channel", CHANNEL_MASK, OPERATIONAL, _isTransient,
+      : Fault(fd, "Channel", fd->getGeometry()->CHANNEL_MASK, OPERATIONAL, _isTransient,
               fd->getChipWidth(), MULTI_BEAT, MULTI_COLUMN, MULTI_ROW, CHANNEL,
-              ((MRANK_MASK ^ DEFAULT_MASK) + 1) / 8, BANKSPERBEAT) {}
+              (fd->getGeometry()->rankAddrMask() + 1) / 8, BANKSPERBEAT) {}
+  Fault *clone() const { return new ChannelFault(*this); }
   void genRandomError(CacheLine *line) {
     bool noError = true;
     while (noError) {
@@ -349,10 +354,11 @@ class ChannelFault : public Fault {
 class SingleColumnFault : public Fault {
  public:
   SingleColumnFault(FaultDomain *fd, bool _isTransient, int _numDQ)
-      : Fault(fd, "Scol", SCOL_MASK, OPERATIONAL, _isTransient, _numDQ,
+      : Fault(fd, "Scol", fd->getGeometry()->SCOL_MASK, OPERATIONAL, _isTransient, _numDQ,
               SINGLE_BEAT, MULTI_ROW, SINGLE_COLUMN, NO_CHANNEL, 0, 1) {
-    double p = ((double)rand()) / RAND_MAX;
+    double p = ((double)timelineRand()) / RAND_MAX;
   }
+  Fault *clone() const { return new SingleColumnFault(*this); }
   std::vector<int> setFinegrainedMask(std::vector<int> &pos) {
     /*
       pos[0] = _burstRowlength, pos[1] = _num_groups
@@ -364,25 +370,25 @@ class SingleColumnFault : public Fault {
     */    
     int _burstRow_length = pos[0];
     int _num_groups = pos[1];
-    effective_mask = DEFAULT_MASK;
+    effective_mask = fd->getGeometry()->DEFAULT_MASK;
     int num_row_bit = ceil(log2(_burstRow_length));
     int num_group_bit = ceil(log2(_num_groups));
-    if (num_row_bit + num_group_bit > row_address_bits) {
+    if (num_row_bit + num_group_bit > fd->getGeometry()->row_address_bits) {
       std::cout << "Error: too many rows or groups" << std::endl;
       exit(1);
     }
     int random_row_bitpos = 0;
     int random_group_bitpos = 0;
     if(pos.size() == 2){
-      random_row_bitpos = rand() % (row_address_bits - num_row_bit - num_group_bit);
-      random_group_bitpos = rand() % (row_address_bits - num_row_bit - num_group_bit - random_row_bitpos);
+      random_row_bitpos = timelineRand() % (fd->getGeometry()->row_address_bits - num_row_bit - num_group_bit);
+      random_group_bitpos = timelineRand() % (fd->getGeometry()->row_address_bits - num_row_bit - num_group_bit - random_row_bitpos);
     } else {
       assert(pos.size() == 4);
       random_row_bitpos = pos[2];
       random_group_bitpos = pos[3];
     }
-    effective_mask = effective_mask | ((1 << num_row_bit) - 1) << (column_address_bits + random_row_bitpos);
-    effective_mask = effective_mask | ((1 << num_group_bit) - 1) << (column_address_bits + num_row_bit + random_group_bitpos);
+    effective_mask = effective_mask | ((1 << num_row_bit) - 1) << (fd->getGeometry()->column_address_bits + random_row_bitpos);
+    effective_mask = effective_mask | ((1 << num_group_bit) - 1) << (fd->getGeometry()->column_address_bits + num_row_bit + random_group_bitpos);
     return std::vector<int>{random_row_bitpos, random_group_bitpos};
   }
 };
@@ -393,13 +399,13 @@ class SingleColumnFault : public Fault {
 class SingleRowFault : public Fault {
  public:
   SingleRowFault(FaultDomain *fd, bool _isTransient, int _numDQ)
-      : Fault(fd, "Srow", SROW_MASK, OPERATIONAL, _isTransient, _numDQ,
+      : Fault(fd, "Srow", fd->getGeometry()->SROW_MASK, OPERATIONAL, _isTransient, _numDQ,
               MULTI_BEAT, SINGLE_ROW, MULTI_COLUMN, NO_CHANNEL,
-              (((SROW_MASK ^ DEFAULT_MASK) >> 15) + 1) / 8, BANKSPERBEAT) {
+              (((fd->getGeometry()->SROW_MASK ^ fd->getGeometry()->DEFAULT_MASK) >> 15) + 1) / 8, BANKSPERBEAT) {
 
-    double p = ((double)rand()) / RAND_MAX;
+    double p = ((double)timelineRand()) / RAND_MAX;
     if (_numDQ == 1){
-      mask = SROW_MASK | combo_mask;
+      mask = fd->getGeometry()->SROW_MASK | fd->getGeometry()->combo_mask;
     }
     affectedBlkCount = 1;
     }
@@ -408,17 +414,17 @@ class SingleRowFault : public Fault {
 class LocalWordlineFault : public Fault{
   public:
   LocalWordlineFault(FaultDomain *fd, bool _isTransient, int special)
-      : Fault(fd, "Lwordline", SROW_MASK, OPERATIONAL, _isTransient, 1,
+      : Fault(fd, "Lwordline", fd->getGeometry()->SROW_MASK, OPERATIONAL, _isTransient, 1,
               MULTI_BEAT, SINGLE_ROW, MULTI_COLUMN, NO_CHANNEL,
-              (((SROW_MASK ^ DEFAULT_MASK) >> 15) + 1) / 8, BANKSPERBEAT) {
+              (((fd->getGeometry()->SROW_MASK ^ fd->getGeometry()->DEFAULT_MASK) >> 15) + 1) / 8, BANKSPERBEAT) {
 
-    double p = ((double)rand()) / RAND_MAX;
+    double p = ((double)timelineRand()) / RAND_MAX;
     if (special == 1){
-      if (strcmp(DRAMTYPE,"HBM3")==0){
+      if (fd->getGeometry()->is("HBM3")){
         if(p<0.027){ // DUE rate of local_wordline
           numDQ = fd->getChipWidth();
           this->name = "RDEC";
-          mask = SWD_MASK ;
+          mask = fd->getGeometry()->SWD_MASK ;
           update_pinpos(true,4);
         } else {
           numDQ = 2;
@@ -428,7 +434,7 @@ class LocalWordlineFault : public Fault{
         if(p<0.027){ // DUE rate of local_wordline
           numDQ = fd->getChipWidth();
           this->name = "RDEC";
-          mask = SWD_MASK ;
+          mask = fd->getGeometry()->SWD_MASK ;
           update_pinpos(true,2);
         } else {
           numDQ = 1;
@@ -437,12 +443,12 @@ class LocalWordlineFault : public Fault{
       }
     } else if (special == 2){
       // TODO: generalize this
-      mask = SROW_MASK | combo_mask;
+      mask = fd->getGeometry()->SROW_MASK | fd->getGeometry()->combo_mask;
       this->name = "SWD";
-      if (strcmp(DRAMTYPE,"HBM3")==0){
+      if (fd->getGeometry()->is("HBM3")){
         numDQ = 4;
         update_pinpos(true,4);
-      } else if (strcmp(DRAMTYPE,"DDR5")==0 || strcmp(DRAMTYPE,"LPDDR5")==0){
+      } else if (fd->getGeometry()->is("DDR5") || fd->getGeometry()->is("LPDDR5")){
         numDQ = 2;
         update_pinpos(true,2);
       } else{
@@ -459,11 +465,11 @@ class LocalWordlineFault : public Fault{
 class BLSAFault : public Fault{
   public:
     BLSAFault(FaultDomain *fd, bool _isTransient)
-      : Fault(fd, "BLSA", BLSA_MASK, OPERATIONAL, _isTransient, 1,
+      : Fault(fd, "BLSA", fd->getGeometry()->BLSA_MASK, OPERATIONAL, _isTransient, 1,
               SINGLE_BEAT, MULTI_ROW, SINGLE_COLUMN, NO_CHANNEL,
-              DEFAULT_MASK, BANKSPERBEAT) {
+              fd->getGeometry()->DEFAULT_MASK, BANKSPERBEAT) {
       
-    double p = ((double)rand()) / RAND_MAX;
+    double p = ((double)timelineRand()) / RAND_MAX;
     affectedBlkCount = 2048; // two 1k blocks
     update_pinpos();
 
@@ -473,25 +479,25 @@ class BLSAFault : public Fault{
 class BankPatternFault : public Fault{
   public:
     BankPatternFault(FaultDomain *fd, bool _isTransient, int _special)
-      : Fault(fd, "Bank_pattern", BANK_PATTERN_MASK, OPERATIONAL, _isTransient, fd->getChipWidth(),
+      : Fault(fd, "Bank_pattern", fd->getGeometry()->BANK_PATTERN_MASK, OPERATIONAL, _isTransient, fd->getChipWidth(),
               MULTI_BEAT, MULTI_ROW, MULTI_COLUMN, NO_CHANNEL,
-              DEFAULT_MASK, BANKSPERBEAT) {
+              fd->getGeometry()->DEFAULT_MASK, BANKSPERBEAT) {
       
-    double p = ((double)rand()) / RAND_MAX;
+    double p = ((double)timelineRand()) / RAND_MAX;
     // choose nuber from 3-9
-    int num = rand() % 7 + 3;
+    int num = timelineRand() % 7 + 3;
     mask = mask | (1 << num);
     if (_special == 0){
       //diff by 8 banks
-      mask = mask | (8 << (column_address_bits + row_address_bits));
+      mask = mask | (8 << (fd->getGeometry()->column_address_bits + fd->getGeometry()->row_address_bits));
       numDQ=1;
     } else if (_special == 2){
       //many banks
-      mask = mask | ((numofBanks - 1) << (column_address_bits + row_address_bits));
+      mask = mask | ((fd->getGeometry()->numofBanks - 1) << (fd->getGeometry()->column_address_bits + fd->getGeometry()->row_address_bits));
     } else if (_special == 3){
       //not diff by 8 banks, but two bank
-      num = rand() % 3 + 1;
-      mask = mask | (1 << (column_address_bits + row_address_bits + num));
+      num = timelineRand() % 3 + 1;
+      mask = mask | (1 << (fd->getGeometry()->column_address_bits + fd->getGeometry()->row_address_bits + num));
     }
     affectedBlkCount = 16*1024*2; // 16k block(subbank) * 2 banks
     update_pinpos();
@@ -502,19 +508,19 @@ class BankPatternFault : public Fault{
 class CDECFault : public Fault{
   public:
     CDECFault(FaultDomain *fd, bool _isTransient, int _special)
-      : Fault(fd, "CDEC", CDEC_MASK, OPERATIONAL, _isTransient, fd->getChipWidth(),
+      : Fault(fd, "CDEC", fd->getGeometry()->CDEC_MASK, OPERATIONAL, _isTransient, fd->getChipWidth(),
               MULTI_BEAT, MULTI_ROW, MULTI_COLUMN, NO_CHANNEL,
-              DEFAULT_MASK, BANKSPERBEAT) {
+              fd->getGeometry()->DEFAULT_MASK, BANKSPERBEAT) {
       
-    double p = ((double)rand()) / RAND_MAX;
+    double p = ((double)timelineRand()) / RAND_MAX;
     if (_special == 0){ 
       //decoder_multi_col
       // choose nuber from 3-9
-      int num = rand() % 7 + 3;
+      int num = timelineRand() % 7 + 3;
       mask = mask | (1 << num);
       if(p > 0.0848){ // col_single_bank  DUE prob is 0.0848 ==> 4DQ happen for 0.0848
         this->name = "CSL";
-        mask = CSL_MASK;
+        mask = fd->getGeometry()->CSL_MASK;
         numDQ = 1;
         update_pinpos();
       } else {
@@ -525,7 +531,7 @@ class CDECFault : public Fault{
     } else if (_special == 1){
       if(p>0.395){ // col_single_bank  DUE prob is 0.395 ==> 4DQ happen for 0.395
         this->name = "CSL";
-        mask = CSL_MASK;
+        mask = fd->getGeometry()->CSL_MASK;
         numDQ = 1;
         update_pinpos();
       }else{
@@ -533,7 +539,7 @@ class CDECFault : public Fault{
       }
     }
     affectedBlkCount = 16*1024*2;
-    if (strcmp(DRAMTYPE,"LPDDR5_SPLIT")==0){
+    if (fd->getGeometry()->is("LPDDR5_SPLIT")){
       numDQ=8;
       update_pinpos(true,8);
     } 
@@ -543,20 +549,20 @@ class CDECFault : public Fault{
 class CSLFault : public Fault{
   public:
     CSLFault(FaultDomain *fd, bool _isTransient, int _special)
-      : Fault(fd, "CSL", CSL_MASK, OPERATIONAL, _isTransient, 1,
+      : Fault(fd, "CSL", fd->getGeometry()->CSL_MASK, OPERATIONAL, _isTransient, 1,
               SINGLE_BEAT, MULTI_ROW, MULTI_COLUMN, NO_CHANNEL,
-              DEFAULT_MASK, BANKSPERBEAT) {
+              fd->getGeometry()->DEFAULT_MASK, BANKSPERBEAT) {
       
-    double p = ((double)rand()) / RAND_MAX;
+    double p = ((double)timelineRand()) / RAND_MAX;
     if (_special == 0){
       // It is multi csl, column and bank
       // would not exceed 16k rows, but no guarantee for others
-      mask = mask | (0xFFFFFFFFFFFFFFFFULL >> (64-(int)(column_address_bits)));
+      mask = mask | (0xFFFFFFFFFFFFFFFFULL >> (64-(int)(fd->getGeometry()->column_address_bits)));
       numDQ = fd->getChipWidth();
     }else if (_special == 1){
       // It is csl_single_bank. Select 1 column
       // which is two column error.
-      int num = rand() % (column_address_bits-3);
+      int num = timelineRand() % (fd->getGeometry()->column_address_bits-3);
       mask = mask | (0x1 << (num+3));
     } else if(_special == 2){
       mask = mask;
@@ -569,24 +575,24 @@ class CSLFault : public Fault{
 class MultiModuleFault : public Fault{
   public:
     MultiModuleFault(FaultDomain *fd, bool _isTransient,int _special)
-      : Fault(fd, "Multi_module", CHANNEL_MASK, OPERATIONAL, _isTransient, fd->getChipWidth(),
+      : Fault(fd, "Multi_module", fd->getGeometry()->CHANNEL_MASK, OPERATIONAL, _isTransient, fd->getChipWidth(),
               MULTI_BEAT, MULTI_ROW, MULTI_COLUMN, NO_CHANNEL,
-              DEFAULT_MASK, BANKSPERBEAT) {
+              fd->getGeometry()->DEFAULT_MASK, BANKSPERBEAT) {
       
     // Add at most 32 row faults or 
     // at most 2 column faults
     this->numDQ = fd->getChipWidth();
-    double p = ((double)rand()) / RAND_MAX;
+    double p = ((double)timelineRand()) / RAND_MAX;
 
     if (p < 0.5){
     this->detailed_faults.push_back(
         std::make_shared<BankPatternFault>(fd, _isTransient, 0));
         affectedBlkCount = 16*1024 *2;
     } else {
-      int n = rand() % 32 + 1;
+      int n = timelineRand() % 32 + 1;
       for (int i = 0; i < n; i++){
         auto new_fault = std::make_shared<SingleRowFault>(fd, _isTransient, fd->getChipWidth());
-        new_fault-> addr = (this->addr & (~SBANK_MASK)) | ((RAND_MAX * ((ADDR)rand()) + rand())& (SBANK_MASK)); // only guarantee the same bank
+        new_fault-> addr = (this->addr & (~fd->getGeometry()->SBANK_MASK)) | ((RAND_MAX * ((ADDR)timelineRand()) + timelineRand())& (fd->getGeometry()->SBANK_MASK)); // only guarantee the same bank
       
         this->detailed_faults.push_back(
           new_fault
@@ -601,19 +607,19 @@ class MultiModuleFault : public Fault{
 class RDECFault : public Fault{
   public:
     RDECFault(FaultDomain *fd, bool _isTransient, int _special)
-      : Fault(fd, "RDEC", RDEC_MASK, OPERATIONAL, _isTransient, fd->getChipWidth(),
+      : Fault(fd, "RDEC", fd->getGeometry()->RDEC_MASK, OPERATIONAL, _isTransient, fd->getChipWidth(),
               MULTI_BEAT, MULTI_ROW, MULTI_COLUMN, NO_CHANNEL,
-              DEFAULT_MASK, BANKSPERBEAT) {
-    double r = ((double)rand()) / RAND_MAX;
+              fd->getGeometry()->DEFAULT_MASK, BANKSPERBEAT) {
+    double r = ((double)timelineRand()) / RAND_MAX;
     if (_special == 0){
       // lwl_sel, lwl_sel2
-      int num = rand() % 63  + 1;
-      mask = LWL_MASK | (num << column_address_bits + subarray_address_bits);
+      int num = timelineRand() % 63  + 1;
+      mask = fd->getGeometry()->LWL_MASK | (num << fd->getGeometry()->column_address_bits + fd->getGeometry()->subarray_address_bits);
       
       // TODO: generalize this
       // When we assume there are 1 MAT / 1DQ:
       // 3/5 change 2 DQ, 2/5 chance 1 DQ
-      if (strcmp(DRAMTYPE,"HBM3")==0 ){
+      if (fd->getGeometry()->is("HBM3")){
         if (r < 0.031) { // DUE rate of lwl_sel is 0.031
           numDQ = fd->getChipWidth();
         } else {
@@ -633,8 +639,8 @@ class RDECFault : public Fault{
       affectedBlkCount = num;
     } else if (_special == 1){
       // On RDEC_MASK, add 1 to randomly on 17th to 22nd bit
-      int x = rand()%64;
-      mask = RDEC_MASK | (x << (16));
+      int x = timelineRand()%64;
+      mask = fd->getGeometry()->RDEC_MASK | (x << (16));
       affectedBlkCount = x;
       if (r<0.18){ // row_decoder DUE rate
         numDQ = 2;
@@ -644,7 +650,7 @@ class RDECFault : public Fault{
       }
       update_pinpos(true,4);
       /*
-      if (strcmp(DRAMTYPE,"LPDDR5_SPLIT")==0 ){
+      if (fd->getGeometry()->is("LPDDR5_SPLIT")){
         numDQ=8;
         update_pinpos(true,8);
       }
@@ -657,23 +663,23 @@ class RDECFault : public Fault{
 class SWDFault : public Fault{
   public:
     SWDFault(FaultDomain *fd, bool _isTransient, int _special)
-      : Fault(fd, "SWD", SWD_MASK, OPERATIONAL, _isTransient, 2,
+      : Fault(fd, "SWD", fd->getGeometry()->SWD_MASK, OPERATIONAL, _isTransient, 2,
               MULTI_BEAT, MULTI_ROW, MULTI_COLUMN, NO_CHANNEL,
-              DEFAULT_MASK, BANKSPERBEAT) {
+              fd->getGeometry()->DEFAULT_MASK, BANKSPERBEAT) {
       if (_special == 0){
         // one cluster
-        mask = SWD_MASK;
-        double r = ((double)rand()) / RAND_MAX;
+        mask = fd->getGeometry()->SWD_MASK;
+        double r = ((double)timelineRand()) / RAND_MAX;
         // TODO: generalize this
 
         // When we assume there are 2 MAT / 1DQ:
         // 3/9 change 2 DQ, 6/9 chance 1 DQ
         
-        if(strcmp(DRAMTYPE,"HBM3")==0){
+        if(fd->getGeometry()->is("HBM3")){
           if(r<0.19){
             numDQ = fd->getChipWidth();
             this->name = "RDEC";
-            mask = RDEC_MASK;
+            mask = fd->getGeometry()->RDEC_MASK;
           } else {
             numDQ = 4;
           }                    
@@ -682,7 +688,7 @@ class SWDFault : public Fault{
           if(r<0.19){
             numDQ = 4;
             this->name = "RDEC";
-            mask = RDEC_MASK;
+            mask = fd->getGeometry()->RDEC_MASK;
           } else {
             numDQ = 1;
           }
@@ -690,12 +696,12 @@ class SWDFault : public Fault{
         }
         
       } else if (_special == 1){
-        mask = SWD_MASK | combo_mask;
-        if(strcmp(DRAMTYPE,"HBM3")==0){
+        mask = fd->getGeometry()->SWD_MASK | fd->getGeometry()->combo_mask;
+        if(fd->getGeometry()->is("HBM3")){
           numDQ=4;
           update_pinpos(true,4);
         } else{
-          if (combo_mask == 0){
+          if (fd->getGeometry()->combo_mask == 0){
             numDQ = 2;
           }else {
             numDQ = 1;
@@ -710,9 +716,9 @@ class SWDFault : public Fault{
 class DistBitFault : public Fault{
   public:
     DistBitFault(FaultDomain *fd, bool _isTransient, int _special)
-      : Fault(fd, "Dist_bit", DEFAULT_MASK, OPERATIONAL, _isTransient, 1,
+      : Fault(fd, "Dist_bit", fd->getGeometry()->DEFAULT_MASK, OPERATIONAL, _isTransient, 1,
               SINGLE_BEAT, SINGLE_ROW, SINGLE_COLUMN, NO_CHANNEL,
-              DEFAULT_MASK, BANKSPERBEAT) {
+              fd->getGeometry()->DEFAULT_MASK, BANKSPERBEAT) {
       if (_special == 0){
         for (int i = 0; i< 10; i++){
           this->detailed_faults.push_back(
@@ -730,9 +736,9 @@ class DistBitFault : public Fault{
 class SingleBankFault : public Fault {
  public:
   SingleBankFault(FaultDomain *fd, bool _isTransient, int _numDQ)
-      : Fault(fd, "Sbank", SBANK_MASK, OPERATIONAL, _isTransient, _numDQ,
+      : Fault(fd, "Sbank", fd->getGeometry()->SBANK_MASK, OPERATIONAL, _isTransient, _numDQ,
               MULTI_BEAT, MULTI_ROW, MULTI_COLUMN, NO_CHANNEL, 0, BANKSPERBEAT) {
-    double p = ((double)rand()) / RAND_MAX;
+    double p = ((double)timelineRand()) / RAND_MAX;
 
   }
 };
@@ -743,9 +749,9 @@ class SingleBankFault : public Fault {
 class MultiBankFault : public Fault {
  public:
   MultiBankFault(FaultDomain *fd, bool _isTransient, int _numDQ)
-      : Fault(fd, "Mbank", MBANK_MASK, OPERATIONAL, _isTransient, _numDQ,
+      : Fault(fd, "Mbank", fd->getGeometry()->MBANK_MASK, OPERATIONAL, _isTransient, _numDQ,
               MULTI_BEAT, MULTI_ROW, MULTI_COLUMN, NO_CHANNEL, 0, BANKSPERBEAT) {
-    double p = ((double)rand()) / RAND_MAX;
+    double p = ((double)timelineRand()) / RAND_MAX;
 
 
   }
@@ -757,9 +763,9 @@ class MultiBankFault : public Fault {
 class MultiRankFault : public Fault {
  public:
   MultiRankFault(FaultDomain *fd, bool _isTransient, int _numDQ)
-      : Fault(fd, "Mrank", MRANK_MASK, OPERATIONAL, _isTransient, _numDQ,
+      : Fault(fd, "Mrank", fd->getGeometry()->MRANK_MASK, OPERATIONAL, _isTransient, _numDQ,
               MULTI_BEAT, MULTI_ROW, MULTI_COLUMN, NO_CHANNEL, 0, BANKSPERBEAT) {
-    double p = ((double)rand()) / RAND_MAX;
+    double p = ((double)timelineRand()) / RAND_MAX;
 
   }
 };
@@ -780,13 +786,13 @@ class InherentFault : public Fault {
     int ChannelWidth = line->getChannelWidth();
     int chipWidth = line->getChipWidth();
     int height = line->getBeatHeight();
-    int chip = rand() % (ChannelWidth / chipWidth);
+    int chip = timelineRand() % (ChannelWidth / chipWidth);
     numInherentFaults = numErrors;
     if (numErrors <= Twelv) {
       for (int i = 0; i < numErrors; i++) {
-        if (chipRand) chip = rand() % (ChannelWidth / chipWidth);
-        int bitPos = rand() % chipWidth;
-        int beatPos = rand() % height;
+        if (chipRand) chip = timelineRand() % (ChannelWidth / chipWidth);
+        int bitPos = timelineRand() % chipWidth;
+        int beatPos = timelineRand() % height;
         int bit = ChannelWidth * beatPos + chip * chipWidth + bitPos;
         if (line->bitArr[bit] == 0) {
           line->setBit(bit, true);
@@ -806,15 +812,15 @@ class InherentFault : public Fault {
         iter = Double;
       for (int j = 0; j < iter; j++) {
         if (j == 0) {
-          firstChip = chip = rand() % (ChannelWidth / chipWidth);
+          firstChip = chip = timelineRand() % (ChannelWidth / chipWidth);
         } else if (j == 1) {
           while (firstChip == chip) {
-            chip = rand() % (ChannelWidth / chipWidth);
+            chip = timelineRand() % (ChannelWidth / chipWidth);
           }
           secondChip = chip;
         } else {
           while (firstChip == chip || secondChip == chip) {
-            chip = rand() % (ChannelWidth / chipWidth);
+            chip = timelineRand() % (ChannelWidth / chipWidth);
           }
         }
         int err = Double;
@@ -827,8 +833,8 @@ class InherentFault : public Fault {
           err = Single;
         numInherentFaults += err;
         for (int i = 0; i < err; i++) {
-          int bitPos = rand() % chipWidth;
-          int beatPos = rand() % height;
+          int bitPos = timelineRand() % chipWidth;
+          int beatPos = timelineRand() % height;
           int bit = ChannelWidth * beatPos + chip * chipWidth + bitPos;
           if (line->bitArr[bit] == 0) {
             line->setBit(bit, true);
@@ -841,11 +847,11 @@ class InherentFault : public Fault {
       }
     } else if (numErrors == SingleSingleSingleOn18Symbol){
       numInherentFaults=3;
-      int chip = rand() % (ChannelWidth / chipWidth);
-      int bitPos = rand() % chipWidth;
+      int chip = timelineRand() % (ChannelWidth / chipWidth);
+      int bitPos = timelineRand() % chipWidth;
       int prevbeat = -1;
       for (int j = 0; j < 3; j++) {
-        int beatPos = rand() % height;
+        int beatPos = timelineRand() % height;
         int bit = ChannelWidth * beatPos + chip * chipWidth + bitPos;
         if (prevbeat == -1) {
           prevbeat = beatPos;
@@ -866,11 +872,11 @@ class InherentFault : public Fault {
       }
     } else if (numErrors == SingleSingleOn18Symbol){
       numInherentFaults=2;
-      int chip = rand() % (ChannelWidth / chipWidth);
-      int bitPos = rand() % chipWidth;
+      int chip = timelineRand() % (ChannelWidth / chipWidth);
+      int bitPos = timelineRand() % chipWidth;
       int prevbeat = -1;
       for (int j = 0; j < 2; j++) {
-        int beatPos = rand() % height;
+        int beatPos = timelineRand() % height;
         int bit = ChannelWidth * beatPos + chip * chipWidth + bitPos;
         if (prevbeat == -1) {
           prevbeat = beatPos;
@@ -908,12 +914,12 @@ class InherentFault : public Fault {
     std::list<int>::iterator iter;
     for (int i = 0; i < faultyCellCount; i++) {
       do {
-        chip = rand() % (ChannelWidth / chipWidth);
+        chip = timelineRand() % (ChannelWidth / chipWidth);
         iter = std::find(chip_list.begin(), chip_list.end(), chip);
       } while (iter != chip_list.end());
 
-      int bitPos = rand() % chipWidth;
-      int beatPos = rand() % height;
+      int bitPos = timelineRand() % chipWidth;
+      int beatPos = timelineRand() % height;
       int bit = ChannelWidth * beatPos + chip * chipWidth + bitPos;
       if (line->bitArr[bit] == 0) {
         line->bitArr[bit] = 1;
@@ -954,7 +960,7 @@ class InherentFault2 : public Fault {
       limit = faultyCellCount;
     }
     for (int i = 0; i < limit; i++) {
-      int bitPos = rand() % line->getBitN();
+      int bitPos = timelineRand() % line->getBitN();
       if (line->bitArr[bitPos] == 0) {
         line->bitArr[bitPos] = 1;
       } else {
@@ -0,0 +1,118 @@
+/*
+Copyright 2023, The University of Texas at Austin
+All rights reserved.
+
+THIS FILE IS PART OF THE DRAM FAULT ERROR SIMULATION FRAMEWORK
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * @file: FaultCorpus.cc
+ * @brief Binary corpus of the fault arrivals of system-level runs
+ */
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "FaultCorpus.hh"
+
+static const char CORPUS_MAGIC[8] = {'F', 'L', 'T', 'C', 'O', 'R', 'P', '1'};
+
+//------------------------------------------------------------------------------
+bool FaultCorpusWriter::open(const char *fileName, uint32_t domainCount,
+                             uint32_t typeCount, uint32_t typeHash,
+                             double horizonHr)
+{
+  fd = fopen(fileName, "wb");
+  if (fd == NULL) return false;
+  setvbuf(fd, NULL, _IOFBF, 1 << 20);
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, CORPUS_MAGIC, sizeof(header.magic));
+  header.recordSize = sizeof(FaultRecord);
+  header.domainCount = domainCount;
+  header.typeCount = typeCount;
+  header.typeHash = typeHash;
+  header.horizonHr = horizonHr;
+  // rewritten by close()
+  fwrite(&header, sizeof(header), 1, fd);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void FaultCorpusWriter::close()
+{
+  if (fd == NULL) return;
+  fseek(fd, 0, SEEK_SET);
+  fwrite(&header, sizeof(header), 1, fd);
+  fclose(fd);
+  fd = NULL;
+}
+
+//------------------------------------------------------------------------------
+FaultCorpusReader::~FaultCorpusReader()
+{
+  if (map != NULL) munmap(map, mapSize);
+}
+
+//------------------------------------------------------------------------------
+bool FaultCorpusReader::open(const char *fileName)
+{
+  int fd = ::open(fileName, O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  if ((fstat(fd, &st) != 0) || (st.st_size < (off_t)sizeof(FaultCorpusHeader)))
+  {
+    ::close(fd);
+    return false;
+  }
+  mapSize = st.st_size;
+  map = mmap(NULL, mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (map == MAP_FAILED)
+  {
+    map = NULL;
+    return false;
+  }
+  // records are consumed front to back
+  madvise(map, mapSize, MADV_SEQUENTIAL);
+  header = (const FaultCorpusHeader *)map;
+  records = (const FaultRecord *)(header + 1);
+  return (memcmp(header->magic, CORPUS_MAGIC, sizeof(CORPUS_MAGIC)) == 0) &&
+         (header->recordSize == sizeof(FaultRecord)) &&
+         (mapSize >= sizeof(FaultCorpusHeader) +
+                         header->recordCount * sizeof(FaultRecord));
+}
@@ -0,0 +1,135 @@
+/*
+Copyright 2023, The University of Texas at Austin
+All rights reserved.
+
+THIS FILE IS PART OF THE DRAM FAULT ERROR SIMULATION FRAMEWORK
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * @file: FaultCorpus.hh
+ * @brief Binary corpus of the fault arrivals of system-level runs
+ * @details A recorded corpus holds, per fault arrival, everything needed to
+ * inject the same fault again: the run, time, domain and fault type, and
+ * the seed the random engines (see seedRandom()) are set to before the fault
+ * and its error bits are drawn. The address, mask and positions of the drawn fault are
+ * stored as well to check that a replay regenerates the same fault. Replay
+ * streams the corpus from a read-only mapping, so new ECC schemes are
+ * compared on identical inputs.
+ */
+
+#ifndef __FAULT_CORPUS_HH__
+#define __FAULT_CORPUS_HH__
+
+#include <stdint.h>
+#include <stdio.h>
+
+/** @class FaultRecord
+ * \brief One fault arrival of a recorded run
+ */
+struct FaultRecord {
+  double hr;        //!< arrival time
+  uint64_t seed;    //!< seed of the draws of the fault and its errors
+  uint64_t addr;    //!< address of the drawn fault
+  uint64_t mask;    //!< mask of the drawn fault
+  uint32_t trial;   //!< run index
+  uint32_t domain;  //!< FaultDomain::groupIdx
+  int16_t type;     //!< FaultRateInfo entry index (-1: inherent activation)
+  int16_t chipID;
+  int16_t pinID;
+  uint8_t overlapped;  //!< overlaps weak cells
+  uint8_t reserved;
+};
+static_assert(sizeof(FaultRecord) == 48, "FaultRecord layout changed");
+
+/** @class FaultCorpusHeader
+ * \brief Header of a corpus file, followed by recordCount FaultRecords
+ */
+struct FaultCorpusHeader {
+  char magic[8];         //!< "FLTCORP1"
+  uint32_t recordSize;   //!< sizeof(FaultRecord)
+  uint32_t domainCount;  //!< domains of the recorded DomainGroup
+  uint32_t typeCount;    //!< operational fault types of the catalog
+  uint32_t typeHash;     //!< hash of their names
+  uint64_t trials;       //!< recorded runs
+  uint64_t recordCount;
+  double horizonHr;      //!< simulated lifetime of the runs
+};
+
+/** @class FaultCorpusWriter
+ * \brief Appends the records of a corpus to a file
+ */
+class FaultCorpusWriter {
+ public:
+  FaultCorpusWriter() {}
+  ~FaultCorpusWriter() { close(); }
+
+  bool open(const char *fileName, uint32_t domainCount, uint32_t typeCount,
+            uint32_t typeHash, double horizonHr);
+  void append(const FaultRecord &record) {
+    fwrite(&record, sizeof(record), 1, fd);
+    header.recordCount++;
+  }
+  uint64_t getRecordCount() const { return header.recordCount; }
+  //! runs recorded so far (including those without faults)
+  void setTrials(uint64_t trials) { header.trials = trials; }
+  //! write the final header and close the file
+  void close();
+
+ protected:
+  FILE *fd = NULL;
+  FaultCorpusHeader header;
+};
+
+/** @class FaultCorpusReader
+ * \brief Read-only mapping of a corpus file
+ */
+class FaultCorpusReader {
+ public:
+  FaultCorpusReader() {}
+  ~FaultCorpusReader();
+
+  bool open(const char *fileName);
+  const FaultCorpusHeader &getHeader() const { return *header; }
+  const FaultRecord *getRecords() const { return records; }
+  uint64_t getRecordCount() const { return header->recordCount; }
+
+ protected:
+  void *map = NULL;
+  size_t mapSize = 0;
+  const FaultCorpusHeader *header = NULL;
+  const FaultRecord *records = NULL;
+};
+
+#endif /* __FAULT_CORPUS_HH__ */
@@ -37,6 +37,7 @@ ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
 POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <algorithm>
 #include <assert.h>
 #include <math.h>
 #include <stdio.h>
@@ -45,6 +46,8 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "Config.hh"
 #include "ECC.hh"
 #include "FaultDomain.hh"
+#include "Profile.hh"
+#include "Scrubber.hh"
 #include "Tester.hh"
 
 //------------------------------------------------------------------------------
@@ -54,125 +57,38 @@ ErrorType worseErrorType(ErrorType a, ErrorType b) { return (a > b) ? a : b; }
 ErrorType FaultDomain::genScenarioRandomFaultAndTest(ECC *ecc, int faultCount,
                                                      std::string *faults,
                                                      bool chipOverlapCheck) {
-  CacheLine blk = {
-      pinsPerDevice,
-      (devicesPerRank - (int)retiredChipIDList.size()) * pinsPerDevice -
-          (int)retiredPinIDList.size(),
-      blkHeight, message_config};
-
   clear();
 
-  
+  // the cache line is kept across trials (no chip or pin is retired here)
+  if (scenarioLine == NULL) {
+    scenarioLine = new CacheLine(pinsPerDevice, devicesPerRank * pinsPerDevice,
+                                 blkHeight, message_config);
+  }
+  CacheLine &blk = *scenarioLine;
+  blk.reset();
+  blk.errorDQ = 0;
 
-  int fault1ChipID = -1;
-  int fault2ChipID = -1;
-  int fault3ChipID = -1;
+  // distinct chips are drawn without replacement (partial Fisher-Yates)
+  if (chipOverlapCheck) {
+    assert(faultCount <= devicesPerRank);
+    scenarioChips.resize(devicesPerRank);
+    for (int i = 0; i < devicesPerRank; i++) scenarioChips[i] = i;
+  }
 
-  // generate fault1
-  if (faultCount > 0) {
-    Fault *fault1 = Fault::genRandomFault(faults[0], this);
-    // GONG
-    operationalFaultList.push_back(fault1);
-    currentPossibleFaultList.push_back(fault1);
-    activeFaultList.push_back(fault1);
-
-    fault1->genRandomError(&blk);
-    fault1ChipID = fault1->getChipID();
-    //        delete fault1;
-  }
-  // generate fault2
-  if (faultCount > 1) {
-    Fault *fault2 = NULL;
-    do {
-      if (fault2 != NULL) delete fault2;  // delete previous one
-      fault2 = Fault::genRandomFault(faults[1], this);
-    } while (fault2->getChipID() == fault1ChipID && chipOverlapCheck);
-    // GONG
-    operationalFaultList.push_back(fault2);
-    currentPossibleFaultList.push_back(fault2);
-    activeFaultList.push_back(fault2);
-
-    fault2->genRandomError(&blk);
-    fault2ChipID = fault2->getChipID();
-    //        delete fault2;
-  }
-
-  // generate fault3
-  if (faultCount > 2) {
-    Fault *fault3 = NULL;
-    do {
-      if (fault3 != NULL) delete fault3;  // delete previous one
-      fault3 = Fault::genRandomFault(faults[2], this);
-    } while (((fault3->getChipID() == fault1ChipID) ||
-              (fault3->getChipID() == fault2ChipID)) &&
-             chipOverlapCheck);
-    // GONG
-    operationalFaultList.push_back(fault3);
-    currentPossibleFaultList.push_back(fault3);
-    activeFaultList.push_back(fault3);
-
-    fault3->genRandomError(&blk);
-    fault3ChipID = fault3->getChipID();
-    //        delete fault3;
-  }
-
-  // generate fault4
-  if (faultCount > 3) {
-    Fault *fault4 = NULL;
-    do {
-      if (fault4 != NULL) delete fault4;  // delete previous one
-      fault4 = Fault::genRandomFault(faults[3], this);
-    } while (((fault4->getChipID() == fault1ChipID) ||
-              (fault4->getChipID() == fault2ChipID) ||
-              (fault4->getChipID() == fault3ChipID)) &&
-             chipOverlapCheck);
-    // GONG
-    operationalFaultList.push_back(fault4);
-    currentPossibleFaultList.push_back(fault4);
-    activeFaultList.push_back(fault4);
-
-    fault4->genRandomError(&blk);
-    //        delete fault4;
-  }
-
-  // generate fault5
-  if (faultCount > 4) {
-    Fault *fault5 = NULL;
-    do {
-      if (fault5 != NULL) delete fault5;  // delete previous one
-      fault5 = Fault::genRandomFault(faults[4], this);
-    } while (((fault5->getChipID() == fault1ChipID) ||
-              (fault5->getChipID() == fault2ChipID) ||
-              (fault5->getChipID() == fault3ChipID)) &&
-             chipOverlapCheck);
-    // GONG
-    operationalFaultList.push_back(fault5);
-    currentPossibleFaultList.push_back(fault5);
-    activeFaultList.push_back(fault5);
-
-    fault5->genRandomError(&blk);
-    //        delete fault5;
-  }
-
-  // generate fault6
-  if (faultCount > 5) {
-    Fault *fault6 = NULL;
-    do {
-      if (fault6 != NULL) delete fault6;  // delete previous one
-      fault6 = Fault::genRandomFault(faults[5], this);
-    } while (((fault6->getChipID() == fault1ChipID) ||
-              (fault6->getChipID() == fault2ChipID) ||
-              (fault6->getChipID() == fault3ChipID)) &&
-             chipOverlapCheck);
+  for (int i = 0; i < faultCount; i++) {
+    Fault *fault = Fault::genRandomFault(faults[i], this);
+    if (chipOverlapCheck) {
+      int j = i + timelineRand() % (devicesPerRank - i);
+      std::swap(scenarioChips[i], scenarioChips[j]);
+      fault->moveToChip(scenarioChips[i]);
+    }
     // GONG
-    operationalFaultList.push_back(fault6);
-    currentPossibleFaultList.push_back(fault6);
-    activeFaultList.push_back(fault6);
+    operationalFaultList.push_back(fault);
+    currentPossibleFaultList.push_back(fault);
+    activeFaultList.push_back(fault);
 
-    fault6->genRandomError(&blk);
-    //        delete fault6;
+    fault->genRandomError(&blk);
   }
-  assert(faultCount <= 6);
 
   // decode and report the result
   ErrorType result = ecc->decode(this, blk);
@@ -193,7 +109,9 @@ void generateCombinations(const std::vector<Fault*>& faults,
   }
 }
 
-ErrorType FaultDomain::genSystemRandomFaultAndTest(ECC *ecc) {
+ErrorType FaultDomain::genSystemRandomFaultAndTest(ECC *ecc,
+                                                   FaultRecord *record,
+                                                   bool replay) {
   // CacheLine blkOrg = {pinsPerDevice, (devicesPerRank -(int)
   // retiredChipIDList.size()) * pinsPerDevice - (int) retiredPinIDList.size(),
   // blkHeight};
@@ -211,14 +129,27 @@ ErrorType FaultDomain::genSystemRandomFaultAndTest(ECC *ecc) {
   // 1. generate a new fault
   //----------------------------------------------------------
   // std::string newFaultType = faultRateInfo->pickRandomType();
-  const std::pair<std::string, double> *newFaultType =
-      faultRateInfo->pickRandomType();
+  double lr = 1.;
+  const std::pair<std::string, double> *newFaultType;
+  if (replay) {
+    newFaultType = faultRateInfo->getEntry(record->type);
+  } else {
+    newFaultType = faultRateInfo->pickRandomType(&lr);
+    if (record != NULL) record->type = faultRateInfo->getEntryIdx(newFaultType);
+  }
+  if (lr != 1.) _tester->addLikelihoodRatio(lr);
+  // the fault and its errors are drawn from a seed of their own: the one of
+  // the record, or one drawn from the fault timeline
+  FaultDraws draws((record != NULL) ? record->seed : timelineSeed());
 
   // whether this test caused by (intermittent) inherent faults
   bool ByInherentFault = (newFaultType->first == "inherent") ? true : false;
 
   if (!ByInherentFault) {
-    newFault = Fault::genRandomFault(newFaultType->first, this);
+    {
+      PROFILE_SCOPE(PROF_FAULT_GEN);
+      newFault = Fault::genRandomFault(newFaultType->first, this);
+    }
 
     /*	//GONG: retirement is currently not considered with inherent faults
         //----------------------------------------------------------
@@ -246,15 +177,46 @@ ErrorType FaultDomain::genSystemRandomFaultAndTest(ECC *ecc) {
     */
     // overlap_test
     int indram = ecc->getInDRAM();
-    if ((double)rand() / RAND_MAX <=
-        faultRateInfo->overlap_prob(newFault->getName())) {
+    double overlapProb = faultRateInfo->overlap_prob(newFault->getTypeIdx());
+    double biasedProb = _tester->biasOverlapProb(overlapProb);
+    if ((double)timelineRand() / RAND_MAX <= biasedProb) {
       newFault->overlapped = true;
     } else {
       newFault->overlapped = false;
     }
+    if (record != NULL) {
+      if (replay) {
+        // a mismatch means the corpus was recorded with another geometry
+        assert((record->addr == newFault->getAddr()) &&
+               (record->mask == newFault->getMask()) &&
+               (record->chipID == newFault->getChipID()));
+        newFault->overlapped = record->overlapped;
+      } else {
+        record->addr = newFault->getAddr();
+        record->mask = newFault->getMask();
+        record->chipID = newFault->getChipID();
+        record->pinID = newFault->getIsSingleDQ() ? newFault->getPinID() : -1;
+        record->overlapped = newFault->overlapped;
+      }
+    }
+    if (biasedProb != overlapProb) {
+      _tester->addLikelihoodRatio(newFault->overlapped
+                                      ? overlapProb / biasedProb
+                                      : (1 - overlapProb) / (1 - biasedProb));
+    }
 
 #if 1
     operationalFaultList.push_back(newFault);
+    addInherentOverlap(newFault);
+    if (newFault->getIsTransient() && (_scrubber != NULL)) {
+      newFault->scrubDeadline =
+          _scrubber->getDeadline(newFault, _tester->getElapsedTime());
+      // schedule a scrub event only when the earliest deadline moves up
+      if (newFault->scrubDeadline < transientDeadline) {
+        transientDeadline = newFault->scrubDeadline;
+        _tester->schedule(EV_SCRUB, transientDeadline, this);
+      }
+    }
 
   } else {
     // GONG: we do not generate a new fault.
@@ -264,9 +226,11 @@ ErrorType FaultDomain::genSystemRandomFaultAndTest(ECC *ecc) {
     } else {
       // no operational fault yet.
       blk.reset();
-      if (inherentFault != NULL)
-        inherentFault->genRandomErrors(&blk, faultRateInfo->iRate->getEP(),
+      if (inherentFault != NULL) {
+        PROFILE_SCOPE(PROF_ERROR_GEN);
+        inherentFault->genRandomErrors(&blk, faultRateInfo->getEP(),
                                        ecc->chipRand);
+      }
       return worseErrorType(result, ecc->decode(this, blk));
     }
   }
@@ -280,27 +244,34 @@ ErrorType FaultDomain::genSystemRandomFaultAndTest(ECC *ecc) {
   activeFaultList.clear();
   activeFaultList.push_back(newFault);
   //Simplified version for multiple overlaps
-  auto it1 = operationalFaultList.crbegin();
   bool overlap = false;
-  for (++it1; it1 != operationalFaultList.crend(); ++it1) {
-    if ((*it1)->overlap(newFault)) {
-      overlap = true;
-      currentPossibleFaultList.push_back(*it1);
-      activeFaultList.push_back(*it1);
+  {
+    PROFILE_SCOPE(PROF_OVERLAP);
+    auto it1 = operationalFaultList.crbegin();
+    for (++it1; it1 != operationalFaultList.crend(); ++it1) {
+      if ((*it1)->overlap(newFault)) {
+        overlap = true;
+        currentPossibleFaultList.push_back(*it1);
+        activeFaultList.push_back(*it1);
+      }
     }
   }
   if (!overlap) {
     blk.reset();
-    if (ByInherentFault) {
-      inherentFault->genRandomErrors(&blk, faultRateInfo->iRate->getEP(),
-                                    ecc->chipRand);
-    } else if (inherentFault != NULL) {
-      inherentFault->genRandomError(&blk);
-    }
+    {
+      PROFILE_SCOPE(PROF_ERROR_GEN);
+      if (ByInherentFault) {
+        inherentFault->genRandomErrors(&blk, faultRateInfo->getEP(),
+                                      ecc->chipRand);
+      } else if (inherentFault != NULL) {
+        inherentFault->genRandomError(&blk);
+      }
 
-    newFault->genRandomError(&blk);
+      newFault->genRandomError(&blk);
+    }
     result = worseErrorType(result, ecc->decode(this, blk));
   } else {
+    PROFILE_SCOPE(PROF_COMBINATIONS);
     std::vector<Fault*> overlappedFaults = currentPossibleFaultList;
     overlappedFaults.push_back(newFault);
     std::vector<std::vector<Fault*>> combinations;
@@ -316,16 +287,19 @@ ErrorType FaultDomain::genSystemRandomFaultAndTest(ECC *ecc) {
       }
       if (overlap) {
         blk.reset();
-        if (ByInherentFault) {
-          inherentFault->genRandomErrors(&blk, faultRateInfo->iRate->getEP(),
-                                        ecc->chipRand);
-        } else if (inherentFault != NULL) {
-          inherentFault->genRandomError(&blk);
-        }
-        // get length of combo
-        
-        for (const auto& fault : combo) {
-          fault->genRandomError(&blk);
+        {
+          PROFILE_SCOPE(PROF_ERROR_GEN);
+          if (ByInherentFault) {
+            inherentFault->genRandomErrors(&blk, faultRateInfo->getEP(),
+                                          ecc->chipRand);
+          } else if (inherentFault != NULL) {
+            inherentFault->genRandomError(&blk);
+          }
+          // get length of combo
+
+          for (const auto& fault : combo) {
+            fault->genRandomError(&blk);
+          }
         }
         result = worseErrorType(result, ecc->decode(this, blk));
       }
@@ -343,6 +317,7 @@ ErrorType FaultDomain::genSystemRandomFaultAndTest(ECC *ecc) {
         operationalFaultList.remove(newFault);
         activeFaultList.remove(newFault);
         delete newFault;
+        recalcInherentOverlap();
       }
     }else{
       retiredBlkCount = ecc->getMaxRetiredBlkCount();
@@ -400,7 +375,7 @@ ErrorType FaultDomain::genSystemRandomFaultAndTest(ECC *ecc) {
 }
 
 void FaultDomain::resetInherentFault(Fault *fault, ECC *ecc) {
-  faultRateInfo->removeLastRate();
+  faultRateInfo->clearInherentRate();
   setInherentFault(fault, ecc, false);
 }
 void FaultDomain::setInherentFault(Fault *fault, ECC *ecc, bool first) {
@@ -408,9 +383,8 @@ void FaultDomain::setInherentFault(Fault *fault, ECC *ecc, bool first) {
   if (first) InitInherentFaultRate();
   // set inherent Fault Rate
   InherentErrorPattern indram = (InherentErrorPattern)ecc->getInDRAM();
-  faultRateInfo->iRate->setEP(indram);
-  faultRateInfo->addFaultRate("inherent",
-                              faultRateInfo->iRate->getRate(indram));
+  faultRateInfo->setEP(indram);
+  faultRateInfo->setInherentRate(faultRateInfo->iRate->getRate(indram));
 }
 
 bool FaultDomain::overlapTest() {
@@ -421,27 +395,33 @@ bool FaultDomain::overlapTest() {
   return false;
 }
 
-void FaultDomain::updateInherentFault(ECC *ecc) {
-  bool need_update = false;
-  int indram_down = ecc->getInDRAMDown();
-  double rate = 0.0;
-  // check there are operational faults injected
-  for (std::list<Fault *>::iterator it = operationalFaultList.begin();
+void FaultDomain::addInherentOverlap(Fault *fault) {
+  if (!fault->getIsTransient() && fault->overlapped) {
+    inherentOverlapSum += faultRateInfo->overlap_prob(fault->getTypeIdx());
+    inherentOverlapCnt++;
+  }
+}
+
+void FaultDomain::recalcInherentOverlap() {
+  inherentOverlapSum = .0;
+  inherentOverlapCnt = 0;
+  for (auto it = operationalFaultList.begin();
        it != operationalFaultList.end(); it++) {
-    if (!(*it)->getIsTransient()) {
-      if ((*it)->overlapped) {
-        need_update = true;
-        faultRateInfo->iRate->setEP((InherentErrorPattern)indram_down);
-        rate +=
-            faultRateInfo->iRate->getRate((InherentErrorPattern)indram_down) *
-            faultRateInfo->overlap_prob((*it)->getName());
-      }
-    }
+    addInherentOverlap(*it);
   }
+}
 
-  if (need_update) {
-    faultRateInfo->removeLastRate();
-    faultRateInfo->addFaultRate("inherent", rate);
+// The inherent rate only changes when an overlapped permanent fault is added
+// or removed, so it is kept as a running sum instead of rescanning
+// operationalFaultList. As before, the rate is left untouched once no such
+// fault remains.
+void FaultDomain::updateInherentFault(ECC *ecc) {
+  if (inherentOverlapCnt > 0) {
+    InherentErrorPattern indram_down =
+        (InherentErrorPattern)ecc->getInDRAMDown();
+    faultRateInfo->setEP(indram_down);
+    faultRateInfo->setInherentRate(faultRateInfo->iRate->getRate(indram_down) *
+                                   inherentOverlapSum);
   }
 }
 
@@ -461,6 +441,26 @@ void FaultDomain::scrub() {
       }
       );
   }
+  transientDeadline = INFINITY;
+}
+
+void FaultDomain::expireTransientsInternal(double hr) {
+  double nextDeadline = INFINITY;
+  activeFaultList.remove_if([hr](Fault *f) {
+    return f->getIsTransient() && (f->scrubDeadline <= hr);
+  });
+  operationalFaultList.remove_if([hr, &nextDeadline](Fault *f) {
+    if (!f->getIsTransient()) return false;
+    if (f->scrubDeadline <= hr) {
+      delete f;
+      return true;
+    }
+    nextDeadline = std::min(nextDeadline, f->scrubDeadline);
+    return false;
+  });
+  transientDeadline = nextDeadline;
+  if ((_tester != NULL) && (transientDeadline != INFINITY))
+    _tester->schedule(EV_SCRUB, transientDeadline, this);
 }
 
 //------------------------------------------------------------------------------
@@ -476,6 +476,7 @@ void FaultDomain::retirePin(int pinID) {
       ++it;
     }
   }
+  recalcInherentOverlap();
   retiredPinIDList.push_back(pinID);
 }
 
@@ -490,6 +491,7 @@ void FaultDomain::retireChip(int chipID) {
       ++it;
     }
   }
+  recalcInherentOverlap();
   retiredChipIDList.push_back(chipID);
 }
 
@@ -503,6 +505,66 @@ void FaultDomain::clear() {
   retiredPinIDList.clear();
   currentPossibleFaultList.clear();
   activeFaultList.clear();
+  inherentOverlapSum = .0;
+  inherentOverlapCnt = 0;
+  transientDeadline = INFINITY;
+}
+
+FaultDomainState::~FaultDomainState() {
+  for (auto it = faults.begin(); it != faults.end(); ++it) {
+    delete *it;
+  }
+}
+
+void FaultDomain::saveState(FaultDomainState *state) const {
+  for (auto it = operationalFaultList.cbegin();
+       it != operationalFaultList.cend(); ++it) {
+    state->faults.push_back((*it)->clone());
+  }
+  for (auto it = activeFaultList.cbegin(); it != activeFaultList.cend();
+       ++it) {
+    int idx = 0;
+    for (auto it2 = operationalFaultList.cbegin();
+         it2 != operationalFaultList.cend(); ++it2, ++idx) {
+      if (*it2 == *it) {
+        state->activeIdx.push_back(idx);
+        break;
+      }
+    }
+  }
+  state->retiredBlkCount = retiredBlkCount;
+  state->retiredPinIDList = retiredPinIDList;
+  state->retiredChipIDList = retiredChipIDList;
+  state->inherentOverlapSum = inherentOverlapSum;
+  state->inherentOverlapCnt = inherentOverlapCnt;
+  state->transientDeadline = transientDeadline;
+  state->hasInherent = faultRateInfo->hasInherentRate();
+  state->inherentRate = faultRateInfo->getInherentRate();
+  state->errorPattern = faultRateInfo->getEP();
+}
+
+void FaultDomain::restoreState(const FaultDomainState &state) {
+  clear();
+  std::vector<Fault *> faults;
+  for (auto it = state.faults.cbegin(); it != state.faults.cend(); ++it) {
+    faults.push_back((*it)->clone());
+    operationalFaultList.push_back(faults.back());
+  }
+  for (auto it = state.activeIdx.cbegin(); it != state.activeIdx.cend();
+       ++it) {
+    activeFaultList.push_back(faults[*it]);
+  }
+  retiredBlkCount = state.retiredBlkCount;
+  retiredPinIDList = state.retiredPinIDList;
+  retiredChipIDList = state.retiredChipIDList;
+  inherentOverlapSum = state.inherentOverlapSum;
+  inherentOverlapCnt = state.inherentOverlapCnt;
+  transientDeadline = state.transientDeadline;
+  if (state.hasInherent)
+    faultRateInfo->setInherentRate(state.inherentRate);
+  else
+    faultRateInfo->clearInherentRate();
+  faultRateInfo->setEP(state.errorPattern);
 }
 
 void FaultDomain::print(FILE *fd) const {
@@ -695,15 +757,15 @@ void FaultDomain::printVisualFaults(){
              jt != (*it)->detailed_faults.end(); jt++) {
           ADDR mask = (*jt)->getEffectiveMask();
           ADDR address = (*jt)->getAddr();
-          int bankmask = (mask >> (column_address_bits + row_address_bits)) & (numofBanks-1);  
-          int rankmask = (mask >> int(column_address_bits + row_address_bits + log2(numofBanks))) & (1); // 1 for 1 rank
-          int colmask = (mask & ((1 << column_address_bits)-1));
-          int rowmask = (mask >> column_address_bits) & ((1 << (row_address_bits))-1);
+          int bankmask = (mask >> (geometry->column_address_bits + geometry->row_address_bits)) & (geometry->numofBanks-1);  
+          int rankmask = (mask >> int(geometry->column_address_bits + geometry->row_address_bits + log2(geometry->numofBanks))) & (1); // 1 for 1 rank
+          int colmask = (mask & ((1 << geometry->column_address_bits)-1));
+          int rowmask = (mask >> geometry->column_address_bits) & ((1 << (geometry->row_address_bits))-1);
 
-          int bankid = (address >> (column_address_bits + row_address_bits)) & (numofBanks-1);
-          int rankid = (address >> int(column_address_bits + row_address_bits + log2(numofBanks))) & (1); // 1 for 1 rank
-          int colid = (address & ((1 << column_address_bits)-1));
-          int rowid = (address >> column_address_bits) & ((1 << (row_address_bits))-1);
+          int bankid = (address >> (geometry->column_address_bits + geometry->row_address_bits)) & (geometry->numofBanks-1);
+          int rankid = (address >> int(geometry->column_address_bits + geometry->row_address_bits + log2(geometry->numofBanks))) & (1); // 1 for 1 rank
+          int colid = (address & ((1 << geometry->column_address_bits)-1));
+          int rowid = (address >> geometry->column_address_bits) & ((1 << (geometry->row_address_bits))-1);
 
           // Print it in one line
           // mask should be hex, address should be decimal
@@ -713,15 +775,15 @@ void FaultDomain::printVisualFaults(){
       } else{
         ADDR mask = (*it)->getEffectiveMask();
         ADDR address = (*it)->getAddr();
-        int bankmask = (mask >> (column_address_bits + row_address_bits)) & (numofBanks-1);  
-        int rankmask = (mask >> int(column_address_bits + row_address_bits + log2(numofBanks))) & (1); // 1 for 1 rank
-        int colmask = (mask & ((1 << column_address_bits)-1));
-        int rowmask = (mask >> column_address_bits) & ((1 << (row_address_bits))-1);
+        int bankmask = (mask >> (geometry->column_address_bits + geometry->row_address_bits)) & (geometry->numofBanks-1);  
+        int rankmask = (mask >> int(geometry->column_address_bits + geometry->row_address_bits + log2(geometry->numofBanks))) & (1); // 1 for 1 rank
+        int colmask = (mask & ((1 << geometry->column_address_bits)-1));
+        int rowmask = (mask >> geometry->column_address_bits) & ((1 << (geometry->row_address_bits))-1);
 
-        int bankid = (address >> (column_address_bits + row_address_bits)) & (numofBanks-1);
-        int rankid = (address >> int(column_address_bits + row_address_bits + log2(numofBanks))) & (1); // 1 for 1 rank
-        int colid = (address & ((1 << column_address_bits)-1));
-        int rowid = (address >> column_address_bits) & ((1 << (row_address_bits))-1);
+        int bankid = (address >> (geometry->column_address_bits + geometry->row_address_bits)) & (geometry->numofBanks-1);
+        int rankid = (address >> int(geometry->column_address_bits + geometry->row_address_bits + log2(geometry->numofBanks))) & (1); // 1 for 1 rank
+        int colid = (address & ((1 << geometry->column_address_bits)-1));
+        int rowid = (address >> geometry->column_address_bits) & ((1 << (geometry->row_address_bits))-1);
 
         // Print it in one line
         // mask should be hex, address should be decimal
@@ -778,66 +840,18 @@ ADDR FaultDomain::OverlappedAddr(void){
   return result;
 }
 
-void FaultDomain::setFaultStats(ErrorType type,int year){
-  float *arrays;
+void FaultDomain::getFaultShares(double *shares){
   int tmparrs[ERRORENUM]={0,};
-  float count = 0;
-  if (type == SDC){
-    arrays = this->SDCstats[year];
-  }else if(type==DUE){
-    arrays = this->DUEstats[year];
-  }else{
-    assert(0);
-  }
-
+  int count = 0;
   if (activeFaultList.size() > 0) {
     for (auto it = activeFaultList.begin();
           it != activeFaultList.end(); it++) {
-      std::string name = (*it)->getName();
-      // if name is the same as the fault name, then it is a permanent fault
-      if (name == "Sword"){
-        tmparrs[SWORDENUM] += 1;
-      } else if (name =="Sbit"){
-        tmparrs[SBITENUM] += 1;  
-      }else if(name =="Spin"){
-        tmparrs[SBITENUM] += 1;
-      } else if(name =="Scol"){
-        tmparrs[SCOLENUM] += 1;
-      } else if(name =="Lwordline"){
-        tmparrs[LWLNUM] += 1;
-      } else if(name =="Srow"){
-        tmparrs[SROWENUM] += 1;
-      } else if(name =="Sbank"){
-        tmparrs[SBANKENUM] += 1;
-      } else if(name =="Mbank"){
-        tmparrs[MBANKENUM] += 1;
-      } else if(name =="Mrank"){
-        tmparrs[MRANKENUM] += 1;
-      } else if(name =="Channel"){
-        tmparrs[CHANNELENUM] += 1;
-      } else if(name =="BLSA"){
-        tmparrs[BLSA] += 1;
-      } else if(name =="Bank_pattern"){
-        tmparrs[BANKPATTERN] += 1;
-      } else if(name =="CDEC"){
-        tmparrs[CDEC] += 1;
-      } else if(name =="CSL"){
-        tmparrs[CSL] += 1;
-      } else if(name =="Multi_module"){
-        tmparrs[MMODULE] += 1;
-      } else if(name =="RDEC"){
-        tmparrs[RDEC] += 1;
-      } else if(name =="SWD"){
-        tmparrs[SWD] += 1;
-      } else if(name =="Dist_bit"){
-        tmparrs[DISTBIT] += 1;
-      } else if(name =="MWL"){
-        tmparrs[MWL] += 1;
-      }else {
-        printf("Error: %s\n",name.c_str());
+      int typeIdx = (*it)->getTypeIdx();
+      if (typeIdx >= INHERENTENUM1) {
+        printf("Error: %s\n",(*it)->getName().c_str());
         assert(0);
       }
-
+      tmparrs[typeIdx] += 1;
     }
   }
   if(inherentFault && inherentFault->getNumInherents() > 0){
@@ -849,9 +863,24 @@ void FaultDomain::setFaultStats(ErrorType type,int year){
     }
   }
   for(int j=0;j<ERRORENUM;j++){
-    if (tmparrs[j] >0){
-      arrays[j] += 1/count;
-    }
+    shares[j] = (tmparrs[j] > 0) ? 1. / count : 0.;
+  }
+}
+
+void FaultDomain::setFaultStats(ErrorType type,int year){
+  float *arrays;
+  if (type == SDC){
+    arrays = this->SDCstats[year];
+  }else if(type==DUE){
+    arrays = this->DUEstats[year];
+  }else{
+    assert(0);
+  }
+
+  double shares[ERRORENUM];
+  getFaultShares(shares);
+  for(int j=0;j<ERRORENUM;j++){
+    arrays[j] += shares[j];
   }
 }
 
@@ -879,10 +908,10 @@ float** FaultDomain::getFaultStatsALL(ErrorType type){
   return arrays;
 } 
 
-FaultDomainDDR::FaultDomainDDR(int ranksPerDomain, int devicesPerRank, int pinsPerDevice,
+FaultDomainDDR::FaultDomainDDR(const DramGeometry *geometry, int ranksPerDomain, int devicesPerRank, int pinsPerDevice,
                  int blkHeight)
-      : FaultDomain(ranksPerDomain, devicesPerRank, pinsPerDevice, blkHeight,
-                    new DefaultFaultRateInfo(false,true)) {
+      : FaultDomain(geometry, ranksPerDomain, devicesPerRank, pinsPerDevice, blkHeight,
+                    new DefaultFaultRateInfo(geometry, false,true)) {
                       SDCstats = new float*[MAX_YEAR];
                       DUEstats = new float*[MAX_YEAR];
                       for (int year =0;year<MAX_YEAR;year++){
@@ -894,10 +923,10 @@ FaultDomainDDR::FaultDomainDDR(int ranksPerDomain, int devicesPerRank, int pinsP
                         }
                       }
                     }
-FaultDomainDDR::FaultDomainDDR(int ranksPerDomain, int devicesPerRank, int pinsPerDevice,
+FaultDomainDDR::FaultDomainDDR(const DramGeometry *geometry, int ranksPerDomain, int devicesPerRank, int pinsPerDevice,
                  int blkHeight, MSGConfig message_config)
-      : FaultDomain(ranksPerDomain, devicesPerRank, pinsPerDevice, blkHeight,
-                    new DefaultFaultRateInfo(false,true), message_config) {
+      : FaultDomain(geometry, ranksPerDomain, devicesPerRank, pinsPerDevice, blkHeight,
+                    new DefaultFaultRateInfo(geometry, false,true), message_config) {
                       SDCstats = new float*[MAX_YEAR];
                       DUEstats = new float*[MAX_YEAR];
                       for (int year =0;year<MAX_YEAR;year++){
@@ -909,10 +938,10 @@ FaultDomainDDR::FaultDomainDDR(int ranksPerDomain, int devicesPerRank, int pinsP
                         }
                       }
                     }
-FaultDomainDDR::FaultDomainDDR(int ranksPerDomain, int devicesPerRank, int pinsPerDevice,
+FaultDomainDDR::FaultDomainDDR(const DramGeometry *geometry, int ranksPerDomain, int devicesPerRank, int pinsPerDevice,
                  int blkHeight, MSGConfig message_config,bool HBM=false)
-      : FaultDomain(ranksPerDomain, devicesPerRank, pinsPerDevice, blkHeight,
-                    new DefaultFaultRateInfo(HBM,true), message_config) {
+      : FaultDomain(geometry, ranksPerDomain, devicesPerRank, pinsPerDevice, blkHeight,
+                    new DefaultFaultRateInfo(geometry, HBM,true), message_config) {
                       SDCstats = new float*[MAX_YEAR];
                       DUEstats = new float*[MAX_YEAR];
                       for (int year =0;year<MAX_YEAR;year++){
@@ -925,10 +954,10 @@ FaultDomainDDR::FaultDomainDDR(int ranksPerDomain, int devicesPerRank, int pinsP
                       }
                     }
 
-FaultDomainDDR::FaultDomainDDR(int ranksPerDomain, int devicesPerRank, int pinsPerDevice,
+FaultDomainDDR::FaultDomainDDR(const DramGeometry *geometry, int ranksPerDomain, int devicesPerRank, int pinsPerDevice,
                  int blkHeight, MSGConfig message_config,bool HBM=false, bool detailed = true)
-      : FaultDomain(ranksPerDomain, devicesPerRank, pinsPerDevice, blkHeight,
-                    new DefaultFaultRateInfo(HBM,detailed), message_config) {
+      : FaultDomain(geometry, ranksPerDomain, devicesPerRank, pinsPerDevice, blkHeight,
+                    new DefaultFaultRateInfo(geometry, HBM,detailed), message_config) {
                       SDCstats = new float*[MAX_YEAR];
                       DUEstats = new float*[MAX_YEAR];
                       for (int year =0;year<MAX_YEAR;year++){
@@ -941,7 +970,7 @@ FaultDomainDDR::FaultDomainDDR(int ranksPerDomain, int devicesPerRank, int pinsP
                       }
                     }
 FaultDomainDDR::~FaultDomainDDR() {
-  delete faultRateInfo;
+  // faultRateInfo is released by ~FaultDomain
   for(int i=0;i<MAX_YEAR;i++){
     delete [] SDCstats[i];
     delete [] DUEstats[i];
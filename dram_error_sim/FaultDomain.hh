@@ -48,12 +48,39 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #include <list>
 #include <vector>
+#include "FaultCorpus.hh"
 #include "FaultRateInfo.hh"
 #include "util.hh"
 #include "message.hh"
 
 class ECC;
 class Fault;
+class FaultDomain;
+class Scrubber;
+
+/** @class FaultDomainState
+ * \brief Copy of the per-run state of a FaultDomain
+ * @details Used to restart a run from the same state several times (see
+ * TesterSystem splitting). Owns copies of the operational faults.
+ */
+struct FaultDomainState {
+  FaultDomainState() {}
+  ~FaultDomainState();
+  FaultDomainState(const FaultDomainState &) = delete;
+  FaultDomainState &operator=(const FaultDomainState &) = delete;
+
+  std::vector<Fault *> faults;  //!< copies of operationalFaultList
+  std::vector<int> activeIdx;   //!< activeFaultList as indices into faults
+  unsigned long long retiredBlkCount;
+  std::list<int> retiredPinIDList;
+  std::list<int> retiredChipIDList;
+  double inherentOverlapSum;
+  int inherentOverlapCnt;
+  double transientDeadline;
+  bool hasInherent;
+  double inherentRate;
+  InherentErrorPattern errorPattern;
+};
 
 
 /**@addtogroup Fault_Management
@@ -77,15 +104,17 @@ class Fault;
 class FaultDomain {
  public:
   //! Constructor
-  /*\param _rankPerDomain Number of ranks in each fault domain
+  /*\param _geometry DRAM geometry of the chips (owned by the DomainGroup)
+          \param _rankPerDomain Number of ranks in each fault domain
           \param _devicesPerRank Number of chips in a rank
           \param _pinsPerDevices Number of data I/O pins (channel width)
           \param _blkHeight Burst length
           \param _faultRateInfo FaultRateInfo pointer
            */
-  FaultDomain(int _ranksPerDomain, int _devicesPerRank, int _pinsPerDevice,
+  FaultDomain(const DramGeometry *_geometry, int _ranksPerDomain, int _devicesPerRank, int _pinsPerDevice,
               int _blkHeight, FaultRateInfo *_faultRateInfo)
-      : ranksPerDomain(_ranksPerDomain),
+      : geometry(_geometry),
+        ranksPerDomain(_ranksPerDomain),
         devicesPerRank(_devicesPerRank),
         pinsPerDevice(_pinsPerDevice),
         blkHeight(_blkHeight),
@@ -97,10 +126,11 @@ class FaultDomain {
     
   }
 
-  FaultDomain(int _ranksPerDomain, int _devicesPerRank, int _pinsPerDevice,
+  FaultDomain(const DramGeometry *_geometry, int _ranksPerDomain, int _devicesPerRank, int _pinsPerDevice,
               int _blkHeight, FaultRateInfo *_faultRateInfo, int _msg_height_base,
               int _DRAM_BaseBL, int _DRAM_extraBeat, int _msg_extraheight, int _DRAM_overfetch_mult)
-      : ranksPerDomain(_ranksPerDomain),
+      : geometry(_geometry),
+        ranksPerDomain(_ranksPerDomain),
         devicesPerRank(_devicesPerRank),
         pinsPerDevice(_pinsPerDevice),
         blkHeight(_blkHeight),
@@ -113,9 +143,10 @@ class FaultDomain {
   }
 
 
-  FaultDomain(int _ranksPerDomain, int _devicesPerRank, int _pinsPerDevice,
+  FaultDomain(const DramGeometry *_geometry, int _ranksPerDomain, int _devicesPerRank, int _pinsPerDevice,
               int _blkHeight, FaultRateInfo *_faultRateInfo, MSGConfig _message_config)
-      : ranksPerDomain(_ranksPerDomain),
+      : geometry(_geometry),
+        ranksPerDomain(_ranksPerDomain),
         devicesPerRank(_devicesPerRank),
         pinsPerDevice(_pinsPerDevice),
         blkHeight(_blkHeight),
@@ -132,6 +163,7 @@ class FaultDomain {
     if (inherentFault != NULL) {
       delete inherentFault;
     }
+    delete scenarioLine;
     delete faultRateInfo;
   }
   
@@ -141,12 +173,17 @@ class FaultDomain {
 
  public:
   int getChannelWidth() { return devicesPerRank * pinsPerDevice; }
+  const DramGeometry *getGeometry() const { return geometry; }
   int getChipWidth() { return pinsPerDevice; }
   int getChipCount() { return devicesPerRank; }
   int getBeatHeight() { return blkHeight; }
   double getFaultRate() {
     return ranksPerDomain * devicesPerRank * faultRateInfo->getTotalRate();
   }
+  //! fault rate sampled under importance sampling
+  double getBiasedFaultRate() {
+    return ranksPerDomain * devicesPerRank * faultRateInfo->getBiasedRate();
+  }
 
   void resetInherentFault(Fault *fault, ECC *ecc);  //!< reset inherent fault
   //! rate (at the beginning of
@@ -160,34 +197,50 @@ class FaultDomain {
   size_t getRetiredPinCount() { return retiredPinIDList.size(); }
   //! Fault generation and Test based on scenario
   /*! \param ecc ECC pointer
-           \param faultCount Number of faults
+           \param faultCount Number of faults (at most the chip count when
+     chipOverlapCheck is set)
            \param faults Pointer to string array where fault types are stored
-           \param chipOverlapCheck Overlap check parameter
+           \param chipOverlapCheck place every fault on a distinct chip
    */
   ErrorType genScenarioRandomFaultAndTest(
       ECC *ecc, int faultCount, std::string *faults,
       bool chipOverlapCheck = true);  // For fault generation based on scenario
   //! Fault generation and Test for a system
-  /*! \param ecc ECC pointer */
+  /*! \param ecc ECC pointer
+      \param record if set, the draws are seeded from record->seed and the
+     fault type and overlap draw are taken from it (replay) or stored in it
+     together with the drawn fault (recording)
+      \param replay whether record is replayed */
   ErrorType genSystemRandomFaultAndTest(
-      ECC *ecc);  // For fault generation based on fault rates
+      ECC *ecc, FaultRecord *record = NULL,
+      bool replay = false);  // For fault generation based on fault rates
 
   void retirePin(int pinID);
   void retireChip(int chipID);
 
   void scrub();
+  //! drop transient faults whose scrub deadline passed by "hr"
+  void expireTransients(double hr) {
+    if (transientDeadline <= hr) expireTransientsInternal(hr);
+  }
+  void setScrubber(Scrubber *scrubber) { _scrubber = scrubber; }
 
   void clear();
+  //! copy the per-run state (faults, retirement, inherent rate) to "state"
+  void saveState(FaultDomainState *state) const;
+  //! return to a state saved by saveState()
+  void restoreState(const FaultDomainState &state);
   void print(FILE *fd = stdout) const;
 
   // GONG
   bool permFaults();          //!< a function checking if permanent faults exist
   void setSingleChipFault();  //!< set single chip fault (in advance)
-  void InitInherentFaultRate() { faultRateInfo->iRate->setIFRate(); };
+  void InitInherentFaultRate() { faultRateInfo->initInherentRate(); };
   bool overlapTest();  //!< Checking if overlap exists
   bool getBadCount(ECC *ecc);
 
  public:
+  const DramGeometry *geometry;  //!< DRAM type, organization and masks
   int ranksPerDomain;  //!< number of ranks involved in this fault domain
   int devicesPerRank;  //!< number of chips in each rank
   int pinsPerDevice;   //!< number of pins (bit-width of each chip
@@ -212,21 +265,41 @@ class FaultDomain {
   // GONG
   void FaultyChipDetect(std::list<int> *chip_list);  //!< find faulty chip (for
                                                      //! a faster simulation)
+  //! set the inherent rate from the running overlap sum (O(1))
   void updateInherentFault(ECC *ecc);
+  //! account a new operational fault in the running overlap sum
+  void addInherentOverlap(Fault *fault);
+  //! rebuild the running overlap sum after faults were removed
+  void recalcInherentOverlap();
   void printFaultRate() { printf("getFaultRate(): %.10e\n", getFaultRate()); };
   void setTester(class TesterSystem *tester, class ECC *ecc);
   void printOperationalFaults();
   void printTransientFaults();
   void printVisualFaults();
   void printActiveFaults();
+  //! split of a DUE/SDC of this domain over the fault types involved in it
+  void getFaultShares(double *shares);
   void setFaultStats(ErrorType type,int year);
   ADDR OverlappedAddr(void);
   float* getFaultStats(ErrorType type,int year);
   float** getFaultStatsALL(ErrorType type);
   bool HBM_setup;
+  int groupIdx = 0;  //!< index of this domain in its DomainGroup
+  bool touched = false;  //!< picked by its DomainGroup during the current run
+  //! sum of overlap_prob() over permanent operational faults overlapping weak
+  //! cells, and their count; the inherent rate is proportional to the sum
+  double inherentOverlapSum = .0;
+  int inherentOverlapCnt = 0;
 
  protected:
+  void expireTransientsInternal(double hr);
   class TesterSystem *_tester;
+  Scrubber *_scrubber = NULL;
+  //! earliest scrub deadline among transient faults (INFINITY if none)
+  double transientDeadline = INFINITY;
+  //! scratch of genScenarioRandomFaultAndTest(), reused across trials
+  CacheLine *scenarioLine = NULL;
+  std::vector<int> scenarioChips;
   float **SDCstats;
   float **DUEstats;
 };
@@ -238,13 +311,13 @@ class FaultDomain {
  */
 class FaultDomainDDR : public FaultDomain {
  public:
-  FaultDomainDDR(int ranksPerDomain, int devicesPerRank, int pinsPerDevice,
+  FaultDomainDDR(const DramGeometry *geometry, int ranksPerDomain, int devicesPerRank, int pinsPerDevice,
                  int blkHeight);
-  FaultDomainDDR(int ranksPerDomain, int devicesPerRank, int pinsPerDevice,
+  FaultDomainDDR(const DramGeometry *geometry, int ranksPerDomain, int devicesPerRank, int pinsPerDevice,
                  int blkHeight, MSGConfig message_config);
-  FaultDomainDDR(int ranksPerDomain, int devicesPerRank, int pinsPerDevice,
+  FaultDomainDDR(const DramGeometry *geometry, int ranksPerDomain, int devicesPerRank, int pinsPerDevice,
                  int blkHeight, MSGConfig message_config,bool HBM);
-  FaultDomainDDR(int ranksPerDomain, int devicesPerRank, int pinsPerDevice,
+  FaultDomainDDR(const DramGeometry *geometry, int ranksPerDomain, int devicesPerRank, int pinsPerDevice,
                  int blkHeight, MSGConfig message_config,bool HBM,bool detailed);
   ~FaultDomainDDR();
 };
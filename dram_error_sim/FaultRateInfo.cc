@@ -44,33 +44,37 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <tuple>
+#include <algorithm>
+#include <mutex>
 // global variable, defined in main.cc
 extern int module;
 bool ignore_external_faults = false;
 
 
 
-double getMultiplier(const std::string &faultName)
+// per-chip count of the components a fault type of input_FIT.conf scales with
+double getMultiplier(const DramGeometry &g, const std::string &faultName)
 {
   std::map<std::string, double> multiplierMap = {
-    {"bank_control_bank_8diff", numofBanks},
-    {"decoder_multi_col", CDEC_per_chip},
-    {"decoder_single_col", CDEC_per_chip},
-    {"local_wordline", WLD_per_chip},
-    {"local_wordline_two_clusters", WLD_per_chip},
-    {"lwl_sel", RDEC_per_chip},
-    {"lwl_sel2", RDEC_per_chip},
-    {"multiple_single_bit_failures_", BITS_per_chip},
-    {"mutli_csls_", numofBanks},
-    {"not_clustered_single_bank", numofBanks},
-    {"not_clustered_single_column", BLSA_per_chip},
-    {"row_decoder", RDEC_per_chip},
-    {"single_csl_", CSL_per_chip},
-    {"single_sense_amp", BLSA_per_chip},
-    {"subarray_row_decoder", RDEC_SUBBANK_per_chip},
-    {"potential_sense_amp", BLSA_per_chip},
-    {"potential_csl_column", CSL_per_chip},
-    {"consequtive_rows", WLD_per_chip}};
+    {"bank_control_bank_8diff", g.numofBanks},
+    {"decoder_multi_col", g.CDEC_per_chip},
+    {"decoder_single_col", g.CDEC_per_chip},
+    {"local_wordline", g.WLD_per_chip},
+    {"local_wordline_two_clusters", g.WLD_per_chip},
+    {"lwl_sel", g.RDEC_per_chip},
+    {"lwl_sel2", g.RDEC_per_chip},
+    {"multiple_single_bit_failures_", g.BITS_per_chip},
+    {"mutli_csls_", g.numofBanks},
+    {"not_clustered_single_bank", g.numofBanks},
+    {"not_clustered_single_column", g.BLSA_per_chip},
+    {"row_decoder", g.RDEC_per_chip},
+    {"single_csl_", g.CSL_per_chip},
+    {"single_sense_amp", g.BLSA_per_chip},
+    {"subarray_row_decoder", g.RDEC_SUBBANK_per_chip},
+    {"potential_sense_amp", g.BLSA_per_chip},
+    {"potential_csl_column", g.CSL_per_chip},
+    {"consequtive_rows", g.WLD_per_chip}};
     
   for (const auto &[key, val] : multiplierMap)
   {
@@ -82,269 +86,269 @@ double getMultiplier(const std::string &faultName)
   return 1.0; // default
 }
 
-DefaultFaultRateInfo::DefaultFaultRateInfo(bool HBMSETUP, bool detailed_errormap) : FaultRateInfo()
+DefaultFaultRateCatalog::DefaultFaultRateCatalog(const DramGeometry &g, bool HBMSETUP, bool detailed_errormap) : FaultRateCatalog()
 {
   this->setDetailedError(detailed_errormap);
 
   if (module == 0)
   {
-    addFaultRate("bank_control_bank_8diff-p", 5.082E-04 * numofBanks FIT);
-    addFaultRate("bank_control_bank_8diff-t", 0.000E+00 * numofBanks FIT);
-    addFaultRate("decoder_multi_col-p", 5.082E-04 * CDEC_per_chip FIT);
-    addFaultRate("decoder_multi_col-t", 4.523E-02 * CDEC_per_chip FIT);
-    addFaultRate("decoder_single_col-p", 0.000E+00 * CDEC_per_chip FIT);
-    addFaultRate("decoder_single_col-t", 1.779E-02 * CDEC_per_chip FIT);
-    addFaultRate("local_wordline-p", 1.417E-03 * WLD_per_chip FIT);
-    addFaultRate("local_wordline-t", 1.668E-04 * WLD_per_chip FIT);
-    addFaultRate("local_wordline_two_clusters-p", 7.147E-05 * WLD_per_chip FIT);
-    addFaultRate("local_wordline_two_clusters-t", 1.147E-05 * WLD_per_chip FIT);
-    addFaultRate("lwl_sel-p", 5.082E-04 * RDEC_per_chip FIT);
-    addFaultRate("lwl_sel-t", 1.016E-03 * RDEC_per_chip FIT);
+    addFaultRate("bank_control_bank_8diff-p", 5.082E-04 * g.numofBanks FIT);
+    addFaultRate("bank_control_bank_8diff-t", 0.000E+00 * g.numofBanks FIT);
+    addFaultRate("decoder_multi_col-p", 5.082E-04 * g.CDEC_per_chip FIT);
+    addFaultRate("decoder_multi_col-t", 4.523E-02 * g.CDEC_per_chip FIT);
+    addFaultRate("decoder_single_col-p", 0.000E+00 * g.CDEC_per_chip FIT);
+    addFaultRate("decoder_single_col-t", 1.779E-02 * g.CDEC_per_chip FIT);
+    addFaultRate("local_wordline-p", 1.417E-03 * g.WLD_per_chip FIT);
+    addFaultRate("local_wordline-t", 1.668E-04 * g.WLD_per_chip FIT);
+    addFaultRate("local_wordline_two_clusters-p", 7.147E-05 * g.WLD_per_chip FIT);
+    addFaultRate("local_wordline_two_clusters-t", 1.147E-05 * g.WLD_per_chip FIT);
+    addFaultRate("lwl_sel-p", 5.082E-04 * g.RDEC_per_chip FIT);
+    addFaultRate("lwl_sel-t", 1.016E-03 * g.RDEC_per_chip FIT);
     addFaultRate("lwl_sel_column_related-p", 0.000E+00 * 1 FIT);
     addFaultRate("lwl_sel_column_related-t", 0.000E+00 * 1 FIT);
     addFaultRate("lwl_sel_random_bit-p", 0.000E+00 * 1 FIT);
     addFaultRate("lwl_sel_random_bit-t", 0.000E+00 * 1 FIT);
-    addFaultRate("lwl_sel2-p", 5.082E-04 * RDEC_per_chip FIT);
-    addFaultRate("lwl_sel2-t", 0.000E+00 * RDEC_per_chip FIT);
+    addFaultRate("lwl_sel2-p", 5.082E-04 * g.RDEC_per_chip FIT);
+    addFaultRate("lwl_sel2-t", 0.000E+00 * g.RDEC_per_chip FIT);
     addFaultRate("lwl_sel2_potential_col-p", 0.000E+00 * 1 FIT);
     addFaultRate("lwl_sel2_potential_col-t", 0.000E+00 * 1 FIT);
-    addFaultRate("multiple_single_bit_failures_-p", 9.378E+01 * BITS_per_chip FIT);
-    addFaultRate("multiple_single_bit_failures_-t", 5.356E+01 * BITS_per_chip FIT);
-    addFaultRate("mutli_csls_column_and_bank-p", 8.132E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_column_and_bank-t", 6.099E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_random_bank_row-p", 2.541E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_random_bank_row-t", 3.558E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_random_bits-p", 7.115E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_random_bits-t", 5.082E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_row_and_bits-p", 4.574E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_row_and_bits-t", 1.016E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_row_related-p", 3.558E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_row_related-t", 4.066E-03 * numofBanks FIT);
+    addFaultRate("multiple_single_bit_failures_-p", 9.378E+01 * g.BITS_per_chip FIT);
+    addFaultRate("multiple_single_bit_failures_-t", 5.356E+01 * g.BITS_per_chip FIT);
+    addFaultRate("mutli_csls_column_and_bank-p", 8.132E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_column_and_bank-t", 6.099E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_random_bank_row-p", 2.541E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_random_bank_row-t", 3.558E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_random_bits-p", 7.115E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_random_bits-t", 5.082E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_row_and_bits-p", 4.574E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_row_and_bits-t", 1.016E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_row_related-p", 3.558E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_row_related-t", 4.066E-03 * g.numofBanks FIT);
     addFaultRate("not_clustered_multi_bank-p", 2.765E-01 * 1 FIT);
     addFaultRate("not_clustered_multi_bank-t", 2.277E-01 * 1 FIT);
     // addFaultRate("not_clustered_multi_bank_two_independent-p",7.481E-01*1 FIT);	addFaultRate("not_clustered_multi_bank_two_independent-t",2.440E-02*1 FIT);
-    addFaultRate("not_clustered_single_bank-p", 1.016E-02 * numofBanks FIT);
-    addFaultRate("not_clustered_single_bank-t", 6.607E-03 * numofBanks FIT);
-    addFaultRate("not_clustered_single_column-p", 5.816E-09 * BLSA_per_chip FIT);
-    addFaultRate("not_clustered_single_column-t", 0.000E+00 * BLSA_per_chip FIT);
-    addFaultRate("row_decoder-p", 1.220E-02 * RDEC_per_chip FIT);
-    addFaultRate("row_decoder-t", 1.372E-02 * RDEC_per_chip FIT);
-    addFaultRate("single_csl_bank-p", 1.842E-03 * CSL_per_chip FIT);
-    addFaultRate("single_csl_bank-t", 6.353E-04 * CSL_per_chip FIT);
-    addFaultRate("single_csl_column-p", 6.353E-04 * CSL_per_chip FIT);
-    addFaultRate("single_csl_column-t", 1.906E-04 * CSL_per_chip FIT);
-    addFaultRate("single_sense_amp-p", 3.141E-07 * BLSA_per_chip FIT);
-    addFaultRate("single_sense_amp-t", 6.786E-08 * BLSA_per_chip FIT);
-    addFaultRate("subarray_row_decoder-p", 6.658E-02 * RDEC_SUBBANK_per_chip FIT);
-    addFaultRate("subarray_row_decoder-t", 1.321E-02 * RDEC_SUBBANK_per_chip FIT);
-    addFaultRate("subarray_row_decoder_two_clusters-p", 2.846E-02 * RDEC_SUBBANK_per_chip FIT);
-    addFaultRate("subarray_row_decoder_two_clusters-t", 1.016E-02 * RDEC_SUBBANK_per_chip FIT);
+    addFaultRate("not_clustered_single_bank-p", 1.016E-02 * g.numofBanks FIT);
+    addFaultRate("not_clustered_single_bank-t", 6.607E-03 * g.numofBanks FIT);
+    addFaultRate("not_clustered_single_column-p", 5.816E-09 * g.BLSA_per_chip FIT);
+    addFaultRate("not_clustered_single_column-t", 0.000E+00 * g.BLSA_per_chip FIT);
+    addFaultRate("row_decoder-p", 1.220E-02 * g.RDEC_per_chip FIT);
+    addFaultRate("row_decoder-t", 1.372E-02 * g.RDEC_per_chip FIT);
+    addFaultRate("single_csl_bank-p", 1.842E-03 * g.CSL_per_chip FIT);
+    addFaultRate("single_csl_bank-t", 6.353E-04 * g.CSL_per_chip FIT);
+    addFaultRate("single_csl_column-p", 6.353E-04 * g.CSL_per_chip FIT);
+    addFaultRate("single_csl_column-t", 1.906E-04 * g.CSL_per_chip FIT);
+    addFaultRate("single_sense_amp-p", 3.141E-07 * g.BLSA_per_chip FIT);
+    addFaultRate("single_sense_amp-t", 6.786E-08 * g.BLSA_per_chip FIT);
+    addFaultRate("subarray_row_decoder-p", 6.658E-02 * g.RDEC_SUBBANK_per_chip FIT);
+    addFaultRate("subarray_row_decoder-t", 1.321E-02 * g.RDEC_SUBBANK_per_chip FIT);
+    addFaultRate("subarray_row_decoder_two_clusters-p", 2.846E-02 * g.RDEC_SUBBANK_per_chip FIT);
+    addFaultRate("subarray_row_decoder_two_clusters-t", 1.016E-02 * g.RDEC_SUBBANK_per_chip FIT);
     // addFaultRate("two_row_overlap-p",2.277E-01*1 FIT);	addFaultRate("two_row_overlap-t",2.440E-02*1 FIT);
-    addFaultRate("potential_sense_amp-p", 5.816E-08 * BLSA_per_chip FIT);
-    addFaultRate("potential_sense_amp-t", 0.000E+00 * BLSA_per_chip FIT);
+    addFaultRate("potential_sense_amp-p", 5.816E-08 * g.BLSA_per_chip FIT);
+    addFaultRate("potential_sense_amp-t", 0.000E+00 * g.BLSA_per_chip FIT);
     addFaultRate("bank_control-p", 0.000E+00 * 1 FIT);
     addFaultRate("bank_control-t", 0.000E+00 * 1 FIT);
-    addFaultRate("potential_csl_column-p", 0.000E+00 * CSL_per_chip FIT);
-    addFaultRate("potential_csl_column-t", 0.000E+00 * CSL_per_chip FIT);
+    addFaultRate("potential_csl_column-p", 0.000E+00 * g.CSL_per_chip FIT);
+    addFaultRate("potential_csl_column-t", 0.000E+00 * g.CSL_per_chip FIT);
     addFaultRate("mutli_csls-p", 3.253E-02 * 1 FIT);
     addFaultRate("mutli_csls-t", 0.000E+00 * 1 FIT);
-    addFaultRate("consequtive_rows-p", 8.029E-05 * WLD_per_chip FIT);
-    addFaultRate("consequtive_rows-t", 0.000E+00 * WLD_per_chip FIT);
+    addFaultRate("consequtive_rows-p", 8.029E-05 * g.WLD_per_chip FIT);
+    addFaultRate("consequtive_rows-t", 0.000E+00 * g.WLD_per_chip FIT);
   }
   else if (module == 1)
   {
-    addFaultRate("bank_control_bank_8diff-p", 1.271E-02 * numofBanks FIT);
-    addFaultRate("bank_control_bank_8diff-t", 0.000E+00 * numofBanks FIT);
-    addFaultRate("decoder_multi_col-p", 0.000E+00 * CDEC_per_chip FIT);
-    addFaultRate("decoder_multi_col-t", 9.656E-03 * CDEC_per_chip FIT);
-    addFaultRate("decoder_single_col-p", 5.082E-04 * CDEC_per_chip FIT);
-    addFaultRate("decoder_single_col-t", 1.448E-01 * CDEC_per_chip FIT);
-    addFaultRate("local_wordline-p", 9.088E-05 * WLD_per_chip FIT);
-    addFaultRate("local_wordline-t", 3.882E-05 * WLD_per_chip FIT);
-    addFaultRate("local_wordline_two_clusters-p", 8.823E-07 * WLD_per_chip FIT);
-    addFaultRate("local_wordline_two_clusters-t", 2.647E-06 * WLD_per_chip FIT);
-    addFaultRate("lwl_sel-p", 3.303E-02 * RDEC_per_chip FIT);
-    addFaultRate("lwl_sel-t", 1.530E-01 * RDEC_per_chip FIT);
+    addFaultRate("bank_control_bank_8diff-p", 1.271E-02 * g.numofBanks FIT);
+    addFaultRate("bank_control_bank_8diff-t", 0.000E+00 * g.numofBanks FIT);
+    addFaultRate("decoder_multi_col-p", 0.000E+00 * g.CDEC_per_chip FIT);
+    addFaultRate("decoder_multi_col-t", 9.656E-03 * g.CDEC_per_chip FIT);
+    addFaultRate("decoder_single_col-p", 5.082E-04 * g.CDEC_per_chip FIT);
+    addFaultRate("decoder_single_col-t", 1.448E-01 * g.CDEC_per_chip FIT);
+    addFaultRate("local_wordline-p", 9.088E-05 * g.WLD_per_chip FIT);
+    addFaultRate("local_wordline-t", 3.882E-05 * g.WLD_per_chip FIT);
+    addFaultRate("local_wordline_two_clusters-p", 8.823E-07 * g.WLD_per_chip FIT);
+    addFaultRate("local_wordline_two_clusters-t", 2.647E-06 * g.WLD_per_chip FIT);
+    addFaultRate("lwl_sel-p", 3.303E-02 * g.RDEC_per_chip FIT);
+    addFaultRate("lwl_sel-t", 1.530E-01 * g.RDEC_per_chip FIT);
     addFaultRate("lwl_sel_column_related-p", 0.000E+00 * 1 FIT);
     addFaultRate("lwl_sel_column_related-t", 0.000E+00 * 1 FIT);
     addFaultRate("lwl_sel_random_bit-p", 0.000E+00 * 1 FIT);
     addFaultRate("lwl_sel_random_bit-t", 0.000E+00 * 1 FIT);
-    addFaultRate("lwl_sel2-p", 1.525E-03 * RDEC_per_chip FIT);
-    addFaultRate("lwl_sel2-t", 7.623E-03 * RDEC_per_chip FIT);
+    addFaultRate("lwl_sel2-p", 1.525E-03 * g.RDEC_per_chip FIT);
+    addFaultRate("lwl_sel2-t", 7.623E-03 * g.RDEC_per_chip FIT);
     addFaultRate("lwl_sel2_potential_col-p", 0.000E+00 * 1 FIT);
     addFaultRate("lwl_sel2_potential_col-t", 0.000E+00 * 1 FIT);
-    addFaultRate("multiple_single_bit_failures_-p", 1.271E+01 * BITS_per_chip FIT);
-    addFaultRate("multiple_single_bit_failures_-t", 9.913E+00 * BITS_per_chip FIT);
-    addFaultRate("mutli_csls_column_and_bank-p", 9.656E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_column_and_bank-t", 6.099E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_random_bank_row-p", 5.082E-04 * numofBanks FIT);
-    addFaultRate("mutli_csls_random_bank_row-t", 5.082E-04 * numofBanks FIT);
-    addFaultRate("mutli_csls_random_bits-p", 4.066E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_random_bits-t", 3.558E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_row_and_bits-p", 1.016E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_row_and_bits-t", 5.082E-04 * numofBanks FIT);
-    addFaultRate("mutli_csls_row_related-p", 5.082E-04 * numofBanks FIT);
-    addFaultRate("mutli_csls_row_related-t", 2.033E-03 * numofBanks FIT);
+    addFaultRate("multiple_single_bit_failures_-p", 1.271E+01 * g.BITS_per_chip FIT);
+    addFaultRate("multiple_single_bit_failures_-t", 9.913E+00 * g.BITS_per_chip FIT);
+    addFaultRate("mutli_csls_column_and_bank-p", 9.656E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_column_and_bank-t", 6.099E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_random_bank_row-p", 5.082E-04 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_random_bank_row-t", 5.082E-04 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_random_bits-p", 4.066E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_random_bits-t", 3.558E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_row_and_bits-p", 1.016E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_row_and_bits-t", 5.082E-04 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_row_related-p", 5.082E-04 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_row_related-t", 2.033E-03 * g.numofBanks FIT);
     addFaultRate("not_clustered_multi_bank-p", 4.879E-02 * 1 FIT);
     addFaultRate("not_clustered_multi_bank-t", 8.132E-02 * 1 FIT);
     // addFaultRate("not_clustered_multi_bank_two_independent-p",3.334E-01*1 FIT);	addFaultRate("not_clustered_multi_bank_two_independent-t",1.626E-02*1 FIT);
-    addFaultRate("not_clustered_single_bank-p", 1.016E-02 * numofBanks FIT);
-    addFaultRate("not_clustered_single_bank-t", 9.148E-03 * numofBanks FIT);
-    addFaultRate("not_clustered_single_column-p", 0.000E+00 * BLSA_per_chip FIT);
-    addFaultRate("not_clustered_single_column-t", 3.877E-09 * BLSA_per_chip FIT);
-    addFaultRate("row_decoder-p", 1.016E-03 * RDEC_per_chip FIT);
-    addFaultRate("row_decoder-t", 5.082E-03 * RDEC_per_chip FIT);
-    addFaultRate("single_csl_bank-p", 8.259E-04 * CSL_per_chip FIT);
-    addFaultRate("single_csl_bank-t", 2.916E-02 * CSL_per_chip FIT);
-    addFaultRate("single_csl_column-p", 6.353E-05 * CSL_per_chip FIT);
-    addFaultRate("single_csl_column-t", 1.938E-02 * CSL_per_chip FIT);
-    addFaultRate("single_sense_amp-p", 1.512E-07 * BLSA_per_chip FIT);
-    addFaultRate("single_sense_amp-t", 3.017E-06 * BLSA_per_chip FIT);
-    addFaultRate("subarray_row_decoder-p", 7.623E-03 * RDEC_SUBBANK_per_chip FIT);
-    addFaultRate("subarray_row_decoder-t", 1.118E-02 * RDEC_SUBBANK_per_chip FIT);
-    addFaultRate("subarray_row_decoder_two_clusters-p", 3.049E-03 * RDEC_SUBBANK_per_chip FIT);
-    addFaultRate("subarray_row_decoder_two_clusters-t", 6.607E-03 * RDEC_SUBBANK_per_chip FIT);
+    addFaultRate("not_clustered_single_bank-p", 1.016E-02 * g.numofBanks FIT);
+    addFaultRate("not_clustered_single_bank-t", 9.148E-03 * g.numofBanks FIT);
+    addFaultRate("not_clustered_single_column-p", 0.000E+00 * g.BLSA_per_chip FIT);
+    addFaultRate("not_clustered_single_column-t", 3.877E-09 * g.BLSA_per_chip FIT);
+    addFaultRate("row_decoder-p", 1.016E-03 * g.RDEC_per_chip FIT);
+    addFaultRate("row_decoder-t", 5.082E-03 * g.RDEC_per_chip FIT);
+    addFaultRate("single_csl_bank-p", 8.259E-04 * g.CSL_per_chip FIT);
+    addFaultRate("single_csl_bank-t", 2.916E-02 * g.CSL_per_chip FIT);
+    addFaultRate("single_csl_column-p", 6.353E-05 * g.CSL_per_chip FIT);
+    addFaultRate("single_csl_column-t", 1.938E-02 * g.CSL_per_chip FIT);
+    addFaultRate("single_sense_amp-p", 1.512E-07 * g.BLSA_per_chip FIT);
+    addFaultRate("single_sense_amp-t", 3.017E-06 * g.BLSA_per_chip FIT);
+    addFaultRate("subarray_row_decoder-p", 7.623E-03 * g.RDEC_SUBBANK_per_chip FIT);
+    addFaultRate("subarray_row_decoder-t", 1.118E-02 * g.RDEC_SUBBANK_per_chip FIT);
+    addFaultRate("subarray_row_decoder_two_clusters-p", 3.049E-03 * g.RDEC_SUBBANK_per_chip FIT);
+    addFaultRate("subarray_row_decoder_two_clusters-t", 6.607E-03 * g.RDEC_SUBBANK_per_chip FIT);
     // addFaultRate("two_row_overlap-p",0.000E+00*1 FIT);	addFaultRate("two_row_overlap-t",0.000E+00*1 FIT);
-    addFaultRate("potential_sense_amp-p", 5.739E-07 * BLSA_per_chip FIT);
-    addFaultRate("potential_sense_amp-t", 0.000E+00 * BLSA_per_chip FIT);
+    addFaultRate("potential_sense_amp-p", 5.739E-07 * g.BLSA_per_chip FIT);
+    addFaultRate("potential_sense_amp-t", 0.000E+00 * g.BLSA_per_chip FIT);
     addFaultRate("bank_control-p", 1.057E-01 * 1 FIT);
     addFaultRate("bank_control-t", 0.000E+00 * 1 FIT);
-    addFaultRate("potential_csl_column-p", 5.082E-03 * CSL_per_chip FIT);
-    addFaultRate("potential_csl_column-t", 0.000E+00 * CSL_per_chip FIT);
+    addFaultRate("potential_csl_column-p", 5.082E-03 * g.CSL_per_chip FIT);
+    addFaultRate("potential_csl_column-t", 0.000E+00 * g.CSL_per_chip FIT);
     addFaultRate("mutli_csls-p", 0.000E+00 * 1 FIT);
     addFaultRate("mutli_csls-t", 0.000E+00 * 1 FIT);
-    addFaultRate("consequtive_rows-p", 1.059E-05 * WLD_per_chip FIT);
-    addFaultRate("consequtive_rows-t", 0.000E+00 * WLD_per_chip FIT);
+    addFaultRate("consequtive_rows-p", 1.059E-05 * g.WLD_per_chip FIT);
+    addFaultRate("consequtive_rows-t", 0.000E+00 * g.WLD_per_chip FIT);
   }
   else if (module == 2)
   {
-    addFaultRate("bank_control_bank_8diff-p", 2.541E-03 * numofBanks FIT);
-    addFaultRate("bank_control_bank_8diff-t", 0.000E+00 * numofBanks FIT);
-    addFaultRate("decoder_multi_col-p", 4.574E-03 * CDEC_per_chip FIT);
-    addFaultRate("decoder_multi_col-t", 0.000E+00 * CDEC_per_chip FIT);
-    addFaultRate("decoder_single_col-p", 1.016E-03 * CDEC_per_chip FIT);
-    addFaultRate("decoder_single_col-t", 5.082E-04 * CDEC_per_chip FIT);
-    addFaultRate("local_wordline-p", 4.173E-04 * WLD_per_chip FIT);
-    addFaultRate("local_wordline-t", 6.353E-05 * WLD_per_chip FIT);
-    addFaultRate("local_wordline_two_clusters-p", 3.626E-04 * WLD_per_chip FIT);
-    addFaultRate("local_wordline_two_clusters-t", 2.647E-05 * WLD_per_chip FIT);
-    addFaultRate("lwl_sel-p", 1.880E-02 * RDEC_per_chip FIT);
-    addFaultRate("lwl_sel-t", 1.042E-01 * RDEC_per_chip FIT);
+    addFaultRate("bank_control_bank_8diff-p", 2.541E-03 * g.numofBanks FIT);
+    addFaultRate("bank_control_bank_8diff-t", 0.000E+00 * g.numofBanks FIT);
+    addFaultRate("decoder_multi_col-p", 4.574E-03 * g.CDEC_per_chip FIT);
+    addFaultRate("decoder_multi_col-t", 0.000E+00 * g.CDEC_per_chip FIT);
+    addFaultRate("decoder_single_col-p", 1.016E-03 * g.CDEC_per_chip FIT);
+    addFaultRate("decoder_single_col-t", 5.082E-04 * g.CDEC_per_chip FIT);
+    addFaultRate("local_wordline-p", 4.173E-04 * g.WLD_per_chip FIT);
+    addFaultRate("local_wordline-t", 6.353E-05 * g.WLD_per_chip FIT);
+    addFaultRate("local_wordline_two_clusters-p", 3.626E-04 * g.WLD_per_chip FIT);
+    addFaultRate("local_wordline_two_clusters-t", 2.647E-05 * g.WLD_per_chip FIT);
+    addFaultRate("lwl_sel-p", 1.880E-02 * g.RDEC_per_chip FIT);
+    addFaultRate("lwl_sel-t", 1.042E-01 * g.RDEC_per_chip FIT);
     addFaultRate("lwl_sel_column_related-p", 1.626E-02 * 1 FIT);
     addFaultRate("lwl_sel_column_related-t", 8.132E-03 * 1 FIT);
     addFaultRate("lwl_sel_random_bit-p", 8.132E-03 * 1 FIT);
     addFaultRate("lwl_sel_random_bit-t", 0.000E+00 * 1 FIT);
-    addFaultRate("lwl_sel2-p", 2.541E-03 * RDEC_per_chip FIT);
-    addFaultRate("lwl_sel2-t", 4.015E-02 * RDEC_per_chip FIT);
+    addFaultRate("lwl_sel2-p", 2.541E-03 * g.RDEC_per_chip FIT);
+    addFaultRate("lwl_sel2-t", 4.015E-02 * g.RDEC_per_chip FIT);
     addFaultRate("lwl_sel2_potential_col-p", 3.253E-02 * 1 FIT);
     addFaultRate("lwl_sel2_potential_col-t", 0.000E+00 * 1 FIT);
-    addFaultRate("multiple_single_bit_failures_-p", 1.154E+01 * BITS_per_chip FIT);
-    addFaultRate("multiple_single_bit_failures_-t", 1.195E+01 * BITS_per_chip FIT);
-    addFaultRate("mutli_csls_column_and_bank-p", 1.931E-02 * numofBanks FIT);
-    addFaultRate("mutli_csls_column_and_bank-t", 9.656E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_random_bank_row-p", 2.033E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_random_bank_row-t", 4.066E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_random_bits-p", 1.525E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_random_bits-t", 7.623E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_row_and_bits-p", 3.558E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_row_and_bits-t", 2.033E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_row_related-p", 5.591E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_row_related-t", 2.033E-03 * numofBanks FIT);
+    addFaultRate("multiple_single_bit_failures_-p", 1.154E+01 * g.BITS_per_chip FIT);
+    addFaultRate("multiple_single_bit_failures_-t", 1.195E+01 * g.BITS_per_chip FIT);
+    addFaultRate("mutli_csls_column_and_bank-p", 1.931E-02 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_column_and_bank-t", 9.656E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_random_bank_row-p", 2.033E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_random_bank_row-t", 4.066E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_random_bits-p", 1.525E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_random_bits-t", 7.623E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_row_and_bits-p", 3.558E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_row_and_bits-t", 2.033E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_row_related-p", 5.591E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_row_related-t", 2.033E-03 * g.numofBanks FIT);
     addFaultRate("not_clustered_multi_bank-p", 1.464E-01 * 1 FIT);
     addFaultRate("not_clustered_multi_bank-t", 2.358E-01 * 1 FIT);
     // addFaultRate("not_clustered_multi_bank_two_independent-p",6.668E-01*1 FIT);	addFaultRate("not_clustered_multi_bank_two_independent-t",8.945E-02*1 FIT);
-    addFaultRate("not_clustered_single_bank-p", 8.132E-03 * numofBanks FIT);
-    addFaultRate("not_clustered_single_bank-t", 1.372E-02 * numofBanks FIT);
-    addFaultRate("not_clustered_single_column-p", 0.000E+00 * BLSA_per_chip FIT);
-    addFaultRate("not_clustered_single_column-t", 0.000E+00 * BLSA_per_chip FIT);
-    addFaultRate("row_decoder-p", 1.779E-02 * RDEC_per_chip FIT);
-    addFaultRate("row_decoder-t", 1.423E-02 * RDEC_per_chip FIT);
-    addFaultRate("single_csl_bank-p", 1.334E-03 * CSL_per_chip FIT);
-    addFaultRate("single_csl_bank-t", 4.873E-02 * CSL_per_chip FIT);
-    addFaultRate("single_csl_column-p", 9.529E-04 * CSL_per_chip FIT);
-    addFaultRate("single_csl_column-t", 2.109E-02 * CSL_per_chip FIT);
-    addFaultRate("single_sense_amp-p", 1.124E-07 * BLSA_per_chip FIT);
-    addFaultRate("single_sense_amp-t", 5.622E-08 * BLSA_per_chip FIT);
-    addFaultRate("subarray_row_decoder-p", 3.558E-02 * RDEC_SUBBANK_per_chip FIT);
-    addFaultRate("subarray_row_decoder-t", 1.423E-02 * RDEC_SUBBANK_per_chip FIT);
-    addFaultRate("subarray_row_decoder_two_clusters-p", 5.692E-02 * RDEC_SUBBANK_per_chip FIT);
-    addFaultRate("subarray_row_decoder_two_clusters-t", 1.169E-02 * RDEC_SUBBANK_per_chip FIT);
+    addFaultRate("not_clustered_single_bank-p", 8.132E-03 * g.numofBanks FIT);
+    addFaultRate("not_clustered_single_bank-t", 1.372E-02 * g.numofBanks FIT);
+    addFaultRate("not_clustered_single_column-p", 0.000E+00 * g.BLSA_per_chip FIT);
+    addFaultRate("not_clustered_single_column-t", 0.000E+00 * g.BLSA_per_chip FIT);
+    addFaultRate("row_decoder-p", 1.779E-02 * g.RDEC_per_chip FIT);
+    addFaultRate("row_decoder-t", 1.423E-02 * g.RDEC_per_chip FIT);
+    addFaultRate("single_csl_bank-p", 1.334E-03 * g.CSL_per_chip FIT);
+    addFaultRate("single_csl_bank-t", 4.873E-02 * g.CSL_per_chip FIT);
+    addFaultRate("single_csl_column-p", 9.529E-04 * g.CSL_per_chip FIT);
+    addFaultRate("single_csl_column-t", 2.109E-02 * g.CSL_per_chip FIT);
+    addFaultRate("single_sense_amp-p", 1.124E-07 * g.BLSA_per_chip FIT);
+    addFaultRate("single_sense_amp-t", 5.622E-08 * g.BLSA_per_chip FIT);
+    addFaultRate("subarray_row_decoder-p", 3.558E-02 * g.RDEC_SUBBANK_per_chip FIT);
+    addFaultRate("subarray_row_decoder-t", 1.423E-02 * g.RDEC_SUBBANK_per_chip FIT);
+    addFaultRate("subarray_row_decoder_two_clusters-p", 5.692E-02 * g.RDEC_SUBBANK_per_chip FIT);
+    addFaultRate("subarray_row_decoder_two_clusters-t", 1.169E-02 * g.RDEC_SUBBANK_per_chip FIT);
     // addFaultRate("two_row_overlap-p",4.879E-02*1 FIT);	addFaultRate("two_row_overlap-t",0.000E+00*1 FIT);
-    addFaultRate("potential_sense_amp-p", 1.881E-07 * BLSA_per_chip FIT);
-    addFaultRate("potential_sense_amp-t", 0.000E+00 * BLSA_per_chip FIT);
+    addFaultRate("potential_sense_amp-p", 1.881E-07 * g.BLSA_per_chip FIT);
+    addFaultRate("potential_sense_amp-t", 0.000E+00 * g.BLSA_per_chip FIT);
     addFaultRate("bank_control-p", 1.626E-02 * 1 FIT);
     addFaultRate("bank_control-t", 0.000E+00 * 1 FIT);
-    addFaultRate("potential_csl_column-p", 4.256E-03 * CSL_per_chip FIT);
-    addFaultRate("potential_csl_column-t", 0.000E+00 * CSL_per_chip FIT);
+    addFaultRate("potential_csl_column-p", 4.256E-03 * g.CSL_per_chip FIT);
+    addFaultRate("potential_csl_column-t", 0.000E+00 * g.CSL_per_chip FIT);
     addFaultRate("mutli_csls-p", 1.382E-01 * 1 FIT);
     addFaultRate("mutli_csls-t", 0.000E+00 * 1 FIT);
-    addFaultRate("consequtive_rows-p", 8.029E-05 * WLD_per_chip FIT);
-    addFaultRate("consequtive_rows-t", 0.000E+00 * WLD_per_chip FIT);
+    addFaultRate("consequtive_rows-p", 8.029E-05 * g.WLD_per_chip FIT);
+    addFaultRate("consequtive_rows-t", 0.000E+00 * g.WLD_per_chip FIT);
   }
   else if (module == 3)
   {
-    addFaultRate("bank_control_bank_8diff-p", 5.252E-03 * numofBanks FIT);
-    addFaultRate("bank_control_bank_8diff-t", 0.000E+00 * numofBanks FIT);
-    addFaultRate("decoder_multi_col-p", 1.694E-03 * CDEC_per_chip FIT);
-    addFaultRate("decoder_multi_col-t", 1.830E-02 * CDEC_per_chip FIT);
-    addFaultRate("decoder_single_col-p", 5.082E-04 * CDEC_per_chip FIT);
-    addFaultRate("decoder_single_col-t", 5.438E-02 * CDEC_per_chip FIT);
-    addFaultRate("local_wordline-p", 6.418E-04 * WLD_per_chip FIT);
-    addFaultRate("local_wordline-t", 8.970E-05 * WLD_per_chip FIT);
-    addFaultRate("local_wordline_two_clusters-p", 1.450E-04 * WLD_per_chip FIT);
-    addFaultRate("local_wordline_two_clusters-t", 1.353E-05 * WLD_per_chip FIT);
-    addFaultRate("lwl_sel-p", 1.745E-02 * RDEC_per_chip FIT);
-    addFaultRate("lwl_sel-t", 8.606E-02 * RDEC_per_chip FIT);
+    addFaultRate("bank_control_bank_8diff-p", 5.252E-03 * g.numofBanks FIT);
+    addFaultRate("bank_control_bank_8diff-t", 0.000E+00 * g.numofBanks FIT);
+    addFaultRate("decoder_multi_col-p", 1.694E-03 * g.CDEC_per_chip FIT);
+    addFaultRate("decoder_multi_col-t", 1.830E-02 * g.CDEC_per_chip FIT);
+    addFaultRate("decoder_single_col-p", 5.082E-04 * g.CDEC_per_chip FIT);
+    addFaultRate("decoder_single_col-t", 5.438E-02 * g.CDEC_per_chip FIT);
+    addFaultRate("local_wordline-p", 6.418E-04 * g.WLD_per_chip FIT);
+    addFaultRate("local_wordline-t", 8.970E-05 * g.WLD_per_chip FIT);
+    addFaultRate("local_wordline_two_clusters-p", 1.450E-04 * g.WLD_per_chip FIT);
+    addFaultRate("local_wordline_two_clusters-t", 1.353E-05 * g.WLD_per_chip FIT);
+    addFaultRate("lwl_sel-p", 1.745E-02 * g.RDEC_per_chip FIT);
+    addFaultRate("lwl_sel-t", 8.606E-02 * g.RDEC_per_chip FIT);
     addFaultRate("lwl_sel_column_related-p", 5.421E-03 * 1 FIT);
     addFaultRate("lwl_sel_column_related-t", 2.711E-03 * 1 FIT);
     addFaultRate("lwl_sel_random_bit-p", 2.711E-03 * 1 FIT);
     addFaultRate("lwl_sel_random_bit-t", 0.000E+00 * 1 FIT);
-    addFaultRate("lwl_sel2-p", 1.525E-03 * RDEC_per_chip FIT);
-    addFaultRate("lwl_sel2-t", 1.592E-02 * RDEC_per_chip FIT);
+    addFaultRate("lwl_sel2-p", 1.525E-03 * g.RDEC_per_chip FIT);
+    addFaultRate("lwl_sel2-t", 1.592E-02 * g.RDEC_per_chip FIT);
     addFaultRate("lwl_sel2_potential_col-p", 1.084E-02 * 1 FIT);
     addFaultRate("lwl_sel2_potential_col-t", 0.000E+00 * 1 FIT);
-    addFaultRate("multiple_single_bit_failures_-p", 3.934E+01 * BITS_per_chip FIT);
-    addFaultRate("multiple_single_bit_failures_-t", 2.514E+01 * BITS_per_chip FIT);
-    addFaultRate("mutli_csls_column_and_bank-p", 1.237E-02 * numofBanks FIT);
-    addFaultRate("mutli_csls_column_and_bank-t", 7.285E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_random_bank_row-p", 1.694E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_random_bank_row-t", 2.711E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_random_bits-p", 4.235E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_random_bits-t", 5.421E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_row_and_bits-p", 3.049E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_row_and_bits-t", 1.186E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_row_related-p", 3.219E-03 * numofBanks FIT);
-    addFaultRate("mutli_csls_row_related-t", 2.711E-03 * numofBanks FIT);
+    addFaultRate("multiple_single_bit_failures_-p", 3.934E+01 * g.BITS_per_chip FIT);
+    addFaultRate("multiple_single_bit_failures_-t", 2.514E+01 * g.BITS_per_chip FIT);
+    addFaultRate("mutli_csls_column_and_bank-p", 1.237E-02 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_column_and_bank-t", 7.285E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_random_bank_row-p", 1.694E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_random_bank_row-t", 2.711E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_random_bits-p", 4.235E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_random_bits-t", 5.421E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_row_and_bits-p", 3.049E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_row_and_bits-t", 1.186E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_row_related-p", 3.219E-03 * g.numofBanks FIT);
+    addFaultRate("mutli_csls_row_related-t", 2.711E-03 * g.numofBanks FIT);
     addFaultRate("not_clustered_multi_bank-p", 1.572E-01 * 1 FIT);
     addFaultRate("not_clustered_multi_bank-t", 1.816E-01 * 1 FIT);
     // addFaultRate("not_clustered_multi_bank_two_independent-p",5.828E-01*1 FIT);	addFaultRate("not_clustered_multi_bank_two_independent-t",4.337E-02*1 FIT);
-    addFaultRate("not_clustered_single_bank-p", 9.487E-03 * numofBanks FIT);
-    addFaultRate("not_clustered_single_bank-t", 9.826E-03 * numofBanks FIT);
-    addFaultRate("not_clustered_single_column-p", 1.939E-09 * BLSA_per_chip FIT);
-    addFaultRate("not_clustered_single_column-t", 1.292E-09 * BLSA_per_chip FIT);
-    addFaultRate("row_decoder-p", 1.033E-02 * RDEC_per_chip FIT);
-    addFaultRate("row_decoder-t", 1.101E-02 * RDEC_per_chip FIT);
-    addFaultRate("single_csl_bank-p", 1.334E-03 * CSL_per_chip FIT);
-    addFaultRate("single_csl_bank-t", 2.617E-02 * CSL_per_chip FIT);
-    addFaultRate("single_csl_column-p", 5.506E-04 * CSL_per_chip FIT);
-    addFaultRate("single_csl_column-t", 1.355E-02 * CSL_per_chip FIT);
-    addFaultRate("single_sense_amp-p", 1.926E-07 * BLSA_per_chip FIT);
-    addFaultRate("single_sense_amp-t", 1.047E-06 * BLSA_per_chip FIT);
-    addFaultRate("subarray_row_decoder-p", 3.659E-02 * RDEC_SUBBANK_per_chip FIT);
-    addFaultRate("subarray_row_decoder-t", 1.288E-02 * RDEC_SUBBANK_per_chip FIT);
-    addFaultRate("subarray_row_decoder_two_clusters-p", 2.948E-02 * RDEC_SUBBANK_per_chip FIT);
-    addFaultRate("subarray_row_decoder_two_clusters-t", 9.487E-03 * RDEC_SUBBANK_per_chip FIT);
+    addFaultRate("not_clustered_single_bank-p", 9.487E-03 * g.numofBanks FIT);
+    addFaultRate("not_clustered_single_bank-t", 9.826E-03 * g.numofBanks FIT);
+    addFaultRate("not_clustered_single_column-p", 1.939E-09 * g.BLSA_per_chip FIT);
+    addFaultRate("not_clustered_single_column-t", 1.292E-09 * g.BLSA_per_chip FIT);
+    addFaultRate("row_decoder-p", 1.033E-02 * g.RDEC_per_chip FIT);
+    addFaultRate("row_decoder-t", 1.101E-02 * g.RDEC_per_chip FIT);
+    addFaultRate("single_csl_bank-p", 1.334E-03 * g.CSL_per_chip FIT);
+    addFaultRate("single_csl_bank-t", 2.617E-02 * g.CSL_per_chip FIT);
+    addFaultRate("single_csl_column-p", 5.506E-04 * g.CSL_per_chip FIT);
+    addFaultRate("single_csl_column-t", 1.355E-02 * g.CSL_per_chip FIT);
+    addFaultRate("single_sense_amp-p", 1.926E-07 * g.BLSA_per_chip FIT);
+    addFaultRate("single_sense_amp-t", 1.047E-06 * g.BLSA_per_chip FIT);
+    addFaultRate("subarray_row_decoder-p", 3.659E-02 * g.RDEC_SUBBANK_per_chip FIT);
+    addFaultRate("subarray_row_decoder-t", 1.288E-02 * g.RDEC_SUBBANK_per_chip FIT);
+    addFaultRate("subarray_row_decoder_two_clusters-p", 2.948E-02 * g.RDEC_SUBBANK_per_chip FIT);
+    addFaultRate("subarray_row_decoder_two_clusters-t", 9.487E-03 * g.RDEC_SUBBANK_per_chip FIT);
     // addFaultRate("two_row_overlap-p",9.216E-02*1 FIT);	addFaultRate("two_row_overlap-t",8.132E-03*1 FIT);
-    addFaultRate("potential_sense_amp-p", 2.734E-07 * BLSA_per_chip FIT);
-    addFaultRate("potential_sense_amp-t", 0.000E+00 * BLSA_per_chip FIT);
+    addFaultRate("potential_sense_amp-p", 2.734E-07 * g.BLSA_per_chip FIT);
+    addFaultRate("potential_sense_amp-t", 0.000E+00 * g.BLSA_per_chip FIT);
     addFaultRate("bank_control-p", 4.066E-02 * 1 FIT);
     addFaultRate("bank_control-t", 0.000E+00 * 1 FIT);
-    addFaultRate("potential_csl_column-p", 3.113E-03 * CSL_per_chip FIT);
-    addFaultRate("potential_csl_column-t", 0.000E+00 * CSL_per_chip FIT);
+    addFaultRate("potential_csl_column-p", 3.113E-03 * g.CSL_per_chip FIT);
+    addFaultRate("potential_csl_column-t", 0.000E+00 * g.CSL_per_chip FIT);
     addFaultRate("mutli_csls-p", 5.692E-02 * 1 FIT);
     addFaultRate("mutli_csls-t", 0.000E+00 * 1 FIT);
-    addFaultRate("consequtive_rows-p", 5.706E-05 * WLD_per_chip FIT);
-    addFaultRate("consequtive_rows-t", 0.000E+00 * WLD_per_chip FIT);
+    addFaultRate("consequtive_rows-p", 5.706E-05 * g.WLD_per_chip FIT);
+    addFaultRate("consequtive_rows-t", 0.000E+00 * g.WLD_per_chip FIT);
   }
   else if (module == 4)
   {
@@ -384,7 +388,7 @@ DefaultFaultRateInfo::DefaultFaultRateInfo(bool HBMSETUP, bool detailed_errormap
 
         // Removing quotes from faultName
         faultName = faultName.substr(1, faultName.length() - 2);
-        faultValue *= getMultiplier(faultName);
+        faultValue *= getMultiplier(g, faultName);
 
         addFaultRate(faultName, faultValue FIT);
       }
@@ -457,6 +461,145 @@ DefaultFaultRateInfo::DefaultFaultRateInfo(bool HBMSETUP, bool detailed_errormap
   }
 }
 
+// Catalogs only depend on the module, the DRAM type (through the per-chip
+// multipliers) and the two constructor flags, so every fault domain of a run
+// shares the same one instead of rebuilding (or re-parsing) it.
+std::shared_ptr<const FaultRateCatalog> DefaultFaultRateCatalog::get(const DramGeometry *geometry, bool HBMSETUP, bool detailed_errormap)
+{
+  static std::mutex lock;
+  static std::map<std::string, std::shared_ptr<const FaultRateCatalog>> catalogs;
+  std::lock_guard<std::mutex> guard(lock);
+  std::string key = geometry->type + "." + std::to_string(module) + "." +
+                    std::to_string(HBMSETUP) + std::to_string(detailed_errormap) +
+                    std::to_string(ignore_external_faults);
+  auto it = catalogs.find(key);
+  if (it != catalogs.end())
+    return it->second;
+
+  DefaultFaultRateCatalog *catalog = new DefaultFaultRateCatalog(*geometry, HBMSETUP, detailed_errormap);
+  catalog->buildAliasTable();
+  std::shared_ptr<const FaultRateCatalog> shared(catalog);
+  catalogs[key] = shared;
+  return shared;
+}
+
+std::map<std::string, double> FaultRateCatalog::typeWeights;
+double FaultRateCatalog::rateScale = 1.;
+
+double FaultRateCatalog::getTypeWeight(const std::string &name)
+{
+  // the longest matching prefix wins
+  double weight = 1.;
+  size_t matched = 0;
+  for (auto it = typeWeights.cbegin(); it != typeWeights.cend(); it++)
+  {
+    if ((name.compare(0, it->first.length(), it->first) == 0) &&
+        (it->first.length() >= matched))
+    {
+      weight = it->second;
+      matched = it->first.length();
+    }
+  }
+  return weight;
+}
+
+// Vose's alias method: O(n) build, O(1) sampling.
+void FaultRateCatalog::buildAliasTable()
+{
+  aliasEntry.clear();
+  aliasProb.clear();
+  aliasIdx.clear();
+  aliasWeight.clear();
+  aliasSum = .0;
+  biasedSum = .0;
+  for (auto it = rateInfo.cbegin(); it != rateInfo.cend(); it++)
+  {
+    if ((*it).second <= 0)
+      continue;
+    double weight = rateScale * getTypeWeight((*it).first);
+    aliasEntry.push_back(&(*it));
+    aliasWeight.push_back(weight);
+    aliasSum += (*it).second;
+    biasedSum += weight * (*it).second;
+  }
+  int n = aliasEntry.size();
+  aliasProb.resize(n);
+  aliasIdx.resize(n);
+
+  std::vector<double> scaled(n);
+  std::vector<int> small, large;
+  for (int i = 0; i < n; i++)
+  {
+    scaled[i] = aliasWeight[i] * aliasEntry[i]->second * n / biasedSum;
+    aliasIdx[i] = i;
+    if (scaled[i] < 1.0)
+      small.push_back(i);
+    else
+      large.push_back(i);
+  }
+  while (!small.empty() && !large.empty())
+  {
+    int s = small.back();
+    small.pop_back();
+    int l = large.back();
+    aliasProb[s] = scaled[s];
+    aliasIdx[s] = l;
+    scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+    if (scaled[l] < 1.0)
+    {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // leftovers are 1.0 up to rounding error
+  for (int i : large)
+    aliasProb[i] = 1.0;
+  for (int i : small)
+    aliasProb[i] = 1.0;
+}
+
+// Number of words each fault type spans, i.e. the number of chances it has to
+// hit a word with a weak cell. A negative count marks faults spanning
+// (practically) the whole device: they overlap as soon as weak cells exist.
+static const double overlapWordCount[ERRORENUM] = {
+    1,                       // SBITENUM
+    1,                       // SWORDENUM
+    128 * 1024,              // SCOLENUM: 128k rows
+    128,                     // SROWENUM: from one row, 128 columns
+    128,                     // LWLNUM
+    128 * 128 * 1024,        // SBANKENUM
+    16.0 * 128 * 128 * 1024, // MBANKENUM
+    -1,                      // MRANKENUM
+    -1,                      // CHANNELENUM
+    2 * 1024,                // BLSA
+    2 * 128 * 1024,          // BANKPATTERN
+    2 * 16 * 1024,           // CDEC
+    16 * 1024,               // CSL
+    -1,                      // MMODULE
+    128 * 128,               // RDEC
+    2 * 1024,                // SWD
+    10,                      // DISTBIT
+    2 * 1024,                // CMUX
+    128 * 128,               // MWL
+    0, 0, 0, 0, 0, 0         // INHERENTENUM1-6: never injected as operational
+};
+
+// 1-(1-p)^n evaluated as -expm1(n*log1p(-p)), which stays accurate when p is
+// tiny and n is large (plain pow() loses everything to cancellation there)
+void InherentRate::setOverlapProb()
+{
+  double pWord = std::min(pWordWC_, 1.0);
+  for (int i = 0; i < ERRORENUM; i++)
+  {
+    if (overlapWordCount[i] < 0)
+      overlapProb[i] = (pWord < 1e-40) ? 0 : 1;
+    else if (pWord >= 1.0)
+      overlapProb[i] = (overlapWordCount[i] > 0) ? 1 : 0;
+    else
+      overlapProb[i] = -expm1(overlapWordCount[i] * log1p(-pWord));
+  }
+}
+
 // n choose k for sufficiently small integer
 double InherentRate::nchoosek(int n, int k)
 {
@@ -465,6 +608,32 @@ double InherentRate::nchoosek(int n, int k)
   return (n * nchoosek(n - 1, k - 1)) / k;
 }
 
+std::shared_ptr<InherentRate> InherentRate::get(class TesterSystem *tester, class ECC *ecc)
+{
+  static std::mutex lock;
+  static std::map<std::tuple<int, double, double, double, double>,
+                  std::shared_ptr<InherentRate>> rates;
+  std::lock_guard<std::mutex> guard(lock);
+  auto key = std::make_tuple(ecc->getBitN(), tester->getRatioWC(),
+                             tester->getActiveProbWC(), tester->getRatioFWC(),
+                             tester->getActiveProbFWC());
+  auto it = rates.find(key);
+  if (it != rates.end())
+    return it->second;
+
+  std::shared_ptr<InherentRate> iRate = std::make_shared<InherentRate>();
+  iRate->setTester(tester, ecc);
+  iRate->setIFRate();
+  rates[key] = iRate;
+  return iRate;
+}
+
+std::shared_ptr<InherentRate> InherentRate::getDefault()
+{
+  static std::shared_ptr<InherentRate> iRate = std::make_shared<InherentRate>();
+  return iRate;
+}
+
 void InherentRate::setTester(class TesterSystem *tester, class ECC *ecc)
 {
   _tester = tester;
@@ -488,6 +657,7 @@ void InherentRate::setIFRate()
   }; // error actually activated
 
   pWordWC_ = bitN * (p1 + p3);
+  setOverlapProb();
   // rough estimation of prob. that a weak cell exists in a block
   // probability pre-calculations
   for (int k1 = 0; k1 < Twelv * 10; k1++)
@@ -47,12 +47,15 @@ POSSIBILITY OF SUCH DAMAGE.
 #define __FAULT_RATE_INFO_HH__
 
 #include <assert.h>
+#include <algorithm>
 #include <math.h>
 #include <stdlib.h>
 #include <iostream>
 #include <list>
+#include <map>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "Config.hh"
 #include "common.hh"
@@ -100,6 +103,9 @@ typedef enum {
  * simple model appeared in a workshop paper - Seong-Lyong Gong, Jungrae Kim,
  * Mattan Erez, "DRAM Scaling Error Evaluation Model Using Various Retention
  * Time," DSN 2017
+ * @details The tables only depend on the weak-cell parameters of the tester
+ * and the ECC word size, so one instance is computed per such setting and
+ * shared by all fault domains (see InherentRate::get).
  */
 class InherentRate {
  public:
@@ -108,6 +114,8 @@ class InherentRate {
                0 FIT, 0 FIT, 0 FIT, 0 FIT, 0 FIT} {
     isPFmode = false;
     initial = true;
+    pWordWC_ = 0;
+    setOverlapProb();
   };
   double getRate(InherentErrorPattern ePattern) {
     // updateIFRate();
@@ -121,10 +129,18 @@ class InherentRate {
   void setTester(class TesterSystem *tester, class ECC *ecc);
   bool IsPFmode() { return isPFmode; };
   void setPFmode() { isPFmode = true; };
-  void setEP(InherentErrorPattern errorPattern) {
-    _errorPattern = errorPattern;
-  };  //!< set error pattern
-  InherentErrorPattern getEP() { return _errorPattern; };
+  //! probability that a fault of the given type (ErrorENUM) overlaps a weak
+  //! cell, precomputed by setOverlapProb()
+  double getOverlapProb(int typeIdx) {
+    assert(typeIdx < ERRORENUM);
+    return overlapProb[typeIdx];
+  }
+
+  //! shared rates for the tester's weak-cell parameters and the ECC word size
+  static std::shared_ptr<InherentRate> get(class TesterSystem *tester,
+                                           class ECC *ecc);
+  //! shared all-zero rates used before the tester is set
+  static std::shared_ptr<InherentRate> getDefault();
 
   double pWordWC_;  //!< ratio of weak cells;
   double
@@ -137,25 +153,28 @@ class InherentRate {
   bool initial;
 
  protected:
+  void setOverlapProb();  //!< recalculate overlapProb from pWordWC_
   double IFRate[InherrentPatterns];                   //!< Inherent Fault Rate in terms of FIT
+  double overlapProb[ERRORENUM];       //!< overlap probability per fault type
   class TesterSystem *_tester;         //!< tester class
   class ECC *_ecc;                     //!< ECC class
   bool isPFmode;                       //!< old variable used for debugging
-  InherentErrorPattern _errorPattern;  //!< error pattern of interest
 };
 
 /**@addtogroup Fault_Management
  * @{
  */
 
-/** @class FaultRateInfo
- * \brief A class that manages overall fault rate information
- * @details Default operational fault rates are defined at DefaultFaultRateInfo.
- * Default inherent faults' behaviors are considered in InherentRate.
-*/
-class FaultRateInfo {
+/** @class FaultRateCatalog
+ * \brief Immutable list of operational fault rates
+ * @details A catalog is filled once (see DefaultFaultRateCatalog) and then
+ * shared read-only by the FaultRateInfo of every fault domain. It keeps a
+ * Walker/Vose alias table over its rates for O(1) sampling.
+ */
+class FaultRateCatalog {
  public:
-  FaultRateInfo() { totalRate = .0; }
+  FaultRateCatalog() { totalRate = .0; }
+  virtual ~FaultRateCatalog() {}
 
  protected:
   void setDetailedError(bool detailed) { detailed_error = detailed; }
@@ -227,23 +246,8 @@ class FaultRateInfo {
     return prefix + suffix;
   }
 
- public:
-  //! get total fault rate
-  double getTotalRate() { 
-    auto last = rateInfo.rbegin();
-#ifdef FIXED_FITRATE
-    //For fixed fault rate    
-    if ((*last).first == "inherent") 
-      return 9.38e-8 + (*last).second;
-    else
-      return 9.38e-8; 
-#else
-    return totalRate;
-#endif
-    //return totalRate;
-  }
-
-  //! add fault rate to the list
+ protected:
+  //! add fault rate to the list (only while the catalog is being built)
   void addFaultRate(std::string name, double rate) {
     if (!detailed_error){
       name = convertToSimpleError(name);
@@ -254,151 +258,226 @@ class FaultRateInfo {
 
     totalRate += rate;
   }
-  //! remove fault rate from the list
-  void removeFaultRate(std::string name, double rate) {
-    rateInfo.remove(std::make_pair(name, rate));
-    totalRate -= rate;
+  //! Walker/Vose alias table over the (weighted) rates; called once the list
+  //! is final
+  void buildAliasTable();
+
+ public:
+  //! importance-sampling weight of the fault types whose name starts with
+  //! "prefix" (must be set before the catalogs are built)
+  static void setTypeWeight(const std::string &prefix, double weight) {
+    assert(weight > 0);
+    typeWeights[prefix] = weight;
+  }
+  static double getTypeWeight(const std::string &name);
+  //! importance-sampling multiplier of all operational fault rates
+  //! (inherent faults are not scaled)
+  static void setRateScale(double scale) {
+    assert(scale > 0);
+    rateScale = scale;
+  }
+  //! whether catalogs sample from biased rates
+  static bool isBiased() { return (rateScale != 1.) || !typeWeights.empty(); }
+
+  //! sum of all the rates in the catalog
+  double getTotalRate() const { return totalRate; }
+  //! sum of the rates covered by the alias table (non-zero entries)
+  double getAliasSum() const { return aliasSum; }
+  //! sum of the weighted (and scaled) rates the alias table samples from
+  //! (equal to getAliasSum() unless isBiased())
+  double getBiasedSum() const { return biasedSum; }
+  //! pick an entry proportionally to its (weighted) rate, draw in [0, 1)
+  const std::pair<std::string, double> *pick(double draw,
+                                             double *weight = NULL) const {
+    assert(!aliasEntry.empty());
+    double u = draw * aliasEntry.size();
+    int col = (int)u;
+    if (col >= (int)aliasEntry.size()) col = aliasEntry.size() - 1;
+    if ((u - col) >= aliasProb[col]) col = aliasIdx[col];
+    if (weight != NULL) *weight = aliasWeight[col];
+    return aliasEntry[col];
+  }
+  //! entries of the alias table by index (e.g. for recorded fault types)
+  int getEntryCount() const { return aliasEntry.size(); }
+  const std::pair<std::string, double> *getEntry(int idx) const {
+    assert((idx >= 0) && (idx < (int)aliasEntry.size()));
+    return aliasEntry[idx];
+  }
+  int getEntryIdx(const std::pair<std::string, double> *entry) const {
+    auto it = std::find(aliasEntry.begin(), aliasEntry.end(), entry);
+    assert(it != aliasEntry.end());
+    return it - aliasEntry.begin();
   }
+  void printFaults() const {
+    for (auto it = rateInfo.cbegin(); it != rateInfo.cend(); it++) {
+      std::cout << (*it).first << " @ FIT rate " << (*it).second << std::endl;
+    }
+  }
+
+ protected:
+  std::list<std::pair<std::string, double>> rateInfo;
+  double totalRate;
+  std::vector<const std::pair<std::string, double> *> aliasEntry;
+  std::vector<double> aliasProb;
+  std::vector<int> aliasIdx;
+  std::vector<double> aliasWeight;
+  double aliasSum = .0;
+  double biasedSum = .0;
+  static std::map<std::string, double> typeWeights;
+  static double rateScale;
+};
+
+/**
+ * @class DefaultFaultRateCatalog
+ * @brief Tianchi DRAM fault dataset
+ * https://tianchi.aliyun.com/dataset/132973
+ * SRDS 2022, An In-Depth Correlative Study Between DRAM Errors and Server Failures in Production Data Centers
+ */
+class DefaultFaultRateCatalog : public FaultRateCatalog {
+ public:
+  //! shared catalog for the current module and the DRAM type of "geometry"
+  static std::shared_ptr<const FaultRateCatalog> get(
+      const DramGeometry *geometry, bool HBMSETUP, bool detailed_errormap);
 
-  void removeLastRate() {
-    auto last = rateInfo.rbegin();
-    
+ protected:
+  DefaultFaultRateCatalog(const DramGeometry &g, bool HBMSETUP,
+                          bool detailed_errormap);
+};
 
-    totalRate -= (*last).second;
-    // free the memory last which is create by make_pair
-    rateInfo.pop_back();
-    if (rateInfo.size() == 0) printf("empty!!\n");
+/** @class FaultRateInfo
+ * \brief A class that manages overall fault rate information
+ * @details Default operational fault rates are defined at DefaultFaultRateCatalog
+ * and shared by all domains. Default inherent faults' behaviors are considered
+ * in InherentRate. This per-domain overlay only holds the inherent-rate slot
+ * and the inherent error pattern of the domain.
+*/
+class FaultRateInfo {
+ public:
+  FaultRateInfo(std::shared_ptr<const FaultRateCatalog> _catalog)
+      : iRate(InherentRate::getDefault()),
+        catalog(_catalog),
+        inherentEntry("inherent", .0),
+        hasInherent(false),
+        _errorPattern(None),
+        _tester(NULL),
+        _ecc(NULL) {}
+  virtual ~FaultRateInfo() {}
+
+ public:
+  //! get total fault rate
+  double getTotalRate() { 
+#ifdef FIXED_FITRATE
+    //For fixed fault rate    
+    if (hasInherent) 
+      return 9.38e-8 + inherentEntry.second;
+    else
+      return 9.38e-8; 
+#else
+    return catalog->getTotalRate() + getInherentRate();
+#endif
+    //return totalRate;
+  }
+  //! total fault rate sampled under importance sampling, where the rate of
+  //! each type is multiplied by its weight (see FaultRateCatalog)
+  double getBiasedRate() {
+    double sum = catalog->getAliasSum();
+    double biased = catalog->getBiasedSum();
+    if (biased == sum) return getTotalRate();
+    double inherent = getInherentRate();
+    return getTotalRate() * (biased + inherent) / (sum + inherent);
   }
-  //! a simplified calculation of overlap probability between faults
-  double overlap_prob(std::string name) {
-    double overlap_prob_;
-    // double BLK_GB_16 = (double) BLK_SIZE / GB_16;
-    double pWord = iRate->pWordWC_;
-    if (name == "Sbit") {
-      // prob that single bit overlapped with a cacheline in 16GB
-      overlap_prob_ = 1 - pow(1-pWord, 1);//
-      // std::cout<<"mask: SBIT";
-    } else if (name == "Sword") {
-      overlap_prob_ = 1 - pow(1 - pWord, 1);  //
-      // std::cout<<"mask: SWORD";
-    } else if (name == "Scol") {
-      overlap_prob_ = 1 - pow(1-pWord, 128*1024);// 128k rows
-      // std::cout<<"mask: SCOL";
-    } else if (name == "Srow" || name == "Lwordline") {
-      overlap_prob_ = 1 - pow(1 - pWord, 128);  // from one row, 128 columns
-      // std::cout<<"mask: SROW";
-    } else if (name == "Sbank") {
-      overlap_prob_ =
-          1 - pow(1 - pWord, 128 * 128 * 1024);  // 
-      // std::cout<<"mask: SBANK";
-    } else if (name == "Mbank") {
-      overlap_prob_ =
-          1 -
-          pow(1 - pWord, 16 * 128 *  128 * 1024);  //
-      // std::cout<<"mask: MBANK";
-    } else if (name == "Mrank") {
-      if (pWord < 1e-40)
-        overlap_prob_ = 0;
-      else
-        overlap_prob_ = 1;
-      // std::cout<<"mask: MRANK";
-    } else if (name == "Channel") {
-      if (pWord < 1e-40)
-        overlap_prob_ = 0;
-      else
-        overlap_prob_ = 1;
-      // std::cout<<"mask: CHANNEL";
-    } else if (name == "BLSA") {
-      overlap_prob_ =
-          1 - pow(1 - pWord, 2 * 1024);
-    } else if (name == "Bank_pattern"){
-      overlap_prob_ =
-          1 - pow(1 - pWord, 2 * 128 * 1024);
-    } else if (name == "CDEC"){
-      overlap_prob_ = 1 - pow(1 - pWord, 2 * 16 * 1024);
-    } else if (name == "CSL"){
-      overlap_prob_ = 1 - pow(1 - pWord, 16 * 1024);
-    } else if (name == "Multi_module"){
-      if (pWord < 1e-40)
-        overlap_prob_ = 0;
-      else
-        overlap_prob_ = 1;
-
-    } else if (name == "RDEC"){
-      overlap_prob_ = 1 - pow(1 - pWord, 128 * 128);
-    } else if (name =="SWD"){
-      overlap_prob_ = 1 - pow(1 - pWord, 2 * 1024);
-    } else if (name == "Dist_bit"){
-      overlap_prob_ = 1 - pow(1 - pWord, 10);
-    } else if (name == "CMUX"){
-      overlap_prob_ = 1 - pow(1 - pWord, 2 * 1024);
-    } else if (name == "MWL"){
-      overlap_prob_ = 1 - pow(1 - pWord, 128 * 128);
-    }
-    else {
-      assert(0);
-      return 1;
-    }
 
-    return overlap_prob_;
+  //! set the inherent fault rate of this domain (in place)
+  void setInherentRate(double rate) {
+    inherentEntry.second = rate;
+    hasInherent = true;
   }
+  //! drop the inherent fault rate of this domain
+  void clearInherentRate() {
+    inherentEntry.second = .0;
+    hasInherent = false;
+  }
+  double getInherentRate() { return hasInherent ? inherentEntry.second : .0; }
+  bool hasInherentRate() { return hasInherent; }
+
+  //! a simplified calculation of overlap probability between faults
+  //! (a table lookup by Fault::getTypeIdx(), see InherentRate::setOverlapProb)
+  double overlap_prob(int typeIdx) { return iRate->getOverlapProb(typeIdx); }
 
   void printFaults() {
-    for (auto it = rateInfo.cbegin(); it != rateInfo.cend(); it++) {
-      std::cout << (*it).first << " @ FIT rate " << (*it).second << std::endl;
+    catalog->printFaults();
+    if (hasInherent) {
+      std::cout << inherentEntry.first << " @ FIT rate " << inherentEntry.second
+                << std::endl;
     }
   }
   // std::string pickRandomType() {
   //! pick a random fault type from the list, proportionally to its rate
-  const std::pair<std::string, double> *pickRandomType() {
-    double draw = (double)rand() / RAND_MAX;
-    double sum = .0;
-    double total_sum = .0;
-    for (auto it = rateInfo.cbegin(); it != rateInfo.cend(); it++) {
-      total_sum += (*it).second;
-    }
-    for (auto it = rateInfo.cbegin(); it != rateInfo.cend(); it++) {
-      sum += (*it).second;
-      if ((sum / totalRate) >= draw * (total_sum / totalRate)) {
-        // return (*it).first;
-        return &(*it);
-      }
+  //! The inherent slot is drawn as its own mixture component and the
+  //! operational faults through the catalog's alias table, so that a pick
+  //! costs O(1) regardless of the number of fault types (one rand() call).
+  //! Under importance sampling, the pick is proportional to the weighted
+  //! rates and *lr receives the likelihood ratio of the pick relative to
+  //! the biased total rate, (rate*p)/(biasedRate*q).
+  const std::pair<std::string, double> *pickRandomType(double *lr = NULL) {
+    double inherent = getInherentRate();
+    double biased = catalog->getBiasedSum();
+    double draw = (double)timelineRand() / RAND_MAX * (biased + inherent);
+    double weight = 1.;
+    const std::pair<std::string, double> *entry;
+    if ((inherent > 0 && draw >= biased) || (biased <= 0)) {
+      assert(hasInherent);
+      entry = &inherentEntry;
+    } else {
+      entry = catalog->pick(draw / biased, &weight);
     }
+    // (rate*p)/(biasedRate*q) reduces to the inverse weight of the type
+    if (lr != NULL) *lr = 1. / weight;
+    return entry;
+  }
 
-    assert(0);
+  //! fault type by index: -1 is the inherent slot, the others index the
+  //! catalog (see FaultRateCatalog::getEntry)
+  const std::pair<std::string, double> *getEntry(int idx) {
+    return (idx < 0) ? &inherentEntry : catalog->getEntry(idx);
   }
-  InherentRate *iRate = new InherentRate();
+  int getEntryIdx(const std::pair<std::string, double> *entry) {
+    return (entry == &inherentEntry) ? -1 : catalog->getEntryIdx(entry);
+  }
+  int getEntryCount() { return catalog->getEntryCount(); }
+
+  //! look up the shared inherent rates for the current tester and ECC
+  void initInherentRate() { iRate = InherentRate::get(_tester, _ecc); }
   void setTester(class TesterSystem *tester, ECC *ecc) {
-    iRate->setTester(tester, ecc);
-  };  //_tester = tester;};
+    _tester = tester;
+    _ecc = ecc;
+  };
+  void setEP(InherentErrorPattern errorPattern) {
+    _errorPattern = errorPattern;
+  };  //!< set error pattern
+  InherentErrorPattern getEP() { return _errorPattern; };
+
+  std::shared_ptr<InherentRate> iRate;  //!< shared inherent rates
+
  protected:
-  std::list<std::pair<std::string, double>> rateInfo;
-  // make smart pointer version rateInfo
-  // std::list<std::shared_ptr<std::pair<std::string, double>>> rateInfo;
-  double totalRate;
+  std::shared_ptr<const FaultRateCatalog> catalog;  //!< shared fault rates
+  std::pair<std::string, double> inherentEntry;  //!< inherent-rate slot
+  bool hasInherent;
+  InherentErrorPattern _errorPattern;  //!< error pattern of interest
   class TesterSystem *_tester;
   class ECC *_ecc;
-public:
-  ~FaultRateInfo() { 
-    delete iRate; 
-    rateInfo.clear();
-  }
-
 };
 /* @} */
 
 /**
  * @class DefaultFaultRateInfo
- * @brief Tianchi DRAM fault dataset
- * https://tianchi.aliyun.com/dataset/132973
- * SRDS 2022, An In-Depth Correlative Study Between DRAM Errors and Server Failures in Production Data Centers
+ * @brief FaultRateInfo over the shared DefaultFaultRateCatalog
  */
 class DefaultFaultRateInfo : public FaultRateInfo {
  public:
-  ~DefaultFaultRateInfo() { 
-    delete iRate; 
-    rateInfo.clear();
-  }
-  DefaultFaultRateInfo(bool HBMSETUP, bool detailed_errormap);
+  DefaultFaultRateInfo(const DramGeometry *geometry, bool HBMSETUP,
+                       bool detailed_errormap)
+      : FaultRateInfo(DefaultFaultRateCatalog::get(geometry, HBMSETUP,
+                                                   detailed_errormap)) {}
 };
 #endif /* __FAULT_RATE_INFO_HH__ */
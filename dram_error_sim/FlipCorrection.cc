@@ -586,7 +586,7 @@ unsigned long long LargeRS::getInitialRetiredBlkCount(FaultDomain *fd,
                              (1 - goodSymProb);
 
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 64;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 64;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
     //unsigned long long goodBlkCount = distribution(randomGenerator);
     unsigned long long goodBlkCount = totalBlkCount * goodBlkProb;
@@ -690,7 +690,7 @@ unsigned long long LargeRS_aiecc::getInitialRetiredBlkCount(FaultDomain *fd,
                              (1 - goodSymProb);
 
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 64;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 64;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
     //unsigned long long goodBlkCount = distribution(randomGenerator);
     unsigned long long goodBlkCount = totalBlkCount * goodBlkProb;
@@ -801,7 +801,7 @@ unsigned long long LargeRS_HBM::getInitialRetiredBlkCount(FaultDomain *fd,
                              (1 - goodSymProb);
 
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 64;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 64;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
     //unsigned long long goodBlkCount = distribution(randomGenerator);
     unsigned long long goodBlkCount = totalBlkCount * goodBlkProb;
@@ -189,9 +189,9 @@ unsigned long long OnChip40bSDDC::getInitialRetiredBlkCount(
     double goodBlkProb =
         pow(goodECCBlkProb, fd->getChannelWidth() / fd->getChipWidth());
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 128;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 128;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -211,8 +211,8 @@ void OnChip40bXEDx8::detectInDRAM(CacheLine &errorBlk,
       if ((result == CE) || (result == DUE)) {
         // catch-word collision
         unsigned long long draw =
-            ((unsigned long long)rand() * ((unsigned long long)RAND_MAX + 1)) |
-            rand();
+            ((unsigned long long)decoderRand() * ((unsigned long long)RAND_MAX + 1)) |
+            decoderRand();
         if (draw % 0x100000000ull != 0) {  // 2^-32
           // no collision
           chipLocations.push_back(i);
@@ -333,9 +333,9 @@ unsigned long long OnChip40bXEDx8::getInitialRetiredBlkCount(FaultDomain *fd,
     double goodBlkProb =
         pow(goodECCBlkProb, fd->getChannelWidth() / fd->getChipWidth());
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 128;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 128;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -602,9 +602,9 @@ unsigned long long OnChip40bBamboo::getInitialRetiredBlkCount(
         eccBlkSize * pow(1 - cellFaultRate, eccBlkSize - 1) * cellFaultRate;
     double goodBlkProb = pow(goodECCBlkProb, fd->getChipCount());
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 128;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 128;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -667,9 +667,9 @@ unsigned long long OnChip40bBamboox8::getInitialRetiredBlkCount(
         eccBlkSize * pow(1 - cellFaultRate, eccBlkSize - 1) * cellFaultRate;
     double goodBlkProb = pow(goodECCBlkProb, fd->getChipCount());
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 128;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 128;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -843,9 +843,9 @@ unsigned long long OnChip40bDUO::getInitialRetiredBlkCount(FaultDomain *fd,
                              (1 - goodSymProb);
 
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 64;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 64;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -1010,9 +1010,9 @@ unsigned long long OnChip40bDUOx8::getInitialRetiredBlkCount(FaultDomain *fd,
                              (1 - goodSymProb);
 
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 64;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 64;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -1773,9 +1773,9 @@ unsigned long long OnChip40bBamboo_FLEX::getInitialRetiredBlkCount(
         eccBlkSize * pow(1 - cellFaultRate, eccBlkSize - 1) * cellFaultRate;
     double goodBlkProb = pow(goodECCBlkProb, fd->getChipCount());
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 128;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 128;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -50,7 +50,7 @@ ErrorType LOTECC::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
   // random data
   ECCWord dataMsg = {errorBlk.getBitN(), 0};
   for (int i = 0; i < errorBlk.getChannelWidth(); i++) {
-    dataMsg.setSymbol(8, i, rand() % 0x100);
+    dataMsg.setSymbol(8, i, decoderRand() % 0x100);
   }
 
   ECCWord errorMsg = {errorBlk.getBitN(), 0};
@@ -120,7 +120,8 @@ ErrorType LOTECC::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
   } else if (errorDetectedCnt > 1) {
     result = DUE;
   } else {
-    // generate error on second block
+    // generate error on second block (drawn by the decoder)
+    DecoderDraws draws;
     Fault *newFault = fd->operationalFaultList.back();
 
     CacheLine errorBlk2 = {errorBlk.getChipWidth(), errorBlk.getChannelWidth(),
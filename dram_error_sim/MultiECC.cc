@@ -81,17 +81,17 @@ ErrorType MultiECC::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
             uint32_t errorChecksum = 0;
 
             for (int j = 0; j < 256; j++) {
-              uint16_t data = rand() % 0x10000;
+              uint16_t data = decoderRand() % 0x10000;
               uint16_t error;
               if (j == 0) {
                 error = decoded.getSymbol(16, (*it)->getChipID());
               } else {
                 if (!(*it)->getIsSingleDQ()) {
-                  error = rand() % 0x10000;
+                  error = decoderRand() % 0x10000;
                 } else {
                   int pinLoc = (*it)->getPinID() % 8;
                   error =
-                      ((rand() % 2) << pinLoc) | (rand() % 2 << (pinLoc + 8));
+                      ((decoderRand() % 2) << pinLoc) | (decoderRand() % 2 << (pinLoc + 8));
                 }
               }
               origChecksum += data;
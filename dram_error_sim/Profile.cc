@@ -0,0 +1,76 @@
+/*
+Copyright 2023, The University of Texas at Austin
+All rights reserved.
+
+THIS FILE IS PART OF THE DRAM FAULT ERROR SIMULATION FRAMEWORK
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * @file: Profile.cc
+ * @brief Per-phase cycle and call counters of the simulation hot path
+ */
+
+#include "Profile.hh"
+
+thread_local ProfileCounters profileCounters = {{0}, {0}};
+thread_local uint64_t *profileChildTicks = NULL;
+
+static const char *profilePhaseName[NUM_PROF_PHASES] = {
+    "fault generation", "error generation", "overlap scan",
+    "combinations",     "extract",          "decode",
+    "postprocess",      "brute force"};
+
+//------------------------------------------------------------------------------
+void ProfileCounters::print(FILE *fd, const char *title,
+                            uint64_t totalTicks) const
+{
+#ifdef NO_PROFILE
+  return;
+#endif
+  if (totalTicks == 0) return;
+  fprintf(fd, "Profile %s (%.3e ticks)\n", title, (double)totalTicks);
+  uint64_t phaseTicks = 0;
+  for (int i = 0; i < NUM_PROF_PHASES; i++)
+  {
+    phaseTicks += ticks[i];
+    if (calls[i] == 0) continue;
+    fprintf(fd, "  %-18s %6.2f%% %12llu calls %10.1f ticks/call\n",
+            profilePhaseName[i], 100. * ticks[i] / totalTicks,
+            (unsigned long long)calls[i], (double)ticks[i] / calls[i]);
+  }
+  uint64_t other = (totalTicks > phaseTicks) ? totalTicks - phaseTicks : 0;
+  fprintf(fd, "  %-18s %6.2f%%\n", "other", 100. * other / totalTicks);
+  fflush(fd);
+}
@@ -0,0 +1,143 @@
+/*
+Copyright 2023, The University of Texas at Austin
+All rights reserved.
+
+THIS FILE IS PART OF THE DRAM FAULT ERROR SIMULATION FRAMEWORK
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * @file: Profile.hh
+ * @brief Per-phase cycle and call counters of the simulation hot path
+ * @details PROFILE_SCOPE(phase) charges the time spent until the end of the
+ * enclosing block to "phase", excluding nested scopes (e.g. ECCWord::extract
+ * inside a decode), so the phases of a run add up. The counters are
+ * thread-local and cost two timestamp reads per scope; building with
+ * -DNO_PROFILE (cmake -DPROFILE_PHASES=OFF) compiles the scopes out.
+ */
+
+#ifndef __PROFILE_HH__
+#define __PROFILE_HH__
+
+#include <stdint.h>
+#include <stdio.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+typedef enum {
+  PROF_FAULT_GEN,     //!< Fault::genRandomFault
+  PROF_ERROR_GEN,     //!< Fault::genRandomError(s)
+  PROF_OVERLAP,       //!< scan of the previous faults for overlaps
+  PROF_COMBINATIONS,  //!< enumeration of overlapping fault combinations
+  PROF_EXTRACT,       //!< ECCWord::extract
+  PROF_DECODE,        //!< ECC::decodeInternal (Codec::decode)
+  PROF_POSTPROCESS,   //!< ECC::postprocess
+  PROF_BRUTE_FORCE,   //!< brute-force chip search
+  NUM_PROF_PHASES
+} ProfilePhase;
+
+/** @class ProfileCounters
+ * \brief Exclusive ticks and calls per phase
+ */
+struct ProfileCounters {
+  uint64_t ticks[NUM_PROF_PHASES];
+  uint64_t calls[NUM_PROF_PHASES];
+
+  void clear() {
+    for (int i = 0; i < NUM_PROF_PHASES; i++) ticks[i] = calls[i] = 0;
+  }
+  //! add the counts accumulated since "before" was copied from "now"
+  void addDelta(const ProfileCounters &now, const ProfileCounters &before) {
+    for (int i = 0; i < NUM_PROF_PHASES; i++) {
+      ticks[i] += now.ticks[i] - before.ticks[i];
+      calls[i] += now.calls[i] - before.calls[i];
+    }
+  }
+  //! breakdown of "totalTicks" (e.g. of all the runs) by phase
+  void print(FILE *fd, const char *title, uint64_t totalTicks) const;
+};
+
+extern thread_local ProfileCounters profileCounters;
+//! time of the nested scopes of the innermost open scope (NULL outside)
+extern thread_local uint64_t *profileChildTicks;
+
+//! cycles (TSC) where available, nanoseconds otherwise
+inline uint64_t profileTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+/** @class ProfileScope
+ * \brief Charges its lifetime, minus nested scopes, to a phase
+ */
+class ProfileScope {
+ public:
+  explicit ProfileScope(ProfilePhase _phase)
+      : phase(_phase), parentChild(profileChildTicks), start(profileTicks()) {
+    profileChildTicks = &child;
+  }
+  ~ProfileScope() {
+    uint64_t elapsed = profileTicks() - start;
+    profileCounters.ticks[phase] += elapsed - child;
+    profileCounters.calls[phase]++;
+    if (parentChild != NULL) *parentChild += elapsed;
+    profileChildTicks = parentChild;
+  }
+
+ private:
+  ProfilePhase phase;
+  uint64_t *parentChild;
+  uint64_t child = 0;
+  uint64_t start;
+};
+
+#ifdef NO_PROFILE
+#define PROFILE_SCOPE(phase)
+#else
+#define PROFILE_CONCAT2(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT2(a, b)
+#define PROFILE_SCOPE(phase) \
+  ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(phase)
+#endif
+
+#endif /* __PROFILE_HH__ */
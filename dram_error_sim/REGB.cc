@@ -99,9 +99,9 @@ unsigned long long OnChip64b::getInitialRetiredBlkCount(
     double goodBlkProb =
         pow(goodECCBlkProb, fd->getChannelWidth() / fd->getChipWidth());
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 128;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 128;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -161,9 +161,9 @@ unsigned long long OnChip72bSECDED::getInitialRetiredBlkCount(
     double goodBlkProb =
         pow(goodECCBlkProb, fd->getChannelWidth() / fd->getChipWidth());
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 128;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 128;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -235,9 +235,9 @@ unsigned long long OnChip72bAMD::getInitialRetiredBlkCount(
     double goodBlkProb =
         pow(goodECCBlkProb, fd->getChannelWidth() / fd->getChipWidth());
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 128;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 128;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -305,9 +305,9 @@ unsigned long long OnChip36bSDDC::getInitialRetiredBlkCount(
     double goodBlkProb =
         pow(goodECCBlkProb, fd->getChannelWidth() / fd->getChipWidth());
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 128;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 128;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -369,9 +369,9 @@ unsigned long long OnChip72bQPC72b::getInitialRetiredBlkCount(
         eccBlkSize * pow(1 - cellFaultRate, eccBlkSize - 1) * cellFaultRate;
     double goodBlkProb = pow(goodECCBlkProb, fd->getChipCount());
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 128;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 128;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -422,7 +422,7 @@ ErrorType QPC72bREGB::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
       }
     }
     if (overlapManyDQFaults.size() > 0) {
-      int faultPos = rand() % overlapManyDQFaults.size();
+      int faultPos = decoderRand() % overlapManyDQFaults.size();
       int pos;
       for (auto it = overlapManyDQFaults.cbegin();
            it != overlapManyDQFaults.cend();) {
@@ -451,7 +451,7 @@ ErrorType QPC72bREGB::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
         pos++;
       }
     } else if (overlapFewDQFaults.size() > 0) {
-      int faultPos = rand() % overlapFewDQFaults.size();
+      int faultPos = decoderRand() % overlapFewDQFaults.size();
       int pos;
       for (auto it = overlapFewDQFaults.cbegin();
            it != overlapFewDQFaults.cend();) {
@@ -521,9 +521,9 @@ unsigned long long QPC72bREGB::getInitialRetiredBlkCount(
                              pow(1 - goodSymProb, 2);
 
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 64;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 64;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -0,0 +1,108 @@
+/*
+Copyright 2023, The University of Texas at Austin
+All rights reserved.
+
+THIS FILE IS PART OF THE DRAM FAULT ERROR SIMULATION FRAMEWORK
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * @file: RateTree.hh
+ * @brief Sum (segment) tree over non-negative rates
+ */
+
+#ifndef __RATE_TREE_HH__
+#define __RATE_TREE_HH__
+
+#include <assert.h>
+#include <vector>
+
+/** @class RateTree
+ * \brief Complete binary sum tree over a fixed number of rates
+ * @details Each internal node stores the sum of its children, so updating a
+ * single rate and drawing an index proportionally to the rates are both
+ * O(log N). Internal nodes are recomputed (not adjusted by deltas), so the
+ * total does not drift over many updates.
+ */
+class RateTree {
+ public:
+  RateTree() : leafCnt(0), size(0) {}
+
+  //! resize to _size leaves, all rates set to zero
+  void resize(int _size) {
+    size = _size;
+    leafCnt = 1;
+    while (leafCnt < size) leafCnt <<= 1;
+    node.assign(2 * leafCnt, .0);
+  }
+  int getSize() const { return size; }
+
+  //! set rate of leaf idx
+  void set(int idx, double rate) {
+    assert((idx >= 0) && (idx < size));
+    int i = idx + leafCnt;
+    node[i] = rate;
+    for (i >>= 1; i > 0; i >>= 1) {
+      node[i] = node[2 * i] + node[2 * i + 1];
+    }
+  }
+  double get(int idx) const { return node[idx + leafCnt]; }
+  double total() const { return (size == 0) ? .0 : node[1]; }
+
+  //! find the first leaf whose cumulative rate reaches target
+  //! (0 <= target <= total()); zero-rate leaves are never returned
+  //! unless every rate is zero
+  int find(double target) const {
+    assert(size > 0);
+    int i = 1;
+    while (i < leafCnt) {
+      double left = node[2 * i];
+      if ((left > 0) && ((target <= left) || (node[2 * i + 1] <= 0))) {
+        i = 2 * i;
+      } else {
+        target -= left;
+        i = 2 * i + 1;
+      }
+    }
+    int idx = i - leafCnt;
+    return (idx < size) ? idx : size - 1;
+  }
+
+ protected:
+  int leafCnt;               //!< number of leaves (power of two)
+  int size;                  //!< number of valid leaves
+  std::vector<double> node;  //!< node[1] is the root, leaves at [leafCnt, 2*leafCnt)
+};
+
+#endif /* __RATE_TREE_HH__ */
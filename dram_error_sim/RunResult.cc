@@ -0,0 +1,418 @@
+/*
+Copyright 2023, The University of Texas at Austin
+All rights reserved.
+
+THIS FILE IS PART OF THE DRAM FAULT ERROR SIMULATION FRAMEWORK
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * @file: RunResult.cc
+ * @brief Machine-readable results of a system-level simulation
+ */
+
+#include <assert.h>
+#include <dirent.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <set>
+#include <thread>
+
+#include "RunResult.hh"
+#include "Stats.hh"
+
+static const char *RESULT_MAGIC = "faulterrorsim_result";
+static const int RESULT_VERSION = 1;
+static const char *kindName[RunResult::NUM_KINDS] = {"RETIRE", "DUE", "SDC"};
+
+//------------------------------------------------------------------------------
+void RunResult::resize(int _years, int typeCnt)
+{
+  years = _years;
+  for (int k = 0; k < NUM_KINDS; k++)
+  {
+    count[k].assign(years, 0.);
+    weight[k].assign(years, 0.);
+    weightSq[k].assign(years, 0.);
+  }
+  typeNames.resize(typeCnt);
+  for (int k = 0; k < 2; k++)
+  {
+    typeCount[k].assign(years, std::vector<double>(typeCnt, 0.));
+    typeWeightSq[k].assign(years, std::vector<double>(typeCnt, 0.));
+  }
+}
+
+//------------------------------------------------------------------------------
+bool RunResult::merge(const RunResult &other)
+{
+  if ((years != other.years) || (typeNames != other.typeNames))
+    return false;
+  trials += other.trials;
+  weighted |= other.weighted;
+  for (int k = 0; k < NUM_KINDS; k++)
+  {
+    for (int yr = 0; yr < years; yr++)
+    {
+      count[k][yr] += other.count[k][yr];
+      weight[k][yr] += other.weight[k][yr];
+      weightSq[k][yr] += other.weightSq[k][yr];
+    }
+  }
+  for (int k = 0; k < 2; k++)
+    for (int yr = 0; yr < years; yr++)
+      for (size_t t = 0; t < typeNames.size(); t++)
+      {
+        typeCount[k][yr][t] += other.typeCount[k][yr][t];
+        typeWeightSq[k][yr][t] += other.typeWeightSq[k][yr][t];
+      }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+std::string RunResult::groupKey() const
+{
+  return std::to_string(systemID) + "\t" + system + "\t" +
+         std::to_string(module) + "\t" + dram + "\t" + params + "\t" +
+         options;
+}
+
+//------------------------------------------------------------------------------
+static void saveArray(FILE *fd, const char *name, const char *kind,
+                      const std::vector<double> &values)
+{
+  fprintf(fd, "%s %s", name, kind);
+  for (double value : values)
+    fprintf(fd, " %.17g", value);
+  fprintf(fd, "\n");
+}
+
+//------------------------------------------------------------------------------
+bool RunResult::save(const char *fileName) const
+{
+  FILE *fd = fopen(fileName, "w");
+  if (fd == NULL) return false;
+  fprintf(fd, "%s %d\n", RESULT_MAGIC, RESULT_VERSION);
+  fprintf(fd, "system_id %d\nsystem %s\nseed %s\nmodule %d\ndram %s\n",
+          systemID, system.c_str(), seed.c_str(), module, dram.c_str());
+  fprintf(fd, "params %s\noptions %s\n", params.c_str(), options.c_str());
+  fprintf(fd, "trials %ld\nweighted %d\nyears %d\ntypes %zu\n", trials,
+          weighted, years, typeNames.size());
+  for (size_t t = 0; t < typeNames.size(); t++)
+    fprintf(fd, "type %s\n", typeNames[t].c_str());
+  for (int k = 0; k < NUM_KINDS; k++)
+  {
+    saveArray(fd, "count", kindName[k], count[k]);
+    saveArray(fd, "weight", kindName[k], weight[k]);
+    saveArray(fd, "weight_sq", kindName[k], weightSq[k]);
+  }
+  for (int k = 0; k < 2; k++)
+    for (int yr = 0; yr < years; yr++)
+    {
+      fprintf(fd, "type_count %s %d", kindName[k + 1], yr);
+      for (double value : typeCount[k][yr])
+        fprintf(fd, " %.17g", value);
+      fprintf(fd, "\n");
+      if (!weighted) continue;
+      fprintf(fd, "type_weight_sq %s %d", kindName[k + 1], yr);
+      for (double value : typeWeightSq[k][yr])
+        fprintf(fd, " %.17g", value);
+      fprintf(fd, "\n");
+    }
+  fclose(fd);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// "count"/"weight"/"weight_sq" kind values...
+static bool loadArray(char *rest, std::vector<double> *values)
+{
+  for (size_t i = 0; i < values->size(); i++)
+  {
+    char *end;
+    (*values)[i] = strtod(rest, &end);
+    if (end == rest) return false;
+    rest = end;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+static int findKind(const char *name)
+{
+  for (int k = 0; k < RunResult::NUM_KINDS; k++)
+    if (strcmp(name, kindName[k]) == 0) return k;
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+bool RunResult::load(const char *fileName)
+{
+  FILE *fd = fopen(fileName, "r");
+  if (fd == NULL) return false;
+  char line[65536];
+  int version = 0;
+  if ((fgets(line, sizeof(line), fd) == NULL) ||
+      (strncmp(line, RESULT_MAGIC, strlen(RESULT_MAGIC)) != 0) ||
+      (sscanf(line + strlen(RESULT_MAGIC), "%d", &version) != 1) ||
+      (version != RESULT_VERSION))
+  {
+    fclose(fd);
+    return false;
+  }
+
+  bool ok = true;
+  int typeCnt = -1;
+  while (ok && (fgets(line, sizeof(line), fd) != NULL))
+  {
+    line[strcspn(line, "\n")] = '\0';
+    char *rest = strchr(line, ' ');
+    if (rest == NULL) continue;
+    *rest++ = '\0';
+    const std::string key = line;
+    if (key == "system_id") systemID = atoi(rest);
+    else if (key == "system") system = rest;
+    else if (key == "seed") seed = rest;
+    else if (key == "module") module = atoi(rest);
+    else if (key == "dram") dram = rest;
+    else if (key == "params") params = rest;
+    else if (key == "options") options = rest;
+    else if (key == "trials") trials = atol(rest);
+    else if (key == "weighted") weighted = atoi(rest) != 0;
+    else if (key == "years") years = atoi(rest);
+    else if (key == "types")
+    {
+      typeCnt = atoi(rest);
+      ok = (years > 0) && (typeCnt >= 0);
+      if (ok) resize(years, typeCnt);
+      typeNames.clear();
+    }
+    else if (key == "type")
+    {
+      ok = (int)typeNames.size() < typeCnt;
+      if (ok) typeNames.push_back(rest);
+    }
+    else if ((key == "count") || (key == "weight") || (key == "weight_sq"))
+    {
+      char *value = strchr(rest, ' ');
+      ok = (typeCnt >= 0) && (value != NULL);
+      if (!ok) break;
+      *value++ = '\0';
+      int k = findKind(rest);
+      ok = (k >= 0) &&
+           loadArray(value, (key == "count") ? &count[k]
+                            : (key == "weight") ? &weight[k] : &weightSq[k]);
+    }
+    else if ((key == "type_count") || (key == "type_weight_sq"))
+    {
+      char kind[16];
+      int yr, used;
+      ok = (typeCnt >= 0) &&
+           (sscanf(rest, "%15s %d%n", kind, &yr, &used) == 2) &&
+           (yr >= 0) && (yr < years);
+      int k = ok ? findKind(kind) - 1 : -1;
+      ok = ok && (k >= 0) &&
+           loadArray(rest + used, (key == "type_count") ? &typeCount[k][yr]
+                                                        : &typeWeightSq[k][yr]);
+    }
+  }
+  fclose(fd);
+  return ok && (typeCnt >= 0) && ((int)typeNames.size() == typeCnt);
+}
+
+//------------------------------------------------------------------------------
+// .result files of "path", or "path" itself if it is not a directory
+static void listResults(const std::string &path, std::vector<std::string> *files)
+{
+  DIR *dir = opendir(path.c_str());
+  if (dir == NULL)
+  {
+    files->push_back(path);
+    return;
+  }
+  std::vector<std::string> names;
+  struct dirent *entry;
+  while ((entry = readdir(dir)) != NULL)
+  {
+    std::string name = entry->d_name;
+    if ((name.size() > 7) &&
+        (name.compare(name.size() - 7, 7, ".result") == 0))
+      names.push_back(path + "/" + name);
+  }
+  closedir(dir);
+  std::sort(names.begin(), names.end());
+  files->insert(files->end(), names.begin(), names.end());
+}
+
+//------------------------------------------------------------------------------
+// one row of the report
+static void printRow(FILE *out, const char *prefix, const char *metric,
+                     const char *faultType, int yr,
+                     double estimate, const Interval &ci)
+{
+  fprintf(out, "%s,%s,%s,%d,%.11e,%.11e,%.11e\n", prefix, metric, faultType,
+          yr, estimate, ci.lo, ci.hi);
+}
+
+//------------------------------------------------------------------------------
+bool reportResults(const std::vector<std::string> &paths, int jobs, FILE *out)
+{
+  std::vector<std::string> files;
+  for (const std::string &path : paths)
+    listResults(path, &files);
+
+  // load the files in parallel; each thread claims the next file
+  std::vector<RunResult> results(files.size());
+  std::vector<char> loaded(files.size(), 0);
+  std::atomic<size_t> next(0);
+  auto worker = [&]() {
+    for (size_t i = next++; i < files.size(); i = next++)
+      loaded[i] = results[i].load(files[i].c_str());
+  };
+  jobs = std::max(1, std::min(jobs, (int)files.size()));
+  std::vector<std::thread> threads;
+  for (int j = 1; j < jobs; j++)
+    threads.push_back(std::thread(worker));
+  worker();
+  for (auto &thread : threads)
+    thread.join();
+
+  // merge the seeds of each system, module, DRAM type, rates and options
+  struct Group {
+    RunResult merged;
+    int files = 0;
+    std::set<std::string> seeds;
+  };
+  std::map<std::string, Group> groups;
+  int loadedCnt = 0;
+  for (size_t i = 0; i < files.size(); i++)
+  {
+    if (!loaded[i])
+    {
+      fprintf(stderr, "Skipping %s: not a result file\n", files[i].c_str());
+      continue;
+    }
+    loadedCnt++;
+    Group &group = groups[results[i].groupKey()];
+    if (group.files == 0)
+    {
+      group.merged = results[i];
+    }
+    else if (!group.merged.merge(results[i]))
+    {
+      fprintf(stderr, "Skipping %s: other years or fault types than the "
+              "rest of its group\n", files[i].c_str());
+      continue;
+    }
+    if (!group.seeds.insert(results[i].seed).second)
+      fprintf(stderr, "%s repeats seed %s of its group\n", files[i].c_str(),
+              results[i].seed.c_str());
+    group.files++;
+  }
+
+  fprintf(out, "system_id,system,module,dram,params,options,files,seeds,"
+          "trials,weighted,metric,fault_type,year,estimate,ci_lo,ci_hi\n");
+  for (auto it = groups.begin(); it != groups.end(); ++it)
+  {
+    const Group &group = it->second;
+    const RunResult &merged = group.merged;
+    std::string seeds;
+    for (const std::string &seed : group.seeds)
+      seeds += (seeds.empty() ? "" : ";") + seed;
+    char prefix[1024];
+    // the option values hold commas (e.g. --rate-profile 0:3,8760:1)
+    snprintf(prefix, sizeof(prefix), "%d,%s,%d,%s,%s,\"%s\",%d,%s,%ld,%d",
+             merged.systemID, merged.system.c_str(), merged.module,
+             merged.dram.c_str(), merged.params.c_str(),
+             merged.options.c_str(), group.files, seeds.c_str(),
+             merged.trials, merged.weighted);
+    double n = merged.trials;
+
+    // probability of each outcome by the end of each year
+    for (int k = 0; k < RunResult::NUM_KINDS; k++)
+    {
+      for (int yr = 1; yr < merged.years; yr++)
+      {
+        if (merged.weighted)
+        {
+          Interval ci = weightedInterval(merged.weight[k][yr],
+                                         merged.weightSq[k][yr], n);
+          printRow(out, prefix, kindName[k], "ALL", yr,
+                   (n > 0) ? merged.weight[k][yr] / n : 0., ci);
+        }
+        else
+        {
+          printRow(out, prefix, kindName[k], "ALL", yr,
+                   (n > 0) ? merged.count[k][yr] / n : 0.,
+                   wilsonInterval(merged.count[k][yr], n));
+        }
+      }
+    }
+    // share of the DUE/SDC runs attributed to each fault type; when
+    // weighted, the ratio of the type's weight to the outcome's, with the
+    // interval of the type's probability scaled by the outcome estimate
+    for (int k = 0; k < 2; k++)
+    {
+      std::string metric = std::string(kindName[k + 1]) + "_SHARE";
+      for (int yr = 1; yr < merged.years; yr++)
+      {
+        double cnt = merged.weighted ? merged.weight[k + 1][yr]
+                                     : merged.count[k + 1][yr];
+        if (cnt <= 0) continue;
+        for (size_t t = 0; t < merged.typeNames.size(); t++)
+        {
+          double share = merged.typeCount[k][yr][t];
+          if (share <= 0) continue;
+          Interval ci;
+          if (merged.weighted)
+          {
+            ci = weightedInterval(share, merged.typeWeightSq[k][yr][t], n);
+            ci.lo *= n / cnt;
+            ci.hi *= n / cnt;
+          }
+          else
+          {
+            ci = wilsonInterval(share, cnt);
+          }
+          printRow(out, prefix, metric.c_str(),
+                   merged.typeNames[t].c_str(), yr, share / cnt, ci);
+        }
+      }
+    }
+  }
+  return loadedCnt > 0;
+}
@@ -0,0 +1,106 @@
+/*
+Copyright 2023, The University of Texas at Austin
+All rights reserved.
+
+THIS FILE IS PART OF THE DRAM FAULT ERROR SIMULATION FRAMEWORK
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * @file: RunResult.hh
+ * @brief Machine-readable results of a system-level simulation
+ * @details TesterSystem::finish() writes the counters behind the .S summary
+ * next to it as "<log>.result": the Retire/DUE/SDC run counts and weight
+ * sums per year and the attribution of the DUE/SDC runs to fault types.
+ * "faulterrorsim report" loads such files (in parallel), merges the runs of
+ * the same system, module, DRAM type, rates and model options across seeds,
+ * and writes one long-format CSV table of the estimates and their 95%
+ * intervals.
+ */
+
+#ifndef __RUN_RESULT_HH__
+#define __RUN_RESULT_HH__
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+/** @class RunResult
+ * \brief Counters of one simulation (or of the merge of several)
+ */
+struct RunResult {
+  static const int NUM_KINDS = 3;  //!< Retire, DUE, SDC
+
+  // what was simulated
+  int systemID = -1;
+  std::string system;  //!< output prefix of the system (without the seed)
+  std::string seed;
+  int module = 0;
+  std::string dram;
+  std::string params;  //!< rate arguments, e.g. "S.i9.0.1e-5.1e-5"
+  //! options that change the simulated model, e.g. "--rate-profile 0:3,8760:1"
+  std::string options;
+
+  long trials = 0;
+  bool weighted = false;  //!< importance sampling, splitting or conditional
+  int years = 0;          //!< entries per year array (index 0 is unused)
+  //! [kind][year]: runs failing before the end of the year
+  std::vector<double> count[NUM_KINDS];
+  //! [kind][year]: sums of the run weights and of their squares
+  std::vector<double> weight[NUM_KINDS];
+  std::vector<double> weightSq[NUM_KINDS];
+  //! fault type names and [DUE/SDC][year][type] attributed runs (when
+  //! weighted, sums of their weights and of the squared weights)
+  std::vector<std::string> typeNames;
+  std::vector<std::vector<double>> typeCount[2];
+  std::vector<std::vector<double>> typeWeightSq[2];
+
+  void resize(int years, int typeCount);
+  //! add the counters of another result with the same years and types
+  bool merge(const RunResult &other);
+  //! key of the runs that report merges (all but the seed)
+  std::string groupKey() const;
+
+  //! text format: "key value..." per line
+  bool save(const char *fileName) const;
+  bool load(const char *fileName);
+};
+
+//! "faulterrorsim report": merge the .result files (and the .result files
+//! of the directories) in "paths" with "jobs" threads and write the CSV
+//! table to "out"; false if no file could be read
+bool reportResults(const std::vector<std::string> &paths, int jobs,
+                   FILE *out);
+
+#endif /* __RUN_RESULT_HH__ */
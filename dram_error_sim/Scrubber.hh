@@ -46,17 +46,29 @@ POSSIBILITY OF SUCH DAMAGE.
 #ifndef __SCRUBBER_HH__
 #define __SCRUBBER_HH__
 
+#include <math.h>
+
 #include "DomainGroup.hh"
+#include "Fault.hh"
 
 /** @class Scrubber
  * \brief Parent scrubber class
+ * @details A scrubber decides when a transient fault is removed. Each
+ * transient fault is stamped with its scrub deadline when injected, and
+ * FaultDomain::expireTransients() drops expired faults lazily, when the domain
+ * is next picked. Domains without transient faults are never visited.
  */
 class Scrubber {
  public:
   Scrubber() {}
+  virtual ~Scrubber() {}
 
  public:
-  virtual void scrub(DomainGroup *dg, double hrs) = 0;
+  //! time (hours) from which a transient "fault" injected at "hrs" is gone
+  virtual double getDeadline(Fault *fault, double hrs) = 0;
+  //! smallest time shift that leaves all deadlines unchanged (relative to
+  //! the injection time), 0 if any shift does
+  virtual double getPeriod() { return 0.; }
 };
 
 /** @class NoScrubber
@@ -66,27 +78,56 @@ class NoScrubber : public Scrubber {
  public:
   NoScrubber() {}
 
-  void scrub(DomainGroup *dg, double hrs) { return; }
+  double getDeadline(Fault *fault, double hrs) { return INFINITY; }
 };
 
 /** @class PeriodicScrubber
  * \brief Periodic scrubber class
+ * @details The whole memory is scrubbed at every multiple of the period, so
+ * a transient fault lives until the end of its scrubbing section.
  */
 class PeriodicScrubber : public Scrubber {
  public:
-  PeriodicScrubber(double _period) : period(_period), prevScrubSection(0) {}
-  //!< scrubbing at domain group "dg" after "hrs"
-  void scrub(DomainGroup *dg, double hrs) {
-    int curScrubSection = (int)hrs / period;
-    if (curScrubSection != prevScrubSection) {
-      dg->scrub();
-      prevScrubSection = curScrubSection;
-    }
+  PeriodicScrubber(double _period) : period(_period) {}
+  double getDeadline(Fault *fault, double hrs) {
+    return (floor(hrs / period) + 1) * period;
   }
 
+  double getPeriod() { return period; }
+
  protected:
   double period;         //!< scrubbing period
-  int prevScrubSection;  //!< previously scrubbed section
+};
+
+/** @class PatrolScrubber
+ * \brief Patrol scrubber class
+ * @details The scrubber walks through the address space once per period, so
+ * each address is scrubbed at its own phase within the period.
+ */
+class PatrolScrubber : public Scrubber {
+ public:
+  PatrolScrubber(double _period) : period(_period) {}
+  double getDeadline(Fault *fault, double hrs) {
+    // position of the fault in the patrol sweep
+    double phase = period * (double)(fault->getAddr() & 0xFFFFF) / 0x100000;
+    return phase + (floor((hrs - phase) / period) + 1) * period;
+  }
+
+  double getPeriod() { return period; }
+
+ protected:
+  double period;         //!< time to patrol the whole memory
+};
+
+/** @class DemandScrubber
+ * \brief Demand scrubber class
+ * @details Corrected data is written back on the access that detected it, so
+ * a transient fault never outlives the event that injected it.
+ */
+class DemandScrubber : public Scrubber {
+ public:
+  DemandScrubber() {}
+  double getDeadline(Fault *fault, double hrs) { return hrs; }
 };
 
 #endif /* __SCRUBBER_HH__ */
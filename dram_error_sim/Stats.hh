@@ -0,0 +1,102 @@
+/*
+Copyright 2023, The University of Texas at Austin
+All rights reserved.
+
+THIS FILE IS PART OF THE DRAM FAULT ERROR SIMULATION FRAMEWORK
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * @file: Stats.hh
+ * @brief Confidence intervals of the Monte Carlo estimates
+ */
+
+#ifndef __STATS_HH__
+#define __STATS_HH__
+
+#include <math.h>
+
+//! z of the two-sided 95% confidence level
+const double CONFIDENCE_Z = 1.959963985;
+
+/** @class Interval
+ * \brief Two-sided confidence interval of an estimate
+ */
+struct Interval {
+  double lo;
+  double hi;
+
+  double halfWidth() const { return (hi - lo) / 2; }
+  //! whether the half width is within "relError" of "estimate"
+  //! (estimates of zero only have an upper bound, see zeroNegligible())
+  bool precise(double estimate, double relError) const {
+    return (estimate <= 0) || (halfWidth() <= relError * estimate);
+  }
+};
+
+//! whether an outcome without any hit in "n" trials is settled: its
+//! rule-of-three 95% upper bound 3/n is within "relError" of "scale"
+inline bool zeroNegligible(double n, double scale, double relError) {
+  return (n > 0) && (3. / n <= relError * scale);
+}
+
+//! Wilson score interval of a proportion, "k" hits out of "n" trials
+inline Interval wilsonInterval(double k, double n, double z = CONFIDENCE_Z) {
+  Interval ci = {0., 1.};
+  if (n <= 0) return ci;
+  double p = k / n;
+  double z2 = z * z;
+  double denom = 1 + z2 / n;
+  double center = (p + z2 / (2 * n)) / denom;
+  double half = z * sqrt(p * (1 - p) / n + z2 / (4 * n * n)) / denom;
+  ci.lo = fmax(0., center - half);
+  ci.hi = fmin(1., center + half);
+  return ci;
+}
+
+//! normal interval of a weighted mean from the sums of the weights and of
+//! their squares over "n" trials
+inline Interval weightedInterval(double sum, double sqSum, double n,
+                                 double z = CONFIDENCE_Z) {
+  Interval ci = {0., 0.};
+  if (n <= 1) return ci;
+  double mean = sum / n;
+  double var = sqSum / n - mean * mean;
+  double half = (var > 0) ? z * sqrt(var / (n - 1)) : 0.;
+  ci.lo = mean - half;
+  ci.hi = mean + half;
+  return ci;
+}
+
+#endif /* __STATS_HH__ */
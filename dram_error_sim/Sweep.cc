@@ -0,0 +1,262 @@
+/*
+Copyright 2023, The University of Texas at Austin
+All rights reserved.
+
+THIS FILE IS PART OF THE DRAM FAULT ERROR SIMULATION FRAMEWORK
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * @file: Sweep.cc
+ * @brief Parameter sweeps of system evaluations on a pool of workers
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <sstream>
+
+#include "RunResult.hh"
+#include "Sweep.hh"
+
+//------------------------------------------------------------------------------
+bool SweepSpec::load(const char *fileName)
+{
+  FILE *fd = fopen(fileName, "r");
+  if (fd == NULL)
+  {
+    printf("Cannot open the sweep spec %s\n", fileName);
+    return false;
+  }
+  char line[4096];
+  int lineNumber = 0;
+  bool ok = true;
+  while (fgets(line, sizeof(line), fd) != NULL)
+  {
+    lineNumber++;
+    char *comment = strchr(line, '#');
+    if (comment != NULL) *comment = '\0';
+    std::istringstream words(line);
+    std::string key, word;
+    if (!(words >> key)) continue;
+    std::vector<std::string> values;
+    while (words >> word)
+      values.push_back(word);
+
+    if (key == "ids") ids.insert(ids.end(), values.begin(), values.end());
+    else if (key == "modules")
+      modules.insert(modules.end(), values.begin(), values.end());
+    else if (key == "dram")
+      drams.insert(drams.end(), values.begin(), values.end());
+    else if (key == "seeds")
+      seeds.insert(seeds.end(), values.begin(), values.end());
+    else if ((key == "runs") && (values.size() == 1)) runs = values[0];
+    else if ((key == "rates") && (values.size() == 4)) rates.push_back(values);
+    else if (key == "options")
+      options.insert(options.end(), values.begin(), values.end());
+    else
+    {
+      printf("%s:%d: unknown key or wrong number of values\n", fileName,
+             lineNumber);
+      ok = false;
+    }
+  }
+  fclose(fd);
+  if (ok && (ids.empty() || modules.empty() || drams.empty() ||
+             seeds.empty() || runs.empty() || rates.empty()))
+  {
+    printf("%s: ids, modules, dram, seeds, runs and rates are required\n",
+           fileName);
+    ok = false;
+  }
+  return ok;
+}
+
+//------------------------------------------------------------------------------
+std::vector<std::vector<std::string>> SweepSpec::expand() const
+{
+  std::vector<std::vector<std::string>> jobs;
+  for (const std::string &dram : drams)
+    for (const std::string &module : modules)
+      for (const std::string &id : ids)
+        for (const std::vector<std::string> &rate : rates)
+          for (const std::string &seed : seeds)
+          {
+            std::vector<std::string> args = {id, runs, seed, "S"};
+            args.insert(args.end(), rate.begin(), rate.end());
+            args.push_back(module);
+            args.push_back(dram);
+            args.insert(args.end(), options.begin(), options.end());
+            jobs.push_back(args);
+          }
+  return jobs;
+}
+
+//------------------------------------------------------------------------------
+// output file of a job: its positional arguments joined with '_'
+static std::string jobName(const std::vector<std::string> &args)
+{
+  std::string name;
+  for (size_t i = 0; i < args.size(); i++)
+  {
+    if ((args[i] == "S") || (args[i].compare(0, 2, "--") == 0)) continue;
+    if (!name.empty()) name += "_";
+    name += args[i];
+  }
+  return name;
+}
+
+//------------------------------------------------------------------------------
+// directory of a job: the log names tell neither the DRAM type nor modules
+// above 3 apart, so every DRAM type and module gets its own
+static std::string jobDir(const std::string &outDir,
+                          const std::vector<std::string> &args)
+{
+  return outDir + "/" + args[9] + "_module" + args[8];
+}
+
+//------------------------------------------------------------------------------
+// child: run one job in its directory, with stdout in its output file
+static void runJob(const std::string &dir,
+                   const std::vector<std::string> &args, const char *argv0,
+                   int (*simulate)(int argc, char **argv))
+{
+  if (chdir(dir.c_str()) != 0) _exit(1);
+  std::string output = jobName(args) + ".txt";
+  if (freopen(output.c_str(), "w", stdout) == NULL) _exit(1);
+  std::vector<char *> argv;
+  argv.push_back(const_cast<char *>(argv0));
+  for (const std::string &arg : args)
+    argv.push_back(const_cast<char *>(arg.c_str()));
+  argv.push_back(NULL);
+  int status = simulate(argv.size() - 1, argv.data());
+  fflush(stdout);
+  _exit(status);
+}
+
+//------------------------------------------------------------------------------
+int runSweep(const SweepSpec &spec, int jobs, const std::string &outDir,
+             const char *argv0, int (*simulate)(int argc, char **argv))
+{
+  std::vector<std::vector<std::string>> jobList = spec.expand();
+  std::vector<std::string> dirs;
+  if ((mkdir(outDir.c_str(), 0755) != 0) && (errno != EEXIST))
+  {
+    printf("Cannot create %s\n", outDir.c_str());
+    return jobList.size();
+  }
+  // module 4 reads its rates from input_FIT.conf in the working directory
+  char fitPath[PATH_MAX];
+  bool haveFit = realpath("input_FIT.conf", fitPath) != NULL;
+  for (const std::vector<std::string> &args : jobList)
+  {
+    std::string dir = jobDir(outDir, args);
+    if (std::find(dirs.begin(), dirs.end(), dir) != dirs.end()) continue;
+    dirs.push_back(dir);
+    if ((mkdir(dir.c_str(), 0755) != 0) && (errno != EEXIST))
+    {
+      printf("Cannot create %s\n", dir.c_str());
+      return jobList.size();
+    }
+    std::string fitLink = dir + "/input_FIT.conf";
+    if (haveFit && (access(fitLink.c_str(), F_OK) != 0) &&
+        (symlink(fitPath, fitLink.c_str()) != 0))
+      printf("Cannot link input_FIT.conf into %s\n", dir.c_str());
+  }
+
+  printf("Sweep: %zu jobs on %d workers in %s\n", jobList.size(), jobs,
+         outDir.c_str());
+  fflush(stdout);
+  auto start = std::chrono::steady_clock::now();
+  std::map<pid_t, size_t> running;
+  size_t next = 0, done = 0;
+  int failed = 0;
+  while (done < jobList.size())
+  {
+    // fill every free worker, then block until one of them exits
+    while ((next < jobList.size()) && ((int)running.size() < jobs))
+    {
+      fflush(stdout);
+      pid_t pid = fork();
+      if (pid == 0)
+        runJob(jobDir(outDir, jobList[next]), jobList[next], argv0, simulate);
+      if (pid < 0)
+      {
+        printf("fork failed for %s\n", jobName(jobList[next]).c_str());
+        failed++;
+        done++;
+      }
+      else
+      {
+        running[pid] = next;
+      }
+      next++;
+    }
+    if (running.empty()) continue;
+    int status;
+    pid_t pid = wait(&status);
+    if (pid < 0)
+    {
+      if (errno == EINTR) continue;
+      break;
+    }
+    auto it = running.find(pid);
+    if (it == running.end()) continue;
+    bool ok = WIFEXITED(status) && (WEXITSTATUS(status) == 0);
+    done++;
+    failed += !ok;
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start).count();
+    printf("[%zu/%zu %.0fs] %s %s\n", done, jobList.size(), seconds,
+           jobName(jobList[it->second]).c_str(), ok ? "done" : "FAILED");
+    fflush(stdout);
+    running.erase(it);
+  }
+
+  // one table of every job (see RunResult.hh)
+  std::string table = outDir + "/sweep.csv";
+  FILE *out = fopen(table.c_str(), "w");
+  if ((out != NULL) && reportResults(dirs, jobs, out))
+    printf("Results: %s\n", table.c_str());
+  if (out != NULL) fclose(out);
+  return failed;
+}
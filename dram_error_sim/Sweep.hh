@@ -0,0 +1,91 @@
+/*
+Copyright 2023, The University of Texas at Austin
+All rights reserved.
+
+THIS FILE IS PART OF THE DRAM FAULT ERROR SIMULATION FRAMEWORK
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * @file: Sweep.hh
+ * @brief Parameter sweeps of system evaluations on a pool of workers
+ * @details A sweep spec lists the values of each parameter of
+ *   faulterrorsim ID runs seed S Rate1 Rate2 Rate3 Rate4 module DRAMTYPE
+ * and the sweep runs every combination. The simulator keeps its DRAM
+ * configuration and random number generator in process-wide globals, so
+ * each job runs in a child process forked from the sweep; up to "jobs"
+ * children run at a time and the next job starts as soon as one exits.
+ * Spec format, one "key value..." per line ('#' starts a comment):
+ *   ids 5001 5002           system IDs
+ *   modules 0 1 2 4
+ *   dram DDR5 HBM3
+ *   seeds 0 1
+ *   runs 1000000
+ *   rates i9 0 1e-5 1e-5    one line per set of the four rate arguments
+ *   options --conditional 1 extra options of every job (optional)
+ */
+
+#ifndef __SWEEP_HH__
+#define __SWEEP_HH__
+
+#include <string>
+#include <vector>
+
+/** @class SweepSpec
+ * \brief Values of each parameter of a sweep
+ */
+struct SweepSpec {
+  std::vector<std::string> ids;
+  std::vector<std::string> modules;
+  std::vector<std::string> drams;
+  std::vector<std::string> seeds;
+  std::string runs;
+  std::vector<std::vector<std::string>> rates;
+  std::vector<std::string> options;
+
+  //! false (after printing why) if the file is missing or incomplete
+  bool load(const char *fileName);
+  //! arguments of every job: ID runs seed S Rate1..4 module DRAMTYPE options
+  std::vector<std::vector<std::string>> expand() const;
+};
+
+//! run the jobs of "spec", at most "jobs" at a time; "simulate" is called
+//! with the arguments of a job (argv[0] first) in the child. Each job
+//! writes its stdout to "<job>.txt" and its .S, .hist and .result files to
+//! "<outDir>/<DRAMTYPE>_module<module>"; the results of all of them are then
+//! merged into "<outDir>/sweep.csv". Returns the number of failed jobs.
+int runSweep(const SweepSpec &spec, int jobs, const std::string &outDir,
+             const char *argv0, int (*simulate)(int argc, char **argv));
+
+#endif /* __SWEEP_HH__ */
@@ -0,0 +1,1602 @@
+/*
+Copyright 2023, The University of Texas at Austin
+All rights reserved.
+
+THIS FILE IS PART OF THE DRAM FAULT ERROR SIMULATION FRAMEWORK
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * @file: Systems.cc
+ * @brief Target systems (DomainGroup geometry + ECC) by system ID
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include "Config.hh"
+#include "DomainGroup.hh"
+#include "Scrubber.hh"
+#include "Systems.hh"
+#include "message.hh"
+
+#include "Bamboo.hh"
+#include "DUO.hh"
+#include "Huawei.hh"
+#include "REGB.hh"
+#include "XED.hh"
+#include "prior.hh"
+#include "FlipCorrection.hh"
+
+// #define BAMBOO
+#define AGECC
+
+// Bundled presets. DIMMcnt (2) is already divided out of the domain counts.
+#ifdef BAMBOO
+static const char *presets = R"(
+# bit-level
+system 0 000.4x16.None
+group 1 2 16 4 8
+ecc ECCNone
+
+system 1 001.4x18.SECDED72b
+group 1 2 18 4 8
+ecc SECDED72b
+
+system 2 002.4x17.SPC66bx4
+group 1 2 17 4 8
+ecc SPC66bx4
+
+system 3 003.4x17.SPCTPD68bx4
+group 1 2 17 4 8
+ecc SPCTPD68bx4
+
+# chip-level
+system 10 010.4x18.AMD
+group 1 2 18 4 8
+ecc AMDChipkill72b true
+
+system 11 011.4x18.QPC
+group 1 2 18 4 8
+ecc QPC72b
+
+system 20 020.4x36.DAMD
+group 1 2 36 4 8
+ecc AMDDChipkill144b
+
+system 21 021.4x36.OPC
+group 1 2 36 4 8
+ecc OPC144b
+
+# bit-level
+system 30 030.9x8.SECDED72b
+group 1 2 9 8 8
+ecc SECDED72b
+
+system 40 040.8x18.S8SC
+group 0 2 18 8 8
+ecc S8SC144b
+
+system 41 041.8x18.OPC
+group 0 2 18 8 8
+ecc OPC144b
+
+# EGB
+system 50 050.4x18.QPC41
+group 1 2 18 4 8
+ecc QPC72b 4 1
+
+# EGB
+system 51 051.4x18.QPC42
+group 1 2 18 4 8
+ecc QPC72b 4 2
+
+# EGB
+system 52 052.4x18.QPC43
+group 1 2 18 4 8
+ecc QPC72b 4 3
+
+# EGB
+system 53 053.4x18.QPC44
+group 1 2 18 4 8
+ecc QPC72b 4 4
+
+system 60 060.19x4.QPC76b
+group 1 2 19 4 8
+ecc QPC76b
+)";
+#endif
+#ifdef AGECC
+static const char *presets = R"(
+# None
+system 0 000.4x16.None
+group 1 2 16 4 8
+ecc ECCNone
+
+# None
+system 1 001.4x18.None
+group 1 2 18 4 8
+ecc ECCNone
+
+# Zero EGB
+system 2 002.4x18.SECDED72b
+group 1 2 18 4 8
+ecc SECDED72b
+
+# Zero EGB + post-processing
+system 9 009.4x18.AMD
+group 1 2 18 4 8
+ecc AMDChipkill72b true
+
+# Zero EGB + no post-processing
+system 10 010.4x18.AMD2
+group 1 2 18 4 8
+ecc AMDChipkill72b false
+
+system 11 011_simplemodel.4x18.AMD2
+group 1 2 18 4 8
+msg 8 8 0 0 1 4 18 0 EXTRACHIP
+detailed 0
+ecc AMDChipkill72b false
+max_retired 0
+
+system 12 012_newmodel.4x18.AMD2
+group 1 2 18 4 8
+msg 8 8 0 0 1 4 18 0 EXTRACHIP
+ecc AMDChipkill72b false
+max_retired 0
+
+# EGB
+system 20 020.4x18.QPC41
+group 1 2 18 4 8
+ecc QPC72b 4 1
+
+# EGB
+system 21 021.4x18.QPC42
+group 1 2 18 4 8
+ecc QPC72b 4 2
+
+# EGB
+system 22 022.4x18.QPC43
+group 1 2 18 4 8
+ecc QPC72b 4 3
+
+# EGB
+system 23 023.4x18.QPC44
+group 1 2 18 4 8
+ecc QPC72b 4 4
+
+# EGB
+system 24 024.4x18.QPC33
+group 1 2 18 4 8
+ecc QPC72b 3 3
+
+# EGB
+system 25 025.4x18.QPC22
+group 1 2 18 4 8
+ecc QPC72b 2 2
+
+# on-chip ECC
+system 100 100.4x16.OnChip
+group 1 2 16 4 18
+ecc OnChip64b
+
+# on-chip ECC + SEC-DED
+system 110 110.4x18.OnChip+SECDED
+group 1 2 18 4 18
+ecc OnChip72bSECDED
+
+# on-chip ECC + AMD (w/ postprocessing)
+system 111 111.4x18.OnChip+AMD
+group 1 2 18 4 18
+ecc OnChip72bAMD true
+
+# on-chip ECC + AMD (w/o postprocessing)
+system 112 112.4x18.OnChip+AMD2
+group 1 2 18 4 18
+ecc OnChip72bAMD false
+
+# on-chip ECC + QPC
+system 113 113.4x18.OnChip+QPC42
+group 1 2 18 4 18
+ecc OnChip72bQPC72b 4 2
+
+# on-chip ECC + QPC
+system 114 114.4x18.OnChip+QPC43
+group 1 2 18 4 18
+ecc OnChip72bQPC72b 4 3
+
+# on-chip ECC + QPC
+system 115 115.4x18.OnChip+QPC44
+group 1 2 18 4 18
+ecc OnChip72bQPC72b 4 4
+
+# on-chip ECC + QPC
+system 116 116.4x18.OnChip+QPC33
+group 1 2 18 4 18
+ecc OnChip72bQPC72b 3 3
+
+# on-chip ECC + QPC
+system 117 117.4x18.OnChip+QPC22
+group 1 2 18 4 18
+ecc OnChip72bQPC72b 2 2
+
+system 130 130.4x9.XED_SDDC
+group 1 2 9 4 18
+ecc XED_SDDC true
+
+system 132 132.4x9.XED_SDDC
+group 1 2 9 4 18
+ecc XED_SDDC false
+
+system 140 140.4x18.QPC_REGB
+group 1 2 18 4 8
+ecc QPC72bREGB true true
+
+system 141 141.4x18.QPC_REGB
+group 1 2 18 4 8
+ecc QPC72bREGB true false
+
+# Zero EGB + post-processing
+system 200 200.4x18.AMD
+group 0 2 18 4 8
+ecc AMDChipkill72b true
+
+# Zero EGB + post-processing
+system 201 201.4x18.AMD
+group 0 2 18 4 8
+ecc AMDChipkill72b true
+max_retired 0
+
+# Zero EGB + post-processing
+system 202 202.4x18.AMD
+group 0 2 18 4 8
+ecc AMDChipkill72b true
+max_retired 64
+
+# Zero EGB + post-processing
+system 203 203.4x18.AMD
+group 0 2 18 4 8
+ecc AMDChipkill72b true
+max_retired 2048
+
+# Zero EGB + post-processing
+system 204 204.4x18.AMD
+group 0 2 18 4 8
+ecc AMDChipkill72b true
+max_retired 16384
+
+# Zero EGB + post-processing
+system 205 205.4x5.AMD
+group 0 2 6 4 32
+ecc AMDChipkill20b false
+max_retired 16384
+
+# on-chip ECC + AMD (w/ postprocessing)
+system 210 210.4x18.OnChip+AMD
+group 1 2 18 4 18
+ecc OnChip72bAMD true
+
+# on-chip ECC + AMD (w/ postprocessing)
+system 211 211.4x18.OnChip+AMD
+group 1 2 18 4 18
+ecc OnChip72bAMD true
+max_retired 0
+
+# on-chip ECC + AMD (w/ postprocessing)
+system 212 212.4x18.OnChip+AMD
+group 1 2 18 4 18
+ecc OnChip72bAMD true
+max_retired 32
+
+# on-chip ECC + AMD (w/ postprocessing)
+system 213 213.4x18.OnChip+AMD
+group 1 2 18 4 18
+ecc OnChip72bAMD true
+max_retired 1024
+
+# on-chip ECC + AMD (w/ postprocessing)
+system 214 214.4x18.OnChip+AMD
+group 1 2 18 4 18
+ecc OnChip72bAMD true
+max_retired 2048
+
+# on-chip ECC + AMD (w/ postprocessing)
+system 215 215.4x18.OnChip+AMD
+group 1 2 18 4 18
+ecc OnChip72bAMD true
+max_retired 4096
+
+# on-chip ECC + AMD (w/ postprocessing)
+system 216 216.4x18.OnChip+AMD
+group 0 2 18 4 18
+ecc OnChip72bAMD true
+max_retired 524288
+
+system 220 220.4x18.XED_DDDC
+group 1 2 18 4 18
+ecc XED_DDDC true
+
+system 221 221.4x18.XED_DDDC
+group 1 2 18 4 18
+ecc XED_DDDC true
+max_retired 0
+
+system 222 222.4x18.XED_DDDC
+group 1 2 18 4 18
+ecc XED_DDDC true
+max_retired 32
+
+system 223 223.4x18.XED_DDDC
+group 1 2 18 4 18
+ecc XED_DDDC true
+max_retired 1024
+
+system 224 224.4x18.XED_DDDC
+group 1 2 18 4 18
+ecc XED_DDDC true
+max_retired 8192
+
+system 230 230.4x18.QPC_REGB
+group 1 2 18 4 8
+ecc QPC72bREGB true true
+retire 0
+
+system 231 231.4x18.QPC_REGB
+group 1 2 18 4 8
+ecc QPC72bREGB true true
+max_retired 0
+
+system 232 232.4x18.QPC_REGB
+group 1 2 18 4 8
+ecc QPC72bREGB true true
+max_retired 64
+
+system 233 233.4x18.QPC_REGB
+group 1 2 18 4 8
+ecc QPC72bREGB true true
+max_retired 2048
+
+system 234 234.4x18.QPC_REGB
+group 1 2 18 4 8
+ecc QPC72bREGB true true
+max_retired 16384
+
+system 240 240.4x9.XED_SDDC
+group 1 2 9 4 18
+ecc XED_SDDC true
+
+system 241 241.4x9.XED_SDDC
+group 1 2 9 4 18
+ecc XED_SDDC true
+max_retired 0
+
+system 242 242.4x9.XED_SDDC
+group 1 2 9 4 18
+ecc XED_SDDC true
+max_retired 32
+
+system 243 243.4x9.XED_SDDC
+group 1 2 9 4 18
+ecc XED_SDDC true
+max_retired 1024
+
+system 244 244.4x9.XED_SDDC
+group 1 2 9 4 18
+ecc XED_SDDC true
+max_retired 8192
+
+system 300 300.4x16.DUO
+group 1 2 16 4 9
+ecc DUO64bx4 1
+
+system 301 301.4x16.DUO
+group 1 2 16 4 9
+ecc DUO64bx4 1
+max_retired 0
+
+system 302 302.4x16.DUO
+group 1 2 16 4 9
+ecc DUO64bx4 1
+max_retired 64
+
+system 303 303.4x16.DUO
+group 1 2 16 4 9
+ecc DUO64bx4 1
+max_retired 2048
+
+system 304 304.4x16.DUO
+group 1 2 16 4 9
+ecc DUO64bx4 1
+max_retired 16384
+
+system 310 310.4x16.DUO
+group 1 2 16 4 9
+ecc DUO64bx4 2
+
+system 311 311.4x16.DUO
+group 1 2 16 4 9
+ecc DUO64bx4 2
+max_retired 0
+
+system 312 312.4x16.DUO
+group 1 2 16 4 9
+ecc DUO64bx4 2
+max_retired 64
+
+system 313 313.4x16.DUO
+group 1 2 16 4 9
+ecc DUO64bx4 2
+max_retired 2048
+
+system 314 314.4x16.DUO
+group 1 2 16 4 9
+ecc DUO64bx4 2
+max_retired 16384
+
+system 320 320.4x16.DUO
+group 1 2 16 4 9
+ecc DUO64bx4 3
+
+system 321 321.4x16.DUO
+group 1 2 16 4 9
+ecc DUO64bx4 3
+max_retired 0
+
+system 322 322.4x16.DUO
+group 1 2 16 4 9
+ecc DUO64bx4 3
+max_retired 64
+
+system 323 323.4x16.DUO
+group 1 2 16 4 9
+ecc DUO64bx4 3
+max_retired 2048
+
+system 324 324.4x16.DUO
+group 1 2 16 4 9
+ecc DUO64bx4 3
+max_retired 16384
+
+system 330 330.4x9(BL17).DUO
+group 1 4 9 4 17
+ecc DUO36bx4 6 false false 0
+
+system 331 331.4x9(BL17).DUO
+group 1 4 9 4 17
+ecc DUO36bx4 6 false true 131072
+max_retired 131072
+
+system 332 332.4x9(BL17).DUO
+group 1 4 9 4 17
+ecc DUO36bx4 6 false true 524288
+max_retired 524288
+
+system 333 333.4x9(BL17).DUO.meta1
+group 1 4 9 4 17
+ecc DUO36bx4_meta 6 false true 524288 1
+max_retired 524288
+
+system 334 334.4x9(BL17).DUO.meta2
+group 1 4 9 4 17
+ecc DUO36bx4_meta 6 false true 524288 2
+max_retired 524288
+
+system 335 335.4x9(BL17).DUO.meta3
+group 1 4 9 4 17
+ecc DUO36bx4_meta 6 false true 524288 3
+max_retired 524288
+
+system 340 340.4x9.XED_SDDC
+group 1 4 9 4 18
+ecc XED_SDDC_NC true
+
+system 341 341.4x9.XED_SDDC
+group 1 4 9 4 18
+ecc XED_SDDC_NC true
+max_retired 2048
+
+system 350 350.4x5(BL34).DUO
+group 0 8 5 4 34
+ecc DUO20bx4_34 10 false false 0
+
+system 351 351.4x5(BL34).DUO
+group 0 8 5 4 34
+ecc DUO20bx4_34 10 false true 131072
+
+system 352 352.4x5(BL34).DUO
+group 0 8 5 4 34
+ecc DUO20bx4_34 10 false true 524288
+
+system 353 353.4x5(BL34).DUO.meta1
+group 0 8 5 4 34
+ecc DUO20bx4_34_meta 10 false false 524288 1
+
+system 354 354.4x5(BL34).DUO.meta2
+group 0 8 5 4 34
+ecc DUO20bx4_34_meta 10 false true 524288 2
+
+system 355 355.4x5(BL34).DUO.meta3
+group 0 8 5 4 34
+ecc DUO20bx4_34_meta 10 false true 524288 3
+
+system 360 360.4x5(BL33).DUO
+group 0 8 5 4 33
+ecc DUO20bx4_33 10 false false 0
+
+system 361 361.4x5(BL33).DUO
+group 0 8 5 4 33
+ecc DUO20bx4_33 10 false true 131072
+
+system 362 362.4x5(BL33).DUO
+group 0 8 5 4 33
+ecc DUO20bx4_33 10 false true 524288
+
+system 900 900.8x9.XED_SDDC
+group 1 4 9 8 9
+ecc XED_SDDC true
+
+system 901 901.8x9.XED_SDDC
+group 1 4 9 8 9
+ecc XED_SDDC true
+max_retired 1024
+
+system 910 910.4x18.XED_DDDC
+group 1 2 18 4 18
+ecc XED_DDDC true
+
+system 911 911.4x18.XED_DDDC
+group 1 2 18 4 18
+ecc XED_DDDC true
+max_retired 1024
+
+system 920 920.8x9.DUO
+group 1 4 9 8 9
+ecc DUO72bx8 2 false false 0
+
+system 921 921.8x9.DUO
+group 1 4 9 8 9
+ecc DUO72bx8 2 false true 2048
+
+system 940 940.4x18.DUO
+group 1 2 18 4 9
+ecc DUO72bx4 2 false false 0
+
+system 941 941.4x18.DUO
+group 1 2 18 4 9
+ecc DUO72bx4 2 false true 131072
+
+system 942 942.4x18.DUO
+group 1 2 18 4 9
+ecc DUO72bx4 2 false false 524288
+
+system 950 950.4x18.OnChip+AMD
+group 1 2 18 4 18
+ecc OnChip72bAMD true
+
+system 951 951.4x18.OnChip+AMD
+group 1 2 18 4 18
+ecc OnChip72bAMD true
+max_retired 2048
+
+system 960 960.4x10.OnChip+SDDC
+group 1 2 10 4 18
+ecc OnChip36bSDDC true
+
+system 970 970.4x18.DUO.125
+group 1 2 16 4 9
+ecc DUO64bx4_ 2 false false 0
+
+system 971 971.4x18.DUO.125
+group 1 1 16 4 9
+ecc DUO64bx4_ 4 false false 0
+
+system 980 980.huawei.4x10.OnChip+Bamboo
+group 1 1 18 4 18
+ecc OnChip72bBamboo
+
+system 1000 1000.huawei.4x10.OnChip+SDDC
+group 1 2 10 4 18
+ecc OnChip40bSDDC true
+
+system 1010 1010.huawei.4x10.OnChip+Bamboo
+group 1 2 10 4 18
+ecc OnChip40bBamboo 0
+
+system 1012 1012.huawei.4x10.OnChip+Bamboo+2B
+group 1 2 10 4 18
+ecc OnChip40bBamboo 2
+
+system 1013 1013.huawei.4x10.OnChip+Bamboo+3B
+group 1 2 10 4 18
+ecc OnChip40bBamboo 3
+
+system 1014 1014.huawei.4x10.OnChip+Bamboo+4B
+group 1 2 10 4 18
+ecc OnChip40bBamboo 4
+
+system 1015 1015.huawei.4x10.OnChip+Bamboo+5B
+group 1 2 10 4 18
+ecc OnChip40bBamboo 5
+
+system 1016 1016.huawei.4x10.OnChip+Bamboo+6B
+group 1 2 10 4 18
+ecc OnChip40bBamboo 6
+
+system 1020 1020.huawei.4x10.OnChipDUO.0B
+group 1 2 10 4 17
+ecc OnChip40bDUO 0
+
+system 1022 1022.huawei.4x10.OnChipDUO.2B
+group 1 2 10 4 17
+ecc OnChip40bDUO 2
+
+system 1023 1023.huawei.4x10.OnChipDUO.3B
+group 1 2 10 4 17
+ecc OnChip40bDUO 3
+
+system 1024 1024.huawei.4x10.OnChipDUO.4B
+group 1 2 10 4 17
+ecc OnChip40bDUO 4
+
+# 9x4 SDDC baseline, which should run no inherent faults
+system 1099 1099.huawei.4x9.SDDCBaseline
+group 1 2 9 4 16
+ecc SDDCBamboo36b
+
+system 1100 1100.huawei.8x5.OnChip+XED
+group 1 2 5 8 17
+ecc OnChip40bXEDx8 true 0
+
+system 1103 1103.huawei.8x5.OnChip+XED
+group 1 2 5 8 17
+ecc OnChip40bXEDx8 true 3
+
+system 1110 1110.huawei.8x5.OnChip+Bamboo
+group 1 2 5 8 17
+ecc OnChip40bBamboox8 0
+
+system 1111 1111.huawei.8x5.OnChip+Bamboo
+group 1 2 5 8 17
+ecc OnChip40bBamboox8 1
+
+system 1112 1112.huawei.8x5.OnChip+Bamboo
+group 1 2 5 8 17
+ecc OnChip40bBamboox8 2
+
+system 1113 1113.huawei.8x5.OnChip+Bamboo
+group 1 2 5 8 17
+ecc OnChip40bBamboox8 3
+
+system 1120 1120.huawei.8x5.OnChipDUOx8.0B
+group 1 2 5 8 17
+ecc OnChip40bDUOx8 0
+
+system 1122 1122.huawei.8x5.OnChipDUOx8.2B
+group 1 2 5 8 17
+ecc OnChip40bDUOx8 2
+
+system 1123 1123.huawei.8x5.OnChipDUOx8.3B
+group 1 2 5 8 17
+ecc OnChip40bDUOx8 3
+
+system 1200 1200.huawei.4x16.OnChipSEC
+group 0 4 8 8 17
+ecc OnChip4xSEC 136
+
+system 1201 1201.huawei.8x8.OnChipSECDED
+group 2 4 8 8 9
+ecc OnChip8xSECDED 136
+
+system 1210 1210.huawei.16x2.OnChipSEC272
+group 1 1 4 8 17
+ecc OnChip2xSEC16b 272
+
+system 1220 1220.huawei.16x2.OnChipSEC512
+group 1 1 4 8 17
+ecc OnChip1xSEC16b 512
+
+system 1230 1230.huawei.4x8.OnChipBCH.Triple
+group 4 4 4 8 17
+ecc OnChipBCHTriple true
+
+system 1231 1231.huawei.4x8.OnChipBCH.Hexa
+group 4 4 4 8 18
+ecc OnChipBCHHexa true
+
+# no ecc baseline
+system 1299 1299.huawei.16x2.None
+group 1 1 2 16 16
+ecc OnChipNone
+
+system 1300 1300.huawei.18x4.OnChip+Bamboo(16bit Sym)
+group 1 2 18 4 18
+ecc OnChipSym16bBB72b true
+
+system 1310 1310.huawei.18x4.Bamboo(16bit Sym)
+group 1 2 18 4 8
+ecc OnChipSym16bBB72b false
+
+system 1320 1320.huawei.18x4.OnChip+Bamboo
+group 1 2 18 4 18
+ecc OnChip8bBB72b true 0
+
+system 1321 1321.huawei.18x4.OnChip+Bamboo+1Bmeta
+group 1 2 18 4 18
+ecc OnChip8bBB72b true 1
+
+system 1322 1322.huawei.18x4.OnChip+Bamboo+2Bmeta
+group 1 2 18 4 18
+ecc OnChip8bBB72b true 2
+
+system 1323 1323.huawei.18x4.OnChip+Bamboo+3Bmeta
+group 1 2 18 4 18
+ecc OnChip8bBB72b true 3
+
+system 1330 1330.huawei.18x4.Bamboo
+group 1 2 18 4 18
+ecc OnChip8bBB72b false 0
+
+system 1331 1331.huawei.18x4.Bamboo+1Bmeta
+group 1 2 18 4 18
+ecc OnChip8bBB72b false 1
+
+system 1332 1332.huawei.18x4.Bamboo+2Bmeta
+group 1 2 18 4 18
+ecc OnChip8bBB72b false 2
+
+system 1333 1333.huawei.18x4.Bamboo+3Bmeta
+group 1 2 18 4 18
+ecc OnChip8bBB72b false 3
+
+# DUO - 9chip baseline for rank level PIM
+system 2900 2900.4x9(BL17).DUO.rankPIM
+group 1 4 9 4 17
+ecc DUO36bx4 6 false true 524288
+max_retired 524288
+
+# Bamboo - 10chip baseline for rank level PIM
+system 2910 2910.4x10.OnChip+Bamboo.rankPIM
+group 1 4 10 4 18
+ecc OnChip40bBamboo 0
+max_retired 524288
+
+# Bamboo - 8chip naive bank level HBM-PIM(144,128) like code without rank ece
+system 2911 2911.4x8.Naive_OnChip.bankPIM
+group 1 4 8 4 20
+ecc Onchip144_128
+max_retired 524288
+
+# DUO- 9chip bank level PIM with 8bit CRC
+system 3000 3000.4x9(BL17).CRC+DUO.bankPIM
+group 1 4 9 4 19
+ecc FlipCRC_DUO 6 false true 524288
+max_retired 524288
+
+# DUO - 10chip bamboo with 8bit CRC
+system 3010 3010.huawei.4x10.8bCRC+Bamboo.bankPIM
+group 1 4 10 4 34
+ecc FlipCRC_Bamboo 0 8
+max_retired 524288
+
+# DUO - 10chip bamboo with 16bit CRC
+system 3011 3011.huawei.4x10.16bCRC+Bamboo.bankPIM
+group 1 4 10 4 36
+ecc FlipCRC_Bamboo 0 16
+max_retired 524288
+
+# Bamboo - 10chip baseline for rank level PIM
+system 4000 4000.4x10.OnChip+Bamboo.rankPIM
+group 1 4 10 4 18
+ecc OnChip40bBamboo 0
+max_retired 524288
+
+# Bamboo - 10chip baseline for rank level PIM
+system 4001 4001.4x10.Bamboo.rankPIM
+group 1 4 10 4 18
+ecc OnChip40bBamboo 0 false false
+max_retired 524288
+
+# CRC 8 128 overfetch
+system 4010 4010.4x8.CRC8_128overfetch
+group 1 4 10 4 34
+ecc CRCECC128 8
+max_retired 524288
+
+# CRC 16 128 overfetch
+system 4011 4011.4x8.CRC16_128overfetch
+group 1 4 10 4 36
+ecc CRCECC128 16
+max_retired 524288
+
+# CRC 8 256 overfetch
+system 4012 4012.4x8.CRC8_256overfetch
+group 1 4 10 4 66
+ecc CRCECC256 8
+max_retired 524288
+
+# CRC 16 256 overfetch
+system 4013 4013.4x8.CRC16_256overfetch
+group 1 4 10 4 68
+ecc CRCECC256 16
+max_retired 524288
+
+# HBM real case, 256bit + 32bit ECC
+system 4019 4020_simplemodel.HBM3.2RS8
+group 1 16 1 36 8
+msg 8 8 0 0 1 36 1
+hbm 1
+detailed 0
+ecc LargeRS_HBM 0
+max_retired 0
+banks_per_beat 1
+
+# HBM real case, 256bit + 32bit ECC
+system 4020 4020_newmodel.HBM3.2RS8
+group 1 16 1 36 8
+msg 8 8 0 0 1 36 1
+hbm 1
+ecc LargeRS_HBM 0
+max_retired 0
+banks_per_beat 1
+
+# HBM real case, 256bit + 32bit ECC + AIECC 16bit
+system 4021 4021_newmodel.HBM3.2RS8_AIECC
+group 1 16 1 36 8
+msg 8 8 0 0 1 36 1
+hbm 1
+ecc LargeRS_aiecc 0
+max_retired 0
+banks_per_beat 1
+
+# HBM real case, 256bit + 32bit ECC + AIECC 16bit
+system 4022 4021_simplemodel.HBM3.2RS8_AIECC
+group 1 16 1 36 8
+msg 8 8 0 0 1 36 1
+hbm 1
+detailed 0
+ecc LargeRS_aiecc 0
+max_retired 0
+banks_per_beat 1
+
+# HBM real case, 256bit + 32bit ECC
+system 4023 4023_simplemodel.HBM3.RS8
+group 1 16 1 36 8
+msg 8 8 0 0 1 36 1
+hbm 1
+detailed 0
+ecc LargeRS_HBM 1
+max_retired 0
+banks_per_beat 1
+
+# HBM real case, 256bit + 32bit ECC
+system 4024 4023_newmodel.HBM3.RS8
+group 1 16 1 36 8
+msg 8 8 0 0 1 36 1
+hbm 1
+ecc LargeRS_HBM 1
+max_retired 0
+banks_per_beat 1
+
+# HBM real case, 256bit + 32bit ECC + AIECC 16bit
+system 4025 4025_newmodel.HBM3.RS8_AIECC
+group 1 16 1 36 8
+msg 8 8 0 0 1 36 1
+hbm 1
+ecc LargeRS_aiecc 1
+max_retired 0
+banks_per_beat 1
+
+# HBM real case, 256bit + 32bit ECC + AIECC 16bit
+system 4026 4025_simplemodel.HBM3.RS8_AIECC
+group 1 16 1 36 8
+msg 8 8 0 0 1 36 1
+hbm 1
+detailed 0
+ecc LargeRS_aiecc 1
+max_retired 0
+banks_per_beat 1
+
+# HBM real case, 256bit + 32bit ECC
+system 4027 4027_simplemodel.HBM3.RS16
+group 1 16 1 36 8
+msg 8 8 0 0 1 36 1
+hbm 1
+detailed 0
+ecc LargeRS_HBM 2
+max_retired 0
+banks_per_beat 1
+
+# HBM real case, 256bit + 32bit ECC
+system 4028 4027_newmodel.HBM3.RS16
+group 1 16 1 36 8
+msg 8 8 0 0 1 36 1
+hbm 1
+ecc LargeRS_HBM 2
+max_retired 0
+banks_per_beat 1
+
+# HBM real case, 256bit + 32bit ECC + AIECC 16bit
+system 4029 4029_newmodel.HBM3.RS16_AIECC
+group 1 16 1 36 8
+msg 8 8 0 0 1 36 1
+hbm 1
+ecc LargeRS_aiecc 2
+max_retired 0
+banks_per_beat 1
+
+# DDR5 IECC
+system 4030 4030.4x8.DDR5_IECC
+group 1 1 10 5 32
+msg 16 16 0 8 2 4 10 1 EXTRAPIN
+ecc OnChip4xSEC_FLEX 0
+banks_per_beat 1
+
+# Bamboo - 10chip baseline for rank level PIM
+system 4031 4031_newmodel.4x10.OnChip+Bamboo.rankPIM
+group 1 1 10 5 16
+msg 16 16 0 0 1 4 10 1 EXTRACHIP
+ecc OnChip40bBamboo_FLEX 0
+
+# Bamboo - 10chip baseline for rank level PIM
+system 4032 4031_simplemodel.4x10.OnChip+Bamboo.rankPIM
+group 1 1 10 5 16
+msg 16 16 0 0 1 4 10 1 EXTRACHIP
+detailed 0
+ecc OnChip40bBamboo_FLEX 0
+
+# DDR5 DEC
+system 4040 4040.4x8.DDR5_IECC_DEC
+group 1 1 10 10 16
+msg 16 16 0 14 1 8 10 2 EXTRAPIN
+ecc OnChip4xSEC_FLEX 2
+max_retired 524288
+banks_per_beat 1
+
+# DDR5 TEC
+system 4041 4041.4x8.DDR5_IECC_TEC
+group 1 1 10 12 16
+msg 16 16 0 10 1 8 10 4 EXTRAPIN
+ecc OnChip4xSEC_FLEX 3
+max_retired 524288
+banks_per_beat 1
+
+# DDR5 QEC
+system 4042 4042.4x8.DDR5_IECC_QEC
+group 1 1 10 12 16
+msg 16 16 0 14 1 8 10 4 EXTRAPIN
+ecc OnChip4xSEC_FLEX 4
+max_retired 524288
+banks_per_beat 1
+
+system 5001 5001_newmodel.4x10DDR5.AMD2
+group 1 2 10 5 16
+msg 2 16 0 0 1 4 10 1 EXTRACHIP
+ecc AMDChipkill_FLEX false true
+max_retired 0
+
+system 5002 5001_simplemodel.4x10DDR5.AMD2
+group 1 2 10 5 16
+msg 2 16 0 0 1 4 10 1 EXTRACHIP
+detailed 0
+ecc AMDChipkill_FLEX false true
+max_retired 0
+
+system 5003 5003_newmodel.4x9DDR5.AMD2
+group 1 2 9 5 16
+msg 4 16 0 0 1 4 9 1 EXTRACHIP
+ecc AMDChipkill_FLEX false true 2
+max_retired 0
+
+system 5004 5003_simplemodel.4x9DDR5.AMD2
+group 1 2 9 5 16
+msg 4 16 0 0 1 4 9 1 EXTRACHIP
+detailed 0
+ecc AMDChipkill_FLEX false true 2
+max_retired 0
+
+system 5005 5005_newmodel.4x10DDR5_noecc.AMD2
+group 1 2 10 5 16
+msg 2 16 0 0 1 4 10 1 EXTRACHIP
+ecc AMDChipkill_FLEX false false
+
+system 5006 5005_simplemodel.4x10DDR5_noecc.AMD2
+group 1 2 10 5 16
+msg 2 16 0 0 1 4 10 1 EXTRACHIP
+detailed 0
+ecc AMDChipkill_FLEX false false
+
+# DDR4 chipkill, but half correctable
+system 5011 5011_simplemodel.4x18.AMD2_half
+group 1 2 18 4 8
+msg 4 8 0 0 1 4 18 0 EXTRACHIP
+detailed 0
+ecc AMDChipkill_FLEX false false 1
+max_retired 0
+
+system 5012 5012_newmodel.4x18.AMD2_half
+group 1 2 18 4 8
+msg 4 8 0 0 1 4 18 0 EXTRACHIP
+ecc AMDChipkill_FLEX false false 1
+max_retired 0
+
+# LPDDR5 SEC-DED + Link CRC
+system 6000 6000_newmodel.LPDDR5_SEC_SEC
+group 1 16 2 17 16
+msg 16 16 0 0 1 16 2 1 EXTRAPIN
+ecc LPDDR5_ONCHIP 0
+max_retired 0
+
+# LPDDR5 SEC-DED + Link CRC
+system 6001 6000_newmodel.LPDDR5_RS1
+group 1 16 2 17 16
+msg 16 16 0 0 1 16 2 1 EXTRAPIN
+ecc LPDDR5_ONCHIP 1
+max_retired 0
+
+# LPDDR5 SEC-DED + Link CRC
+system 6002 6000_newmodel.LPDDR5_RS2
+group 1 16 2 18 16
+msg 16 16 0 0 1 18 2 1 EXTRAPIN
+ecc LPDDR5_ONCHIP 2
+max_retired 0
+
+# LPDDR5 SEC-DED + Link CRC
+system 6003 6000_newmodel.LPDDR5_SEC_SEC
+group 1 16 2 17 16
+msg 16 16 0 0 1 17 2 1 EXTRAPIN
+ecc LPDDR5_ONCHIP 0
+max_retired 0
+
+# LPDDR5 SEC-DED + Link CRC
+system 6004 6000_newmodel.LPDDR5_DEC
+group 1 16 2 18 16
+msg 16 16 0 0 1 18 2 1 EXTRAPIN
+ecc LPDDR5_ONCHIP 1
+max_retired 0
+
+# LPDDR5 SEC-DED + Link CRC
+system 6005 6000_newmodel.LPDDR5_RS
+group 1 16 2 18 16
+msg 16 16 0 0 1 18 2 1 EXTRAPIN
+ecc LPDDR5_ONCHIP 2
+max_retired 0
+)";
+#endif /* AGECC */
+
+//------------------------------------------------------------------------------
+int ECCArgs::i(size_t pos, int def) const
+{
+  if (pos + 1 >= args.size()) return def;
+  const char *word = args[pos + 1].c_str();
+  char *end;
+  errno = 0;
+  long value = strtol(word, &end, 0);
+  if ((*word == '\0') || (*end != '\0') || (errno != 0))
+  {
+    printf("%s: argument %zu (%s) is not an integer\n", args[0].c_str(),
+           pos + 1, word);
+    exit(1);
+  }
+  return (int)value;
+}
+
+//------------------------------------------------------------------------------
+bool ECCArgs::b(size_t pos, bool def) const
+{
+  if (pos + 1 >= args.size()) return def;
+  const std::string &word = args[pos + 1];
+  if ((word == "true") || (word == "1")) return true;
+  if ((word == "false") || (word == "0")) return false;
+  printf("%s: argument %zu (%s) is not a bool\n", args[0].c_str(), pos + 1,
+         word.c_str());
+  exit(1);
+}
+
+//------------------------------------------------------------------------------
+struct ECCMaker {
+  int minArgs, maxArgs;
+  ECC *(*make)(const ECCArgs &args);
+};
+
+// ECC classes by name; the defaults of missing arguments follow the
+// constructors
+static std::map<std::string, ECCMaker> &eccRegistry()
+{
+  static std::map<std::string, ECCMaker> registry = {
+    // prior.hh
+    {"ECCNone", {0, 0, [](const ECCArgs &) -> ECC * {
+       return new ECCNone(); }}},
+    {"SECDED72b", {0, 0, [](const ECCArgs &) -> ECC * {
+       return new SECDED72b(); }}},
+    {"S8SC144b", {0, 0, [](const ECCArgs &) -> ECC * {
+       return new S8SC144b(); }}},
+    {"AMDChipkill20b", {0, 1, [](const ECCArgs &a) -> ECC * {
+       return new AMDChipkill20b(a.b(0, true)); }}},
+    {"AMDChipkill72b", {0, 1, [](const ECCArgs &a) -> ECC * {
+       return new AMDChipkill72b(a.b(0, true)); }}},
+    {"AMDDChipkill144b", {0, 1, [](const ECCArgs &a) -> ECC * {
+       return new AMDDChipkill144b(a.b(0, true)); }}},
+    {"AMDChipkill_FLEX", {0, 3, [](const ECCArgs &a) -> ECC * {
+       return new AMDChipkill_FLEX(a.b(0, true), a.b(1, true), a.i(2, 0)); }}},
+    // Bamboo.hh
+    {"SPC66bx4", {0, 0, [](const ECCArgs &) -> ECC * {
+       return new SPC66bx4(); }}},
+    {"SPCTPD68bx4", {0, 0, [](const ECCArgs &) -> ECC * {
+       return new SPCTPD68bx4(); }}},
+    {"OPC144b", {0, 0, [](const ECCArgs &) -> ECC * {
+       return new OPC144b(); }}},
+    {"QPC72b", {0, 3, [](const ECCArgs &a) -> ECC * {
+       if (a.size() == 0) return new QPC72b();
+       return new QPC72b(a.i(0), a.i(1), a.b(2, true)); }}},
+    {"QPC76b", {0, 3, [](const ECCArgs &a) -> ECC * {
+       if (a.size() == 0) return new QPC76b();
+       return new QPC76b(a.i(0), a.i(1), a.b(2, true)); }}},
+    // REGB.hh
+    {"OnChip64b", {0, 0, [](const ECCArgs &) -> ECC * {
+       return new OnChip64b(); }}},
+    {"OnChip72bSECDED", {0, 0, [](const ECCArgs &) -> ECC * {
+       return new OnChip72bSECDED(); }}},
+    {"OnChip72bAMD", {0, 1, [](const ECCArgs &a) -> ECC * {
+       return new OnChip72bAMD(a.b(0, true)); }}},
+    {"OnChip72bQPC72b", {2, 2, [](const ECCArgs &a) -> ECC * {
+       return new OnChip72bQPC72b(a.i(0), a.i(1)); }}},
+    {"OnChip36bSDDC", {0, 1, [](const ECCArgs &a) -> ECC * {
+       return new OnChip36bSDDC(a.b(0, true)); }}},
+    {"QPC72bREGB", {2, 2, [](const ECCArgs &a) -> ECC * {
+       return new QPC72bREGB(a.b(0), a.b(1)); }}},
+    // XED.hh
+    {"XED_SDDC", {0, 1, [](const ECCArgs &a) -> ECC * {
+       return new XED_SDDC(a.b(0, true)); }}},
+    {"XED_SDDC_NC", {0, 1, [](const ECCArgs &a) -> ECC * {
+       return new XED_SDDC_NC(a.b(0, true)); }}},
+    {"XED_DDDC", {0, 1, [](const ECCArgs &a) -> ECC * {
+       return new XED_DDDC(a.b(0, true)); }}},
+    // DUO.hh: maxPin [doPostprocess doRetire maxRetiredBlkCount [metaBytes]]
+    {"DUO64bx4", {1, 1, [](const ECCArgs &a) -> ECC * {
+       return new DUO64bx4(a.i(0)); }}},
+    {"DUO64bx4_", {4, 4, [](const ECCArgs &a) -> ECC * {
+       return new DUO64bx4_(a.i(0), a.b(1), a.b(2), a.i(3)); }}},
+    {"DUO72bx4", {4, 4, [](const ECCArgs &a) -> ECC * {
+       return new DUO72bx4(a.i(0), a.b(1), a.b(2), a.i(3)); }}},
+    {"DUO72bx8", {4, 4, [](const ECCArgs &a) -> ECC * {
+       return new DUO72bx8(a.i(0), a.b(1), a.b(2), a.i(3)); }}},
+    {"DUO36bx4", {4, 4, [](const ECCArgs &a) -> ECC * {
+       return new DUO36bx4(a.i(0), a.b(1), a.b(2), a.i(3)); }}},
+    {"DUO36bx4_meta", {5, 5, [](const ECCArgs &a) -> ECC * {
+       return new DUO36bx4_meta(a.i(0), a.b(1), a.b(2), a.i(3), a.i(4)); }}},
+    {"DUO20bx4_33", {4, 4, [](const ECCArgs &a) -> ECC * {
+       return new DUO20bx4_33(a.i(0), a.b(1), a.b(2), a.i(3)); }}},
+    {"DUO20bx4_34", {4, 4, [](const ECCArgs &a) -> ECC * {
+       return new DUO20bx4_34(a.i(0), a.b(1), a.b(2), a.i(3)); }}},
+    {"DUO20bx4_34_meta", {5, 5, [](const ECCArgs &a) -> ECC * {
+       return new DUO20bx4_34_meta(a.i(0), a.b(1), a.b(2), a.i(3), a.i(4)); }}},
+    // Huawei.hh
+    {"OnChipNone", {0, 0, [](const ECCArgs &) -> ECC * {
+       return new OnChipNone(); }}},
+    {"OnChip72bBamboo", {0, 0, [](const ECCArgs &) -> ECC * {
+       return new OnChip72bBamboo(); }}},
+    {"SDDCBamboo36b", {0, 0, [](const ECCArgs &) -> ECC * {
+       return new SDDCBamboo36b(); }}},
+    {"OnChip40bSDDC", {0, 1, [](const ECCArgs &a) -> ECC * {
+       return new OnChip40bSDDC(a.b(0, true)); }}},
+    {"OnChip40bBamboo", {0, 3, [](const ECCArgs &a) -> ECC * {
+       return new OnChip40bBamboo(a.i(0, 3), a.b(1, false), a.b(2, true)); }}},
+    {"OnChip40bBamboo_FLEX", {0, 3, [](const ECCArgs &a) -> ECC * {
+       return new OnChip40bBamboo_FLEX(a.i(0, 3), a.b(1, false), a.b(2, true)); }}},
+    {"OnChip40bBamboox8", {0, 2, [](const ECCArgs &a) -> ECC * {
+       return new OnChip40bBamboox8(a.i(0, 3), a.b(1, true)); }}},
+    {"OnChip40bDUO", {0, 1, [](const ECCArgs &a) -> ECC * {
+       return new OnChip40bDUO(a.i(0, 3)); }}},
+    {"OnChip40bDUOx8", {0, 1, [](const ECCArgs &a) -> ECC * {
+       return new OnChip40bDUOx8(a.i(0, 3)); }}},
+    {"OnChip40bXEDx8", {0, 2, [](const ECCArgs &a) -> ECC * {
+       return new OnChip40bXEDx8(a.b(0, true), a.i(1, 3)); }}},
+    {"OnChip4xSEC", {1, 1, [](const ECCArgs &a) -> ECC * {
+       return new OnChip4xSEC(a.i(0)); }}},
+    {"OnChip4xSEC_FLEX", {1, 1, [](const ECCArgs &a) -> ECC * {
+       return new OnChip4xSEC_FLEX(a.i(0)); }}},
+    {"OnChip8xSECDED", {1, 1, [](const ECCArgs &a) -> ECC * {
+       return new OnChip8xSECDED(a.i(0)); }}},
+    {"OnChip2xSEC16b", {1, 1, [](const ECCArgs &a) -> ECC * {
+       return new OnChip2xSEC16b(a.i(0)); }}},
+    {"OnChip1xSEC16b", {1, 1, [](const ECCArgs &a) -> ECC * {
+       return new OnChip1xSEC16b(a.i(0)); }}},
+    {"OnChipBCHTriple", {1, 1, [](const ECCArgs &a) -> ECC * {
+       return new OnChipBCHTriple(a.b(0)); }}},
+    {"OnChipBCHHexa", {1, 1, [](const ECCArgs &a) -> ECC * {
+       return new OnChipBCHHexa(a.b(0)); }}},
+    {"OnChipSym16bBB72b", {1, 1, [](const ECCArgs &a) -> ECC * {
+       return new OnChipSym16bBB72b(a.b(0)); }}},
+    {"OnChip8bBB72b", {2, 2, [](const ECCArgs &a) -> ECC * {
+       return new OnChip8bBB72b(a.b(0), a.i(1)); }}},
+    {"LPDDR5_ONCHIP", {1, 1, [](const ECCArgs &a) -> ECC * {
+       return new LPDDR5_ONCHIP(a.i(0)); }}},
+    // FlipCorrection.hh
+    {"Onchip144_128", {0, 0, [](const ECCArgs &) -> ECC * {
+       return new Onchip144_128(); }}},
+    {"FlipCRC_DUO", {4, 4, [](const ECCArgs &a) -> ECC * {
+       return new FlipCRC_DUO(a.i(0), a.b(1), a.b(2), a.i(3)); }}},
+    {"FlipCRC_Bamboo", {2, 2, [](const ECCArgs &a) -> ECC * {
+       return new FlipCRC_Bamboo(a.i(0), a.i(1)); }}},
+    {"CRCECC128", {1, 1, [](const ECCArgs &a) -> ECC * {
+       return new CRCECC128(a.i(0)); }}},
+    {"CRCECC256", {1, 1, [](const ECCArgs &a) -> ECC * {
+       return new CRCECC256(a.i(0)); }}},
+    {"LargeRS_HBM", {1, 1, [](const ECCArgs &a) -> ECC * {
+       return new LargeRS_HBM(a.i(0)); }}},
+    {"LargeRS_aiecc", {1, 1, [](const ECCArgs &a) -> ECC * {
+       return new LargeRS_aiecc(a.i(0)); }}},
+  };
+  return registry;
+}
+
+//------------------------------------------------------------------------------
+void registerECC(const std::string &name, int minArgs, int maxArgs,
+                 ECC *(*make)(const ECCArgs &args))
+{
+  ECCMaker maker = {minArgs, maxArgs, make};
+  eccRegistry()[name] = maker;
+}
+
+//------------------------------------------------------------------------------
+ECC *createECC(const std::vector<std::string> &ecc)
+{
+  auto it = eccRegistry().find(ecc[0]);
+  if (it == eccRegistry().end())
+  {
+    printf("Unknown ECC class %s\n", ecc[0].c_str());
+    return NULL;
+  }
+  ECCArgs args(ecc);
+  if (((int)args.size() < it->second.minArgs) ||
+      ((int)args.size() > it->second.maxArgs))
+  {
+    printf("%s takes %d to %d arguments\n", ecc[0].c_str(),
+           it->second.minArgs, it->second.maxArgs);
+    return NULL;
+  }
+  return it->second.make(args);
+}
+
+//------------------------------------------------------------------------------
+// systems by ID; presets first, then loadSystems()
+static std::map<int, SystemSpec> &systems()
+{
+  static std::map<int, SystemSpec> specs;
+  return specs;
+}
+
+//------------------------------------------------------------------------------
+static bool parseBool(const std::string &word, bool &value)
+{
+  if ((word == "1") || (word == "true")) value = true;
+  else if ((word == "0") || (word == "false")) value = false;
+  else return false;
+  return true;
+}
+
+// a decimal integer in [lo, hi]
+static bool parseInt(const std::string &word, long long lo, long long hi,
+                     long long &value)
+{
+  char *end;
+  errno = 0;
+  value = strtoll(word.c_str(), &end, 10);
+  return !word.empty() && (*end == '\0') && (errno == 0) && (value >= lo) &&
+         (value <= hi);
+}
+
+//------------------------------------------------------------------------------
+// parse the system descriptions of "in" into systems(); "source" names the
+// input in error messages
+static bool parseSystems(std::istream &in, const char *source)
+{
+  std::map<int, SystemSpec> parsed;
+  SystemSpec *spec = NULL;
+  std::string line;
+  int lineNumber = 0;
+  bool ok = true;
+  while (std::getline(in, line))
+  {
+    lineNumber++;
+    size_t comment = line.find('#');
+    if (comment != std::string::npos) line.resize(comment);
+    std::istringstream words(line);
+    std::string key, word;
+    if (!(words >> key)) continue;
+    std::vector<std::string> values;
+    while (words >> word)
+      values.push_back(word);
+
+    bool good = true;
+    if (key == "system")
+    {
+      // the name is the rest of the line (a few presets have spaces)
+      std::string name;
+      for (size_t i = 1; i < values.size(); i++)
+        name += ((i > 1) ? " " : "") + values[i];
+      char *end = NULL;
+      int id = (values.size() >= 2) ? strtol(values[0].c_str(), &end, 10) : -1;
+      if ((end == NULL) || (*end != '\0') || (id < 0) ||
+          (name.size() > 200) || (parsed.count(id) != 0))
+      {
+        printf("%s:%d: usage: system ID Name (ID >= 0, once per file)\n",
+               source, lineNumber);
+        ok = false;
+        spec = NULL;
+        continue;
+      }
+      spec = &parsed[id];
+      spec->id = id;
+      spec->name = name;
+      continue;
+    }
+    if (spec == NULL)
+    {
+      printf("%s:%d: %s before the first system line\n", source, lineNumber,
+             key.c_str());
+      ok = false;
+      continue;
+    }
+    if ((key == "group") && (values.size() == 5))
+    {
+      spec->group.clear();
+      for (auto &value : values)
+      {
+        long long n;
+        good = good && parseInt(value, 0, INT_MAX, n);
+        spec->group.push_back((int)n);
+      }
+    }
+    else if ((key == "msg") && (values.size() >= 7) && (values.size() <= 9))
+    {
+      spec->msg = values;
+      long long n;
+      for (size_t i = 0; (i < values.size()) && (i < 8); i++)
+        good = good && parseInt(values[i], 0, INT_MAX, n);
+      if ((values.size() == 9) && (values[8] != "EXTRABEAT") &&
+          (values[8] != "EXTRACHIP") && (values[8] != "EXTRAPIN") &&
+          (values[8] != "BOTH"))
+        good = false;
+    }
+    else if ((key == "hbm") && (values.size() == 1))
+      good = parseBool(values[0], spec->hbm);
+    else if ((key == "detailed") && (values.size() == 1))
+      good = parseBool(values[0], spec->detailed);
+    else if ((key == "ecc") && (values.size() >= 1))
+    {
+      spec->ecc = values;
+      good = eccRegistry().count(values[0]) != 0;
+    }
+    else if ((key == "max_retired") && (values.size() == 1))
+      good = parseInt(values[0], -1, LLONG_MAX, spec->maxRetired);
+    else if ((key == "retire") && (values.size() == 1))
+    {
+      bool retire = false;
+      good = parseBool(values[0], retire);
+      spec->retire = retire;
+    }
+    else if ((key == "banks_per_beat") && (values.size() == 1))
+    {
+      long long n;
+      good = parseInt(values[0], 0, INT_MAX, n);
+      spec->banksPerBeat = (int)n;
+    }
+    else if ((key == "scrubber") && (values.size() >= 1))
+    {
+      spec->scrubber = values;
+      if ((values[0] == "periodic") || (values[0] == "patrol"))
+        good = (values.size() == 2) && (atof(values[1].c_str()) > 0);
+      else
+        good = ((values[0] == "none") || (values[0] == "demand")) &&
+               (values.size() == 1);
+    }
+    else
+    {
+      printf("%s:%d: unknown key or wrong number of values\n", source,
+             lineNumber);
+      ok = false;
+      continue;
+    }
+    if (!good)
+    {
+      printf("%s:%d: bad value for %s\n", source, lineNumber, key.c_str());
+      ok = false;
+    }
+  }
+
+  for (auto &entry : parsed)
+  {
+    const SystemSpec &s = entry.second;
+    if (s.group.empty() || s.ecc.empty())
+    {
+      printf("%s: system %d needs group and ecc\n", source, s.id);
+      ok = false;
+    }
+    else if (s.msg.empty() && (s.hbm || !s.detailed))
+    {
+      printf("%s: system %d: hbm and detailed need msg\n", source, s.id);
+      ok = false;
+    }
+  }
+  if (!ok) return false;
+  for (auto &entry : parsed)
+    systems()[entry.first] = entry.second;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+static void loadPresets()
+{
+  static bool loaded = false;
+  if (loaded) return;
+  loaded = true;
+  std::istringstream in(presets);
+  bool ok = parseSystems(in, "presets");
+  assert(ok);
+}
+
+//------------------------------------------------------------------------------
+bool loadSystems(const char *fileName)
+{
+  loadPresets();
+  std::ifstream in(fileName);
+  if (!in)
+  {
+    printf("Cannot open the system file %s\n", fileName);
+    return false;
+  }
+  return parseSystems(in, fileName);
+}
+
+//------------------------------------------------------------------------------
+const SystemSpec *findSystem(int id)
+{
+  loadPresets();
+  auto it = systems().find(id);
+  return (it == systems().end()) ? NULL : &it->second;
+}
+
+//------------------------------------------------------------------------------
+std::vector<const SystemSpec *> listSystems()
+{
+  loadPresets();
+  std::vector<const SystemSpec *> list;
+  for (auto &entry : systems())
+    list.push_back(&entry.second);
+  return list;
+}
+
+//------------------------------------------------------------------------------
+static void printWords(FILE *fd, const char *key,
+                       const std::vector<std::string> &words)
+{
+  fprintf(fd, "%s", key);
+  for (auto &word : words)
+    fprintf(fd, " %s", word.c_str());
+  fprintf(fd, "\n");
+}
+
+//------------------------------------------------------------------------------
+void SystemSpec::print(FILE *fd) const
+{
+  fprintf(fd, "system %d %s\n", id, name.c_str());
+  fprintf(fd, "group");
+  for (int value : group)
+    fprintf(fd, " %d", value);
+  fprintf(fd, "\n");
+  if (!msg.empty()) printWords(fd, "msg", msg);
+  if (hbm) fprintf(fd, "hbm 1\n");
+  if (!detailed) fprintf(fd, "detailed 0\n");
+  printWords(fd, "ecc", ecc);
+  if (maxRetired >= 0) fprintf(fd, "max_retired %lld\n", maxRetired);
+  if (retire >= 0) fprintf(fd, "retire %d\n", retire);
+  if (banksPerBeat > 0) fprintf(fd, "banks_per_beat %d\n", banksPerBeat);
+  if ((scrubber.size() != 2) || (scrubber[0] != "periodic") ||
+      (scrubber[1] != "8"))
+    printWords(fd, "scrubber", scrubber);
+}
+
+//------------------------------------------------------------------------------
+static RedundancyMode redundancyMode(const std::string &word)
+{
+  if (word == "EXTRACHIP") return EXTRACHIP;
+  if (word == "EXTRAPIN") return EXTRAPIN;
+  if (word == "BOTH") return BOTH;
+  return EXTRABEAT;
+}
+
+//------------------------------------------------------------------------------
+bool buildSystem(const SystemSpec &spec, const char *seedName,
+                 DomainGroup *&dg, ECC *&ecc, char *filePrefix)
+{
+  const std::vector<int> &g = spec.group;
+  if (spec.msg.empty())
+  {
+    dg = new DomainGroupDDR(g[0], g[1], g[2], g[3], g[4]);
+  }
+  else
+  {
+    const std::vector<std::string> &m = spec.msg;
+    MSGConfig message_config(
+        atoi(m[0].c_str()), atoi(m[1].c_str()), atoi(m[2].c_str()),
+        atoi(m[3].c_str()), atoi(m[4].c_str()), atoi(m[5].c_str()),
+        atoi(m[6].c_str()), (m.size() > 7) ? atoi(m[7].c_str()) : 0,
+        (m.size() > 8) ? redundancyMode(m[8]) : EXTRABEAT);
+    dg = new DomainGroupDDR(g[0], g[1], g[2], g[3], g[4], message_config,
+                            spec.hbm, spec.detailed);
+    if (spec.hbm) dg->setHBM(true);
+  }
+  ecc = createECC(spec.ecc);
+  if (ecc == NULL)
+  {
+    delete dg;
+    dg = NULL;
+    return false;
+  }
+  if (spec.maxRetired >= 0) ecc->setMaxRetiredBlkCount(spec.maxRetired);
+  if (spec.retire >= 0) ecc->setDoRetire(spec.retire != 0);
+  if (spec.banksPerBeat > 0) BANKSPERBEAT = spec.banksPerBeat;
+  sprintf(filePrefix, "%s.%s", spec.name.c_str(), seedName);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool buildSystem(int id, const char *seedName, DomainGroup *&dg, ECC *&ecc,
+                 char *filePrefix)
+{
+  const SystemSpec *spec = findSystem(id);
+  if (spec == NULL) return false;
+  return buildSystem(*spec, seedName, dg, ecc, filePrefix);
+}
+
+//------------------------------------------------------------------------------
+Scrubber *buildScrubber(const SystemSpec &spec)
+{
+  const std::string &kind = spec.scrubber[0];
+  if (kind == "periodic")
+    return new PeriodicScrubber(atof(spec.scrubber[1].c_str()));
+  if (kind == "patrol")
+    return new PatrolScrubber(atof(spec.scrubber[1].c_str()));
+  if (kind == "demand") return new DemandScrubber();
+  return new NoScrubber();
+}
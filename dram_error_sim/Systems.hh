@@ -0,0 +1,134 @@
+/*
+Copyright 2023, The University of Texas at Austin
+All rights reserved.
+
+THIS FILE IS PART OF THE DRAM FAULT ERROR SIMULATION FRAMEWORK
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * @file: Systems.hh
+ * @brief Target systems (DomainGroup geometry + ECC) by system ID
+ * @details Systems are described in a small text format, one "key value..."
+ * per line ('#' starts a comment); "system" starts a new description:
+ *   system 5001 5001_newmodel.4x10DDR5.AMD2   ID and output prefix
+ *   group 1 2 10 5 16      domains ranksPerDomain devicesPerRank
+ *                          pinsPerDevice blkHeight (DomainGroupDDR)
+ *   msg 2 16 0 0 1 4 10 1 EXTRACHIP   MSGConfig arguments (optional)
+ *   hbm 1                  HBM fault rates and setup (with msg only)
+ *   detailed 0             simple fault model (with msg only)
+ *   ecc AMDChipkill_FLEX false true   ECC class and constructor arguments
+ *   max_retired 0          ECC::setMaxRetiredBlkCount() (optional)
+ *   retire 0               ECC::setDoRetire() (optional)
+ *   banks_per_beat 1       sets BANKSPERBEAT (optional)
+ *   scrubber periodic 8    none, periodic Hours, patrol Hours or demand
+ * The IDs of the simulator are bundled presets in this format (see
+ * "faulterrorsim systems"); files loaded with loadSystems() add systems or
+ * replace presets of the same ID.
+ */
+
+#ifndef __SYSTEMS_HH__
+#define __SYSTEMS_HH__
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+class DomainGroup;
+class ECC;
+class Scrubber;
+
+/** @class SystemSpec
+ * \brief Description of one target system
+ */
+struct SystemSpec {
+  int id = -1;
+  std::string name;  //!< output prefix, without the ".<seed>"
+  //! domains, ranksPerDomain, devicesPerRank, pinsPerDevice, blkHeight
+  std::vector<int> group;
+  std::vector<std::string> msg;  //!< MSGConfig arguments (empty: none)
+  bool hbm = false;
+  bool detailed = true;
+  std::vector<std::string> ecc;  //!< class name and constructor arguments
+  long long maxRetired = -1;     //!< -1: ECC default
+  int retire = -1;               //!< -1: ECC default
+  int banksPerBeat = 0;          //!< 0: leave BANKSPERBEAT alone
+  std::vector<std::string> scrubber = {"periodic", "8"};
+
+  void print(FILE *fd) const;  //!< in the format above
+};
+
+/** @class ECCArgs
+ * \brief Constructor arguments of a registered ECC class
+ * @details Missing arguments take the given default (the constructor's);
+ * malformed ones end the program.
+ */
+class ECCArgs {
+ public:
+  ECCArgs(const std::vector<std::string> &_args) : args(_args) {}
+  size_t size() const { return args.size() - 1; }
+  int i(size_t pos, int def = 0) const;
+  bool b(size_t pos, bool def = false) const;
+
+ protected:
+  const std::vector<std::string> &args;  //!< class name first
+};
+
+//! make "name" available to the "ecc" key; "make" gets between minArgs and
+//! maxArgs constructor arguments
+void registerECC(const std::string &name, int minArgs, int maxArgs,
+                 ECC *(*make)(const ECCArgs &args));
+//! new ECC of class ecc[0] with the arguments ecc[1..] (NULL, after printing
+//! why, for an unknown class or a wrong number of arguments)
+ECC *createECC(const std::vector<std::string> &ecc);
+
+//! add the systems of "fileName"; false (after printing why) if the file is
+//! missing or malformed
+bool loadSystems(const char *fileName);
+//! system "id" (NULL if unknown)
+const SystemSpec *findSystem(int id);
+//! every known system in ID order
+std::vector<const SystemSpec *> listSystems();
+
+//! Build the DomainGroup and ECC of "spec" and write its name
+//! ("<name>.<seedName>") to filePrefix. Returns false for an unknown ECC.
+bool buildSystem(const SystemSpec &spec, const char *seedName,
+                 DomainGroup *&dg, ECC *&ecc, char *filePrefix);
+//! buildSystem() of system "id"; false for an unknown ID
+bool buildSystem(int id, const char *seedName, DomainGroup *&dg, ECC *&ecc,
+                 char *filePrefix);
+//! scrubber of system evaluations of "spec"
+Scrubber *buildScrubber(const SystemSpec &spec);
+
+#endif /* __SYSTEMS_HH__ */
@@ -39,10 +39,14 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #include <assert.h>
 #include <math.h>
+#include <functional>
+#include <random>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <signal.h>
 #include <unistd.h>
+#include <sys/wait.h>
 
 #include "Config.hh"
 #include "DomainGroup.hh"
@@ -67,13 +71,74 @@ void TesterSystem::reset()
     RetireCntYear[i] = 0l;
     DUECntYear[i] = 0l;
     SDCCntYear[i] = 0l;
+    RetireWgtYear[i] = DUEWgtYear[i] = SDCWgtYear[i] = 0.;
+    RetireWgtSqYear[i] = DUEWgtSqYear[i] = SDCWgtSqYear[i] = 0.;
   }
+  memset(typeWgtYear, 0, sizeof(typeWgtYear));
+  memset(typeWgtSqYear, 0, sizeof(typeWgtSqYear));
+  histogram.clear();
+}
+
+//------------------------------------------------------------------------------
+// FNV-1a over "size" bytes at "data", continuing from "hash"
+static uint64_t hashBytes(uint64_t hash, const void *data, size_t size)
+{
+  const unsigned char *bytes = (const unsigned char *)data;
+  for (size_t i = 0; i < size; i++)
+    hash = (hash ^ bytes[i]) * 1099511628211ull;
+  return hash;
+}
+
+static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+
+//------------------------------------------------------------------------------
+uint64_t TesterSystem::getCounterChecksum()
+{
+  uint64_t hash = FNV_OFFSET_BASIS;
+  hash = hashBytes(hash, RetireCntYear, sizeof(RetireCntYear));
+  hash = hashBytes(hash, DUECntYear, sizeof(DUECntYear));
+  hash = hashBytes(hash, SDCCntYear, sizeof(SDCCntYear));
+  // the weight sums only differ from the counts in weighted modes
+  hash = hashBytes(hash, RetireWgtYear, sizeof(RetireWgtYear));
+  hash = hashBytes(hash, DUEWgtYear, sizeof(DUEWgtYear));
+  hash = hashBytes(hash, SDCWgtYear, sizeof(SDCWgtYear));
+  hash = hashBytes(hash, RetireWgtSqYear, sizeof(RetireWgtSqYear));
+  hash = hashBytes(hash, DUEWgtSqYear, sizeof(DUEWgtSqYear));
+  hash = hashBytes(hash, SDCWgtSqYear, sizeof(SDCWgtSqYear));
+  hash = hashBytes(hash, typeWgtYear, sizeof(typeWgtYear));
+  hash = hashBytes(hash, typeWgtSqYear, sizeof(typeWgtSqYear));
+  return hash;
+}
+
+// weighted mean and its standard error
+static void printWeighted(FILE *fd, double sum, double sqSum, long runNum)
+{
+  double mean = sum / runNum;
+  double var = sqSum / runNum - mean * mean;
+  double stdErr = (runNum > 1 && var > 0) ? sqrt(var / (runNum - 1)) : 0.;
+  fprintf(fd, "%.11e %.11e\n", mean, stdErr);
 }
 
 //------------------------------------------------------------------------------
 void TesterSystem::printSummary(FILE *fd, long runNum)
 {
   fprintf(fd, "After %ld runs\n", runNum);
+  printIntervals(fd, runNum);
+  if (weighted)
+  {
+    // importance sampling: "mean stderr" per year
+    fprintf(fd, "Retire (weighted)\n");
+    for (int yr = 1; yr < MAX_YEAR; yr++)
+      printWeighted(fd, RetireWgtYear[yr], RetireWgtSqYear[yr], runNum);
+    fprintf(fd, "DUE (weighted)\n");
+    for (int yr = 1; yr < MAX_YEAR; yr++)
+      printWeighted(fd, DUEWgtYear[yr], DUEWgtSqYear[yr], runNum);
+    fprintf(fd, "SDC (weighted)\n");
+    for (int yr = 1; yr < MAX_YEAR; yr++)
+      printWeighted(fd, SDCWgtYear[yr], SDCWgtSqYear[yr], runNum);
+    fflush(fd);
+    return;
+  }
   fprintf(fd, "Retire\n");
   for (int yr = 1; yr < MAX_YEAR; yr++)
   {
@@ -93,10 +158,224 @@ void TesterSystem::printSummary(FILE *fd, long runNum)
   fflush(fd);
 }
 
+//------------------------------------------------------------------------------
+void TesterSystem::saveResult(long runNum)
+{
+  RunResult result = runInfo;
+  result.trials = runNum;
+  result.weighted = weighted;
+  result.resize(MAX_YEAR, ERRORENUM);
+  for (int i = 0; i < ERRORENUM; i++)
+  {
+    // ErrorENUMNAME pads some of the names with a space
+    std::string name = ErrorENUMNAME[i];
+    result.typeNames[i] = name.substr(0, name.find(' '));
+  }
+  const long *cnt[3] = {RetireCntYear, DUECntYear, SDCCntYear};
+  const double *wgt[3] = {RetireWgtYear, DUEWgtYear, SDCWgtYear};
+  const double *wgtSq[3] = {RetireWgtSqYear, DUEWgtSqYear, SDCWgtSqYear};
+  for (int kind = 0; kind < 3; kind++)
+  {
+    for (int yr = 0; yr < MAX_YEAR; yr++)
+    {
+      result.count[kind][yr] = cnt[kind][yr];
+      result.weight[kind][yr] = wgt[kind][yr];
+      result.weightSq[kind][yr] = wgtSq[kind][yr];
+    }
+  }
+  // FaultDomain::setFaultStats(type, yr) adds up with DUE/SDCCntYear[yr],
+  // which sumFaultStats() reads back as year yr + 1
+  double stats[ERRORENUM];
+  for (int type = DUE; type <= SDC; type++)
+  {
+    int k = type - DUE;
+    for (int yr = 0; yr < MAX_YEAR; yr++)
+    {
+      if (weighted)
+      {
+        result.typeCount[k][yr].assign(typeWgtYear[k][yr],
+                                       typeWgtYear[k][yr] + ERRORENUM);
+        result.typeWeightSq[k][yr].assign(typeWgtSqYear[k][yr],
+                                          typeWgtSqYear[k][yr] + ERRORENUM);
+        continue;
+      }
+      _dg->sumFaultStats((ErrorType)type, yr + 1, stats);
+      result.typeCount[k][yr].assign(stats, stats + ERRORENUM);
+    }
+  }
+  if (!result.save((logName + ".result").c_str()))
+    printf("Cannot write %s.result\n", logName.c_str());
+}
+
+//------------------------------------------------------------------------------
+void TesterSystem::printCurves(FILE *fd)
+{
+  if (curveHr.empty()) return;
+  fprintf(fd, "Cumulative probability by horizon (years: Retire DUE SDC)\n");
+  for (double hr : curveHr)
+  {
+    fprintf(fd, "%g", hr / (24 * 365));
+    for (int kind = 0; kind < FailureHistogram::NUM_KINDS; kind++)
+    {
+      fprintf(fd, " %.11e", histogram.cumulative(kind, hr));
+      if (!weighted)
+      {
+        Interval ci = histogram.cumulativeInterval(kind, hr);
+        fprintf(fd, " [%.3e, %.3e]", ci.lo, ci.hi);
+      }
+    }
+    fprintf(fd, "\n");
+  }
+  fflush(fd);
+}
+
+//------------------------------------------------------------------------------
+double TesterSystem::getEstimate(int kind, int yr, long runNum)
+{
+  if (weighted)
+  {
+    if (kind == 0)
+      return RetireWgtYear[yr] / runNum;
+    else if (kind == 1)
+      return DUEWgtYear[yr] / runNum;
+    return SDCWgtYear[yr] / runNum;
+  }
+  if (kind == 0)
+    return (double)RetireCntYear[yr] / runNum;
+  else if (kind == 1)
+    return (double)DUECntYear[yr] / runNum;
+  return (double)SDCCntYear[yr] / runNum;
+}
+
+//------------------------------------------------------------------------------
+Interval TesterSystem::getInterval(int kind, int yr, long runNum)
+{
+  if (weighted)
+  {
+    if (kind == 0)
+      return weightedInterval(RetireWgtYear[yr], RetireWgtSqYear[yr], runNum);
+    else if (kind == 1)
+      return weightedInterval(DUEWgtYear[yr], DUEWgtSqYear[yr], runNum);
+    return weightedInterval(SDCWgtYear[yr], SDCWgtSqYear[yr], runNum);
+  }
+  if (kind == 0)
+    return wilsonInterval(RetireCntYear[yr], runNum);
+  else if (kind == 1)
+    return wilsonInterval(DUECntYear[yr], runNum);
+  return wilsonInterval(SDCCntYear[yr], runNum);
+}
+
+//------------------------------------------------------------------------------
+bool TesterSystem::isPrecise(DomainGroup *dg, long runNum)
+{
+  double estimate[3 * (MAX_YEAR - 1)];
+  Interval ci[3 * (MAX_YEAR - 1)];
+  int n = 0;
+  for (int kind = 0; kind < 3; kind++)
+  {
+    for (int yr = 1; yr < MAX_YEAR; yr++, n++)
+    {
+      estimate[n] = getEstimate(kind, yr, runNum);
+      ci[n] = getInterval(kind, yr, runNum);
+    }
+  }
+  if (!estimatesPrecise(estimate, ci, n, runNum))
+    return false;
+  // attribution of the last year's DUE/SDC to fault types
+  double share[ERRORENUM];
+  Interval shareCI[ERRORENUM];
+  for (int k = 0; k < 2; k++)
+  {
+    if (!getTypeShares(dg, k, runNum, share, shareCI))
+      continue;
+    for (int i = 0; i < ERRORENUM; i++)
+    {
+      if (!shareCI[i].precise(share[i], targetRelError))
+        return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TesterSystem::getTypeShares(DomainGroup *dg, int k, long runNum,
+                                 double *share, Interval *ci)
+{
+  int yr = MAX_YEAR - 1;
+  if (weighted)
+  {
+    // ratio of the type's weight to the outcome's; the interval is the one
+    // of the type's probability, scaled by the outcome estimate
+    double total = (k == 0) ? DUEWgtYear[yr] : SDCWgtYear[yr];
+    if (total <= 0)
+      return false;
+    for (int i = 0; i < ERRORENUM; i++)
+    {
+      share[i] = typeWgtYear[k][yr][i] / total;
+      ci[i] = weightedInterval(typeWgtYear[k][yr][i], typeWgtSqYear[k][yr][i],
+                               runNum);
+      ci[i].lo *= runNum / total;
+      ci[i].hi *= runNum / total;
+    }
+    return true;
+  }
+  // setFaultStats() adds up with DUE/SDCCntYear[yr], read back as year yr + 1
+  long cnt = (k == 0) ? DUECntYear[yr] : SDCCntYear[yr];
+  if (cnt == 0)
+    return false;
+  double stats[ERRORENUM];
+  dg->sumFaultStats((ErrorType)(DUE + k), yr + 1, stats);
+  for (int i = 0; i < ERRORENUM; i++)
+  {
+    share[i] = stats[i] / cnt;
+    ci[i] = wilsonInterval(stats[i], cnt);
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void TesterSystem::printIntervals(FILE *fd, long runNum)
+{
+  if (runNum <= 0)
+    return;
+  const char *kindName[3] = {"Retire", "DUE", "SDC"};
+  fprintf(fd, "95%% intervals (%s)\n", weighted ? "normal" : "Wilson");
+  for (int kind = 0; kind < 3; kind++)
+  {
+    for (int yr = 1; yr < MAX_YEAR; yr++)
+    {
+      Interval ci = getInterval(kind, yr, runNum);
+      fprintf(fd, "%s %d [%.11e, %.11e]\n", kindName[kind], yr, ci.lo, ci.hi);
+    }
+  }
+  if (_dg == NULL)
+    return;
+  double share[ERRORENUM];
+  Interval ci[ERRORENUM];
+  for (int k = 0; k < 2; k++)
+  {
+    if (!getTypeShares(_dg, k, runNum, share, ci))
+      continue;
+    double shareSum = 0.;
+    for (int i = 0; i < ERRORENUM; i++)
+    {
+      if (share[i] <= 0)
+        continue;
+      fprintf(fd, "%s share %s %.6f [%.6f, %.6f]\n", kindName[k + 1],
+              ErrorENUMNAME[i], share[i], ci[i].lo, ci[i].hi);
+      shareSum += share[i];
+    }
+    // every DUE/SDC is split over the fault types involved in it
+    if (fabs(shareSum - 1.) > 1e-3)
+      fprintf(fd, "Warning: %s shares sum to %.6f\n", kindName[k + 1],
+              shareSum);
+  }
+}
+
 //------------------------------------------------------------------------------
 double TesterSystem::advance(double faultRate)
 {
-  double r = (double)rand();
+  double r = (double)timelineRand();
   long long randmax = RAND_MAX;
   double result =
       -log(1.0f - (double)r / (randmax + 1)) / faultRate;
@@ -112,15 +391,69 @@ void sigterm_handler(int sig)
 void TesterSystem::test(DomainGroup *dg, ECC *ecc, Scrubber *scrubber,
                         long runCnt, char *filePrefix, int faultCount,
                         std::string *faults)
+{
+  begin(dg, ecc, scrubber, filePrefix, faultCount, faults);
+  signal(SIGTERM, sigterm_handler);
+
+  long runNum = 0;
+  // for runCnt times (or until the estimates are precise enough)
+  long trialCap = getTrialCap(runCnt);
+  if (corpusReader != NULL)
+    trialCap = std::min(trialCap, (long)corpusReader->getHeader().trials);
+  for (runNum = 0; runNum < trialCap; runNum++)
+  {
+    if (runNum % 10000000 == 0)
+    {
+      // if (runNum%1000000==0) {
+      printf("Processing %ldth iteration\n", runNum);
+    }
+    if (stopCheckDue(runNum) && isPrecise(dg, runNum))
+    {
+      printf("Target precision reached after %ld runs\n", runNum);
+      break;
+    }
+
+    step(runNum);
+
+    if (killflag)
+    {
+      printSummary(logFd, runNum);
+      dg->printFaultStats(stdout, DUECntYear[MAX_YEAR - 1], SDCCntYear[MAX_YEAR - 1], MAX_YEAR);
+      break;
+    }
+  }
+
+  finish(runNum);
+}
+
+// FNV-1a hash of the fault type names a corpus refers to by index
+static uint32_t getTypeHash(FaultRateInfo *rateInfo)
+{
+  uint32_t hash = 2166136261u;
+  for (int i = 0; i < rateInfo->getEntryCount(); i++)
+  {
+    const std::string &name = rateInfo->getEntry(i)->first;
+    for (size_t c = 0; c <= name.size(); c++)
+      hash = (hash ^ (unsigned char)name.c_str()[c]) * 16777619u;
+  }
+  return hash;
+}
+
+//------------------------------------------------------------------------------
+void TesterSystem::begin(DomainGroup *dg, ECC *ecc, Scrubber *scrubber,
+                         char *filePrefix, int faultCount,
+                         std::string *faults)
 {
   // assert(faultCount<=1);  // either no or 1 inherent fault
   dg->setTester(this, ecc);
-  Fault *inherentFault = NULL;
+  dg->setScrubber(scrubber);
+  scrubPeriod = scrubber->getPeriod();
+  inherentFault = NULL;
   // create log file
-  std::string nameBuffer = std::string(filePrefix) + ".S";
+  logName = std::string(filePrefix) + ".S";
   if (faultCount == 2)
   {
-    nameBuffer = nameBuffer + "." + faults[0];
+    logName = logName + "." + faults[0];
     inherentFault = Fault::genRandomFault(faults[0], NULL);
     // dg->setInherentFault(inherentFault);
     dg->setInherentFault(inherentFault, ecc, true);
@@ -131,8 +464,8 @@ void TesterSystem::test(DomainGroup *dg, ECC *ecc, Scrubber *scrubber,
     // faults[1] is high-prob weak cell activation probability (e.g. 0.1)
     // faults[2] is initial high prob freq. weak cells
     // faults[3] is high-prob freq. weak cell activation probability (e.g. 0.1)
-    nameBuffer = nameBuffer + "." + faults[0] + "." + faults[1] + "." +
-                 faults[2] + "." + faults[3];
+    logName = logName + "." + faults[0] + "." + faults[1] + "." + faults[2] +
+              "." + faults[3];
     inherentFault = Fault::genRandomFault(faults[0], NULL);
     setRatioFWC(inherentFault->getCellFaultRate());
     setActiveProbFWC(std::stod(faults[1]));
@@ -151,236 +484,1253 @@ void TesterSystem::test(DomainGroup *dg, ECC *ecc, Scrubber *scrubber,
     // accept only two cases?
     assert(0);
   }
-  signal(SIGTERM, sigterm_handler);
 
-  FILE *fd = fopen(nameBuffer.c_str(), "w");
-  assert(fd != NULL);
-  dg->pickRandomFD()->faultRateInfo->printFaults();
+  logFd = fopen(logName.c_str(), "w");
+  assert(logFd != NULL);
+  // rate arguments of the .result file: the log name after "<prefix>."
+  runInfo.params = logName.substr(strlen(filePrefix) + 1);
+  dg->getFD()->faultRateInfo->printFaults();
 
   // reset statistics
+  histogram.resize(horizonHr);
   reset();
-  long runNum = 0;
-  // for runCnt times
-  for (runNum = 0; runNum < runCnt; runNum++)
+  profile.clear();
+  profileTotal = 0;
+  _dg = dg;
+  _ecc = ecc;
+  replayPos = 0;
+  FaultRateInfo *rateInfo = dg->getFD()->faultRateInfo;
+  if (corpusReader != NULL)
   {
-    if ((runNum == 100) || ((runNum != 0) && (runNum % 1000000 == 0)))
+    const FaultCorpusHeader &header = corpusReader->getHeader();
+    if ((header.domainCount != (uint32_t)dg->getFDCount()) ||
+        (header.typeCount != (uint32_t)rateInfo->getEntryCount()) ||
+        (header.typeHash != getTypeHash(rateInfo)) ||
+        (header.horizonHr != horizonHr))
     {
-      printSummary(fd, runNum);
-      dg->printFaultStats(stdout, DUECntYear[MAX_YEAR - 1], SDCCntYear[MAX_YEAR - 1], MAX_YEAR);
+      printf("The fault corpus was recorded for another system\n");
+      exit(1);
+    }
+  }
+  if (corpusWriter != NULL)
+  {
+    if (!corpusWriter->open(corpusName.c_str(), dg->getFDCount(),
+                            rateInfo->getEntryCount(), getTypeHash(rateInfo),
+                            horizonHr))
+    {
+      printf("Cannot open %s\n", corpusName.c_str());
+      exit(1);
+    }
+  }
+  if (eventLogWriter != NULL)
+  {
+    if (!eventLogWriter->open(eventLogName.c_str(), eventLogSample,
+                              eventLogMax))
+    {
+      printf("Cannot open %s\n", eventLogName.c_str());
+      exit(1);
     }
+  }
+}
 
-    if (runNum % 10000000 == 0)
+//------------------------------------------------------------------------------
+void TesterSystem::step(long runNum)
+{
+  DomainGroup *dg = _dg;
+  ECC *ecc = _ecc;
+  trialIdx = runNum;
+  if ((runNum == 100) || ((runNum != 0) && (runNum % 1000000 == 0)))
+  {
+    printSummary(logFd, runNum);
+    dg->printFaultStats(stdout, DUECntYear[MAX_YEAR - 1], SDCCntYear[MAX_YEAR - 1], MAX_YEAR);
+  }
+
+  if (inherentFault != NULL)
+  {
+    // inherent rates of the domains touched in the previous run are
+    // restored by dg->clear()
+    dg->setInitialRetiredBlkCount(ecc, getRatioFWC());
+  }
+
+  // GONG: setting chip failure in advance
+  //		dg->setSingleChipFault();
+  //		dg->updateInherentFault(ecc);
+
+  ProfileCounters before = profileCounters;
+  uint64_t start = profileTicks();
+  runTrial(dg, ecc);
+  profileTotal += profileTicks() - start;
+  profile.addDelta(profileCounters, before);
+  histogram.addTrials(1);
+
+  // weighted sums are accumulated per run, as the split continuations of
+  // a run are not independent
+  lastTrialWgt[0] = trialRetireWgt[MAX_YEAR - 1];
+  lastTrialWgt[1] = trialDUEWgt[MAX_YEAR - 1];
+  lastTrialWgt[2] = trialSDCWgt[MAX_YEAR - 1];
+  for (int i = 0; i < MAX_YEAR; i++)
+  {
+    RetireWgtYear[i] += trialRetireWgt[i];
+    RetireWgtSqYear[i] += trialRetireWgt[i] * trialRetireWgt[i];
+    DUEWgtYear[i] += trialDUEWgt[i];
+    DUEWgtSqYear[i] += trialDUEWgt[i] * trialDUEWgt[i];
+    SDCWgtYear[i] += trialSDCWgt[i];
+    SDCWgtSqYear[i] += trialSDCWgt[i] * trialSDCWgt[i];
+    trialRetireWgt[i] = trialDUEWgt[i] = trialSDCWgt[i] = 0.;
+  }
+  if (weighted)
+  {
+    for (int k = 0; k < 2; k++)
     {
-      // if (runNum%1000000==0) {
-      printf("Processing %ldth iteration\n", runNum);
+      for (int i = 0; i < MAX_YEAR; i++)
+      {
+        for (int t = 0; t < ERRORENUM; t++)
+        {
+          double w = trialTypeWgt[k][i][t];
+          typeWgtYear[k][i][t] += w;
+          typeWgtSqYear[k][i][t] += w * w;
+          trialTypeWgt[k][i][t] = 0.;
+        }
+      }
+    }
+  }
+
+  dg->clear();
+  ecc->clear();
+}
+
+//------------------------------------------------------------------------------
+void TesterSystem::finish(long runNum)
+{
+  _dg->printFaultStatsAll(stdout, DUECntYear, SDCCntYear, MAX_YEAR);
+  // dg->printFaultStats(stdout,DUECntYear[MAX_YEAR-1],SDCCntYear[MAX_YEAR-1],MAX_YEAR);
+
+  printSummary(logFd, runNum);
+  // ecc->printHistogram();
+  fclose(logFd);
+  logFd = NULL;
+  printCurves(stdout);
+  profile.print(stdout, logName.c_str(), profileTotal);
+  histogram.save((logName + ".hist").c_str());
+  saveResult(runNum);
+  if (corpusWriter != NULL)
+  {
+    corpusWriter->setTrials(runNum);
+    corpusWriter->close();
+  }
+  if (eventLogWriter != NULL)
+    eventLogWriter->close();
+}
+
+//------------------------------------------------------------------------------
+void TesterSystem::scheduleArrival(DomainGroup *dg, double now)
+{
+  // pending arrivals carrying an older sequence number are ignored, which
+  // is exact since the arrival process is memoryless
+  arrivalSeq++;
+  if (corpusReader != NULL)
+  {
+    // replay: the next recorded arrival of this run
+    if ((replayPos < corpusReader->getRecordCount()) &&
+        (corpusReader->getRecords()[replayPos].trial == trialIdx))
+    {
+      SimEvent event = {corpusReader->getRecords()[replayPos].hr,
+                        EV_FAULT_ARRIVAL, NULL, arrivalSeq, 0.};
+      events.push(event);
     }
+    return;
+  }
+  double rate = dg->getFaultRate() * rateScale;
+  if (weighted)
+    rateBias = rate - dg->getNominalFaultRate() * rateScale;
+  double next;
+  if ((remainingArrivals >= 0) && (rate == poissonRate))
+  {
+    // the fault count of the run is known: given k faults left in
+    // (now, horizon], the next one is the minimum of k uniform times
+    if (remainingArrivals == 0)
+      return;
+    double u = std::uniform_real_distribution<double>(0., 1.)(randomGenerator);
+    next = now + (horizonHr - now) * (1. - pow(u, 1. / remainingArrivals));
+    remainingArrivals--;
+  }
+  else
+  {
+    // the rate changed (e.g., inherent faults): the process after this
+    // arrival is a fresh Poisson process, so fall back to exponential gaps
+    remainingArrivals = -1;
+    if (rate <= 0)
+      return;
+    next = now + advance(rate);
+  }
+  SimEvent event = {next, EV_FAULT_ARRIVAL, NULL, arrivalSeq, 0.};
+  events.push(event);
+}
 
-    if (inherentFault != NULL)
+//------------------------------------------------------------------------------
+void TesterSystem::runTrial(DomainGroup *dg, ECC *ecc)
+{
+  events.clear();
+  rateScale = 1.;
+  schedule(EV_HORIZON, horizonHr);
+  for (auto it = rateProfile.begin(); it != rateProfile.end(); ++it)
+  {
+    if ((*it).first <= 0)
+      rateScale = (*it).second;
+    else if ((*it).first < horizonHr)
+      schedule(EV_RATE_CHANGE, (*it).first, NULL, (*it).second);
+  }
+  // Fast-forward: most runs see no fault at all over the lifetime, so draw
+  // the number of faults of the group (the superposition of all domains)
+  // first and finish fault-free runs right away. The arrival times of the
+  // remaining runs are the order statistics of uniform times, which places
+  // a single fault uniformly and decodes it only once.
+  remainingArrivals = -1;
+  logLR = 0.;
+  biasIntegral = 0.;
+  lastRateHr = 0.;
+  errorCounter = 0;
+  countedArrivals = 0;
+  arrivalHash = FNV_OFFSET_BASIS;
+  if (corpusReader != NULL)
+  {
+    // skip the arrivals left over by the previous run
+    while ((replayPos < corpusReader->getRecordCount()) &&
+           (corpusReader->getRecords()[replayPos].trial < trialIdx))
+      replayPos++;
+    scheduleArrival(dg, 0.);
+    continueTrial(dg, ecc, 0, 1.);
+    return;
+  }
+  if (conditional)
+  {
+    // Conditional Monte Carlo: with the scrub period P, the first arrival
+    // is T1 = P*J + phase where J is geometric (P(J >= j) = q^j with
+    // q = exp(-rate*P)) and the phase is an exponential truncated to [0, P).
+    // Deadlines repeat every P, so the run only depends on the phase: it is
+    // simulated with T1 = phase and J is integrated out by getEndProb().
+    assert(rateProfile.empty() && !FaultRateCatalog::isBiased());
+    firstRate = dg->getFaultRate();
+    if (firstRate <= 0)
+      return;
+    double phase = 0.;
+    if (scrubPeriod > 0)
     {
-      dg->resetInherentFault(inherentFault, ecc);
-      dg->setInitialRetiredBlkCount(ecc, getRatioFWC());
+      firstQ = exp(-firstRate * scrubPeriod);
+      double u = std::uniform_real_distribution<double>(0., 1.)(randomGenerator);
+      phase = -log1p(-u * (1. - firstQ)) / firstRate;
     }
+    arrivalSeq++;
+    SimEvent event = {phase, EV_FAULT_ARRIVAL, NULL, arrivalSeq, 0.};
+    events.push(event);
+    continueTrial(dg, ecc, 0, 1.);
+    return;
+  }
+  if (fastForward && rateProfile.empty())
+  {
+    poissonRate = dg->getFaultRate();
+    long faultCnt = 0;
+    if (poissonRate > 0)
+      faultCnt = std::poisson_distribution<long>(poissonRate * horizonHr)(randomGenerator);
+    if (faultCnt == 0)
+      return;
+    remainingArrivals = faultCnt;
+  }
+  scheduleArrival(dg, 0.);
+  continueTrial(dg, ecc, 0, 1.);
+}
 
-    // GONG: setting chip failure in advance
-    //		dg->setSingleChipFault();
-    //		dg->updateInherentFault(ecc);
+//------------------------------------------------------------------------------
+void TesterSystem::continueTrial(DomainGroup *dg, ECC *ecc, int level,
+                                 double splitWeight)
+{
+  TrialOutcome outcome;
+  outcome.result = NE;
+  outcome.retired = false;
+  outcome.hr = 0.;
+  outcome.fd = NULL;
+  // a recorded run goes on to the horizon after its outcome, so that other
+  // ECCs replaying it find every arrival
+  bool ended = false;
 
-    double hr = 0.;
-    int CEcounter = 0;
-    int errorCounter = 0;
+  while (!killflag && !events.empty())
+  {
+    SimEvent event = events.pop();
+    double hr = event.time;
+    outcome.hr = hr;
+    biasIntegral += rateBias * (hr - lastRateHr);
+    lastRateHr = hr;
 
-    bool hr_datagen = false;
-    while (true)
+    switch (event.type)
     {
-      if (killflag)
-      {
+    case EV_HORIZON:
+      return;
+    case EV_RETIRE:
+      if (ended)
         break;
-      }
-      // 1. Advance
-      double prevHr = hr;
-      double delta = advance(dg->getFaultRate());
-      hr += delta;
-      if (dg->getFaultRate() > 2.7801302490616151e-07)
+      outcome.retired = true;
+      outcome.fd = event.fd;
+      finishTrial(ecc, &outcome, splitWeight);
+      if (corpusWriter == NULL)
+        return;
+      ended = true;
+      break;
+    case EV_SCRUB:
+      // scrub soft errors
+      event.fd->expireTransients(hr);
+      break;
+    case EV_RATE_CHANGE:
+      rateScale = event.value;
+      scheduleArrival(dg, hr);
+      break;
+    case EV_FAULT_ARRIVAL:
+    {
+      if (event.seq != arrivalSeq)
+        break; // superseded by a rate change
+      // 1. Pick random Fault domain (and scrub its expired soft errors)
+      FaultRecord record;
+      FaultRecord *recordPtr = NULL;
+      FaultDomain *fd;
+      if (corpusReader != NULL)
       {
-        int a = 10;
+        record = corpusReader->getRecords()[replayPos++];
+        fd = dg->getFD(record.domain, hr);
+        recordPtr = &record;
       }
-
-      // 2. Pick random Fault domain
-      FaultDomain *fd = dg->pickRandomFD();
-
-      if (hr > (MAX_YEAR - 1) * 24 * 365)
+      else
       {
-        // if (hr > 5856) {
-        // fd->printOperationalFaults();
-        // fd->printVisualFaults();
-        break;
+        fd = dg->pickRandomFD(hr);
+        if (corpusWriter != NULL)
+        {
+          memset(&record, 0, sizeof(record));
+          record.hr = hr;
+          record.trial = trialIdx;
+          record.domain = fd->groupIdx;
+          record.seed = splitmix64(
+              corpusSeed ^ splitmix64(corpusWriter->getRecordCount()));
+          recordPtr = &record;
+        }
       }
       errorCounter++;
-      updateElapsedTime(hr);
-      if (errorCounter > 100000)
+      if (remainingArrivals >= 0)
       {
-        break;
+        // drawn from the fault count of the run, which any ECC on this
+        // geometry shares (see TesterPaired)
+        countedArrivals++;
+        arrivalHash = hashBytes(arrivalHash, &hr, sizeof(hr));
+        arrivalHash =
+            hashBytes(arrivalHash, &fd->groupIdx, sizeof(fd->groupIdx));
       }
+      updateElapsedTime(hr);
+      if (errorCounter > 100000)
+        return;
 
-      // fd->printTransientFaults();
-      //  2. scrub soft errors
-      scrubber->scrub(dg, hr);
-
-      // 4. generate an error and decode it
-      ErrorType result = fd->genSystemRandomFaultAndTest(ecc);
+      // 2. generate an error and decode it
+      ErrorType result =
+          fd->genSystemRandomFaultAndTest(ecc, recordPtr, corpusReader != NULL);
+      if (corpusWriter != NULL)
+        corpusWriter->append(record);
 
       // GONG: update inherent fault
-      dg->updateInherentFault(ecc);
+      dg->updateInherentFault(fd, ecc);
+      if (ended)
+      {
+        scheduleArrival(dg, hr);
+        break;
+      }
 
-      // 5. process result
+      // 3. process result
       // default : PF retirement
-
       if (fd->getRetiredBlkCount() >= 25 * 1024 && (result != CE))
       {
-        printf("-------------RETIRE: hours %lf (%lfyrs),i retiredBlkCount: \
-        %lld maxRetiredBlkCount: %lld\n",
-               hr, hr / (24 * 365),
-               fd->getRetiredBlkCount(), ecc->getMaxRetiredBlkCount());
-        for (int i = 0; i < MAX_YEAR; i++)
-        {
-          if (hr < i * 24 * 365)
-          {
-            RetireCntYear[i]++;
-          }
-        }
+        schedule(EV_RETIRE, hr, fd);
+        // a recorded run keeps drawing arrivals after the retirement
+        if (corpusWriter != NULL)
+          scheduleArrival(dg, hr);
         break;
       }
-      else if (result == DUE)
+      else if ((result == DUE) || (result == SDC))
       {
-        // printf("===DUE: hours %lf (%lfyrs), isPFmode() %d  ", hr,
-        // hr/(24*365), fd->faultRateInfo->iRate->IsPFmode());
-        // printf("tick %d \n",runNum);
-        printf("%lf DUE-", hr);
-        fd->printOperationalFaults();
-        // fd->printVisualFaults();
-        // printf("\n");
-        CEcounter = 0;
-        for (int i = 0; i < MAX_YEAR; i++)
-        {
-          if (hr < i * 24 * 365)
-          {
-            DUECntYear[i]++;
-            fd->setFaultStats(DUE, i);
-          }
-        }
-        break;
+        outcome.result = result;
+        outcome.fd = fd;
+        finishTrial(ecc, &outcome, splitWeight);
+        if (corpusWriter == NULL)
+          return;
+        ended = true;
       }
-      else if (result == SDC)
+      // 4. split the run when it reaches a more dangerous state
+      int newLevel = (splitFactor > 1) ? getSplitLevel(fd) : 0;
+      if (newLevel > level)
       {
-        // printf("***SDC: hours %lf (%lfyrs), isPFmode() %d  ", hr,
-        // hr/(24*365), fd->faultRateInfo->iRate->IsPFmode());
-        // printf("tick %d \n",runNum);
-        printf("%lf SDC-", hr);
-        fd->printOperationalFaults();
-        // fd->printVisualFaults();
-
-        CEcounter = 0;
-        for (int i = 0; i < MAX_YEAR; i++)
-        {
-          if (hr < i * 24 * 365)
-          {
-            SDCCntYear[i]++;
-            fd->setFaultStats(SDC, i);
-          }
-        }
-        break;
+        split(dg, ecc, hr, newLevel, splitWeight);
+        return;
       }
-    }
-
-    if (killflag)
-    {
-      printSummary(fd, runNum);
-      dg->printFaultStats(stdout, DUECntYear[MAX_YEAR - 1], SDCCntYear[MAX_YEAR - 1], MAX_YEAR);
+      scheduleArrival(dg, hr);
       break;
     }
-
-    dg->clear();
-    ecc->clear();
+    default:
+      assert(0);
+    }
   }
-
-  dg->printFaultStatsAll(stdout, DUECntYear, SDCCntYear, MAX_YEAR);
-  // dg->printFaultStats(stdout,DUECntYear[MAX_YEAR-1],SDCCntYear[MAX_YEAR-1],MAX_YEAR);
-
-  printSummary(fd, runNum);
-  // ecc->printHistogram();
-  fclose(fd);
 }
 
 //------------------------------------------------------------------------------
-//------------------------------------------------------------------------------
-void TesterScenario::reset()
+int TesterSystem::getSplitLevel(FaultDomain *fd)
 {
-  for (int i = 0; i <= SDC; i++)
+  int level = 0;
+  if (fd->permFaults())
   {
-    errorCnt[i] = 0l;
+    level = 1;
+    if (fd->overlapTest() || !fd->currentPossibleFaultList.empty())
+      level = 2;
   }
+  return std::min(level, splitLevels);
 }
+
 //------------------------------------------------------------------------------
-void TesterScenario::printSummary(FILE *fd, long runNum)
+void TesterSystem::split(DomainGroup *dg, ECC *ecc, double hr, int level,
+                         double splitWeight)
 {
-  fprintf(fd, "After %ld runs\n", runNum);
-  for (int i = 0; i <= SDC; i++)
+  // save the state right after the arrival that crossed the level
+  TrialState state;
+  dg->saveState(&state.group);
+  state.correctedPosSet = ecc->getCorrectedPosSet();
+  state.events = events;
+  state.rateScale = rateScale;
+  state.logLR = logLR;
+  state.biasIntegral = biasIntegral;
+  state.errorCounter = errorCounter;
+
+  for (int i = 0; (i < splitFactor) && !killflag; i++)
   {
-    fprintf(fd, "%s\t%.10f\n", errorName[i], (double)errorCnt[i] / runNum);
+    if (i > 0)
+    {
+      dg->restoreState(state.group);
+      ecc->setCorrectedPosSet(state.correctedPosSet);
+      events = state.events;
+      rateScale = state.rateScale;
+      logLR = state.logLR;
+      biasIntegral = state.biasIntegral;
+      errorCounter = state.errorCounter;
+      lastRateHr = hr;
+      updateElapsedTime(hr);
+    }
+    // every copy draws its own next arrival; dropping the remaining
+    // fast-forward arrivals is exact (see scheduleArrival)
+    remainingArrivals = -1;
+    scheduleArrival(dg, hr);
+    continueTrial(dg, ecc, level, splitWeight / splitFactor);
   }
-  fflush(fd);
 }
+
 //------------------------------------------------------------------------------
-void TesterScenario::test(DomainGroup *dg, ECC *ecc, Scrubber *scrubber,
-                          long runCnt, char *filePrefix, int faultCount,
-                          std::string *faults)
+void TesterSystem::finishTrial(ECC *ecc, TrialOutcome *outcome,
+                               double splitWeight)
 {
-  assert(faultCount != 0);
-  // create log file
-  std::string nameBuffer = std::string(filePrefix) + "." + faults[0];
-  for (int i = 1; i < faultCount; i++)
+  // likelihood ratio of the run: the ratios of the biased arrival (fault
+  // type) and overlap draws, times the survival term of the biased
+  // Poisson process
+  outcome->weight = splitWeight * exp(logLR + biasIntegral);
+  recordTrial(ecc, *outcome);
+}
+
+//------------------------------------------------------------------------------
+double TesterSystem::getEndProb(double hr, int year)
+{
+  double left = year * 24 * 365 - hr;
+  if (!conditional)
+    return (left > 0) ? 1. : 0.;
+  if (left <= 0)
+    return 0.;
+  if (scrubPeriod > 0)
   {
-    nameBuffer = nameBuffer + "." + faults[i];
+    // P(J < left/P) = 1 - q^ceil(left/P)
+    return 1. - pow(firstQ, ceil(left / scrubPeriod));
   }
-  FILE *fd = fopen(nameBuffer.c_str(), "w");
-  assert(fd != NULL);
+  // any shift is allowed: T1 itself is integrated out
+  return -expm1(-firstRate * left);
+}
 
-  // reset statistics
-  reset();
+//------------------------------------------------------------------------------
+void TesterSystem::recordFailure(int kind, double hr, double weight)
+{
+  if (!conditional)
+    histogram.add(kind, hr, weight);
+  else if (scrubPeriod > 0)
+    histogram.addGeometric(kind, hr, weight, scrubPeriod, firstQ);
+  else
+    histogram.addExponential(kind, hr, weight, firstRate);
+}
+
+//------------------------------------------------------------------------------
+void TesterSystem::addTypeWeights(int k, const TrialOutcome &outcome)
+{
+  double shares[ERRORENUM];
+  outcome.fd->getFaultShares(shares);
+  for (int i = 0; i < MAX_YEAR; i++)
+  {
+    double w = outcome.weight * getEndProb(outcome.hr, i);
+    if (w == 0)
+      continue;
+    for (int t = 0; t < ERRORENUM; t++)
+      trialTypeWgt[k][i][t] += w * shares[t];
+  }
+}
+
+//------------------------------------------------------------------------------
+void TesterSystem::logEvent(int kind, const TrialOutcome &outcome)
+{
+  EventRecord record;
+  if (eventLogWriter->wants())
+  {
+    FaultDomain *fd = outcome.fd;
+    memset(&record, 0, sizeof(record));
+    record.trial = trialIdx;
+    record.hr = outcome.hr;
+    record.weight = outcome.weight;
+    record.domain = fd->groupIdx;
+    record.outcome = kind;
+    record.faultCount = std::min<size_t>(fd->operationalFaultList.size(), 255);
+    int f = 0;
+    for (auto it = fd->operationalFaultList.begin();
+         (it != fd->operationalFaultList.end()) && (f < EVENT_LOG_FAULTS);
+         ++it, f++)
+    {
+      Fault *fault = *it;
+      EventFault &entry = record.faults[f];
+      entry.type = eventLogWriter->getTypeID(fault->getName());
+      entry.chipID = fault->getChipID();
+      entry.pinID = fault->getIsSingleDQ() ? fault->getPinID() : -1;
+      entry.numDQ = fault->getNumDQ();
+      entry.transient = fault->getIsTransient();
+    }
+  }
+  eventLogWriter->append(record);
+}
 
-  // for runCnt times
-  for (long runNum = 0; runNum < runCnt; runNum++)
+//------------------------------------------------------------------------------
+void TesterSystem::recordTrial(ECC *ecc, const TrialOutcome &outcome)
+{
+  double hr = outcome.hr;
+  FaultDomain *fd = outcome.fd;
+  if (outcome.retired)
+  {
+    if (eventLogWriter != NULL)
+      logEvent(0, outcome);
+    else
+      printf("-------------RETIRE: hours %lf (%lfyrs),i retiredBlkCount: \
+        %lld maxRetiredBlkCount: %lld\n",
+             hr, hr / (24 * 365),
+             fd->getRetiredBlkCount(), ecc->getMaxRetiredBlkCount());
+    recordFailure(0, hr, outcome.weight);
+    for (int i = 0; i < MAX_YEAR; i++)
+    {
+      trialRetireWgt[i] += outcome.weight * getEndProb(hr, i);
+      if (hr < i * 24 * 365)
+      {
+        RetireCntYear[i]++;
+      }
+    }
+  }
+  else if (outcome.result == DUE)
   {
-    if ((runNum == 100) || ((runNum != 0) && (runNum % 10000000 == 0)))
+    // printf("===DUE: hours %lf (%lfyrs), isPFmode() %d  ", hr,
+    // hr/(24*365), fd->faultRateInfo->iRate->IsPFmode());
+    // printf("tick %d \n",runNum);
+    if (eventLogWriter != NULL)
     {
-      printSummary(fd, runNum);
+      logEvent(1, outcome);
     }
-    if (runNum % 1000000 == 0)
+    else
+    {
+      printf("%lf DUE-", hr);
+      fd->printOperationalFaults();
+    }
+    // fd->printVisualFaults();
+    // printf("\n");
+    recordFailure(1, hr, outcome.weight);
+    if (weighted)
+      addTypeWeights(0, outcome);
+    for (int i = 0; i < MAX_YEAR; i++)
+    {
+      trialDUEWgt[i] += outcome.weight * getEndProb(hr, i);
+      if (hr < i * 24 * 365)
+      {
+        DUECntYear[i]++;
+        fd->setFaultStats(DUE, i);
+      }
+    }
+  }
+  else if (outcome.result == SDC)
+  {
+    // printf("***SDC: hours %lf (%lfyrs), isPFmode() %d  ", hr,
+    // hr/(24*365), fd->faultRateInfo->iRate->IsPFmode());
+    // printf("tick %d \n",runNum);
+    if (eventLogWriter != NULL)
+    {
+      logEvent(2, outcome);
+    }
+    else
+    {
+      printf("%lf SDC-", hr);
+      fd->printOperationalFaults();
+    }
+    // fd->printVisualFaults();
+    recordFailure(2, hr, outcome.weight);
+    if (weighted)
+      addTypeWeights(1, outcome);
+    for (int i = 0; i < MAX_YEAR; i++)
+    {
+      trialSDCWgt[i] += outcome.weight * getEndProb(hr, i);
+      if (hr < i * 24 * 365)
+      {
+        SDCCntYear[i]++;
+        fd->setFaultStats(SDC, i);
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+TesterPaired::~TesterPaired()
+{
+  for (auto it = systems.begin(); it != systems.end(); ++it)
+  {
+    delete it->tester;
+    delete it->scrubber;
+    delete it->ecc;
+    delete it->dg;
+  }
+}
+
+//------------------------------------------------------------------------------
+void TesterPaired::addSystem(TesterSystem *tester, DomainGroup *dg, ECC *ecc,
+                             Scrubber *scrubber, const char *filePrefix)
+{
+  PairedSystem system = {tester, dg, ecc, scrubber, filePrefix};
+  for (int kind = 0; kind < 3; kind++)
+  {
+    system.sum[kind] = system.sqSum[kind] = 0.;
+    system.diffSum[kind] = system.diffSqSum[kind] = 0.;
+  }
+  system.quietRuns = system.divergedRuns = 0;
+  systems.push_back(system);
+}
+
+//------------------------------------------------------------------------------
+void TesterPaired::reseed(long runNum)
+{
+  seedRandom(splitmix64(seed ^ splitmix64(runNum)));
+}
+
+//------------------------------------------------------------------------------
+void TesterPaired::printSummary(FILE *fd, long runNum)
+{
+  static const char *kindName[3] = {"Retire", "DUE", "SDC"};
+  fprintf(fd, "Paired comparison after %ld runs (common random numbers, 95%% "
+              "intervals by the end of year %d)\n",
+          runNum, MAX_YEAR - 1);
+  for (auto it = systems.begin(); it != systems.end(); ++it)
+  {
+    fprintf(fd, "%s", it->filePrefix.c_str());
+    for (int kind = 0; kind < 3; kind++)
+    {
+      Interval ci = weightedInterval(it->sum[kind], it->sqSum[kind], runNum);
+      fprintf(fd, "\t%s %.6e [%.6e, %.6e]", kindName[kind],
+              it->sum[kind] / runNum, ci.lo, ci.hi);
+    }
+    fprintf(fd, "\n");
+  }
+  const PairedSystem &base = systems[0];
+  for (size_t i = 1; i < systems.size(); i++)
+  {
+    const PairedSystem &other = systems[i];
+    fprintf(fd, "%s - %s", other.filePrefix.c_str(), base.filePrefix.c_str());
+    for (int kind = 0; kind < 3; kind++)
+    {
+      Interval ci =
+          weightedInterval(other.diffSum[kind], other.diffSqSum[kind], runNum);
+      // half width the difference would have from independent simulations
+      double baseHalf =
+          weightedInterval(base.sum[kind], base.sqSum[kind], runNum)
+              .halfWidth();
+      double otherHalf =
+          weightedInterval(other.sum[kind], other.sqSum[kind], runNum)
+              .halfWidth();
+      double independent = sqrt(baseHalf * baseHalf + otherHalf * otherHalf);
+      fprintf(fd, "\t%s %.6e [%.6e, %.6e] (independent +-%.3e)",
+              kindName[kind], other.diffSum[kind] / runNum, ci.lo, ci.hi,
+              independent);
+    }
+    fprintf(fd, "\n");
+    fprintf(fd, "arrivals of %s differ from %s in %ld of %ld runs without "
+                "an outcome\n",
+            other.filePrefix.c_str(), base.filePrefix.c_str(),
+            other.divergedRuns, other.quietRuns);
+  }
+  fflush(fd);
+}
+
+//------------------------------------------------------------------------------
+void TesterPaired::test(long runCnt, int faultCount, std::string *faults)
+{
+  assert(!systems.empty());
+  for (auto it = systems.begin(); it != systems.end(); ++it)
+  {
+    std::vector<char> prefix(it->filePrefix.begin(), it->filePrefix.end());
+    prefix.push_back('\0');
+    it->tester->begin(it->dg, it->ecc, it->scrubber, &prefix[0], faultCount,
+                      faults);
+    if (it->dg->getFaultRate() != systems[0].dg->getFaultRate())
+    {
+      printf("Warning: %s has a different fault rate than %s; their fault "
+             "timelines are not shared\n",
+             it->filePrefix.c_str(), systems[0].filePrefix.c_str());
+    }
+  }
+  signal(SIGTERM, sigterm_handler);
+
+  long runNum = 0;
+  for (runNum = 0; runNum < runCnt; runNum++)
+  {
+    if (runNum % 10000000 == 0)
     {
       printf("Processing %ldth iteration\n", runNum);
     }
+    double base[3] = {0., 0., 0.};
+    bool baseQuiet = false;
+    int baseCounted = 0;
+    uint64_t baseHash = 0;
+    for (size_t i = 0; i < systems.size(); i++)
+    {
+      PairedSystem &system = systems[i];
+      reseed(runNum);
+      system.tester->step(runNum);
+      bool quiet = true;
+      for (int kind = 0; kind < 3; kind++)
+      {
+        double x = system.tester->getLastTrialWeight(kind);
+        quiet = quiet && (x == 0);
+        system.sum[kind] += x;
+        system.sqSum[kind] += x * x;
+        if (i == 0)
+        {
+          base[kind] = x;
+          continue;
+        }
+        system.diffSum[kind] += x - base[kind];
+        system.diffSqSum[kind] += (x - base[kind]) * (x - base[kind]);
+      }
+      // runs that end at the horizon in both systems must have drawn the
+      // same arrivals from their fault count; the second one is drawn after
+      // the first fault was generated and decoded
+      int counted = system.tester->getLastCountedArrivals();
+      uint64_t hash = system.tester->getLastArrivalHash();
+      if (i == 0)
+      {
+        baseQuiet = quiet;
+        baseCounted = counted;
+        baseHash = hash;
+      }
+      else if (quiet && baseQuiet && (counted >= 2) && (counted == baseCounted))
+      {
+        system.quietRuns++;
+        if (hash != baseHash)
+          system.divergedRuns++;
+      }
+    }
+    if (killflag)
+    {
+      runNum++;
+      break;
+    }
+  }
+
+  for (auto it = systems.begin(); it != systems.end(); ++it)
+    it->tester->finish(runNum);
+  printSummary(stdout, runNum);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// write or read all of "size" bytes
+static bool writeAll(int fd, const void *buf, size_t size)
+{
+  const char *p = (const char *)buf;
+  while (size > 0)
+  {
+    ssize_t n = write(fd, p, size);
+    if (n <= 0) return false;
+    p += n;
+    size -= n;
+  }
+  return true;
+}
+
+static bool readAll(int fd, void *buf, size_t size)
+{
+  char *p = (char *)buf;
+  while (size > 0)
+  {
+    ssize_t n = read(fd, p, size);
+    if (n <= 0) return false;
+    p += n;
+    size -= n;
+  }
+  return true;
+}
 
-    // ErrorType result = dg->getFD()->genScenarioRandomFaultAndTest(ecc,
-    // faultCount, faults);
-    ErrorType result = dg->getFD()->genScenarioRandomFaultAndTest(
-        ecc, faultCount - 2, faults, false);
-    if (result == SDC)
+//------------------------------------------------------------------------------
+// run child(w, pipe) on "workers" forked processes, each writing its results
+// to its pipe, then parent(w, pipe) on the read end of each in worker order
+static void runWorkers(int workers,
+                       const std::function<void(int, int)> &child,
+                       const std::function<void(int, int)> &parent)
+{
+  std::vector<pid_t> pids;
+  std::vector<int> pipes;
+  fflush(stdout);
+  for (int w = 0; w < workers; w++)
+  {
+    int fds[2];
+    if (pipe(fds) != 0)
+    {
+      printf("Cannot create a pipe for a worker\n");
+      exit(1);
+    }
+    pid_t pid = fork();
+    if (pid < 0)
     {
-      dg->getFD()->setFaultStats(SDC, 0);
+      printf("fork failed for a worker\n");
+      exit(1);
     }
-    else if (result == DUE)
+    if (pid == 0)
     {
-      dg->getFD()->setFaultStats(DUE, 0);
+      close(fds[0]);
+      child(w, fds[1]);
+      fflush(stdout);
+      _exit(0);
+    }
+    close(fds[1]);
+    pids.push_back(pid);
+    pipes.push_back(fds[0]);
+  }
+  for (int w = 0; w < workers; w++)
+  {
+    parent(w, pipes[w]);
+    close(pipes[w]);
+  }
+  for (pid_t pid : pids)
+  {
+    int status;
+    waitpid(pid, &status, 0);
+  }
+}
+
+//------------------------------------------------------------------------------
+void TesterScenario::reset()
+{
+  for (int i = 0; i <= SDC; i++)
+  {
+    errorCnt[i] = 0l;
+  }
+}
+
+//------------------------------------------------------------------------------
+uint64_t TesterScenario::getCounterChecksum()
+{
+  return hashBytes(FNV_OFFSET_BASIS, errorCnt, sizeof(errorCnt));
+}
+//------------------------------------------------------------------------------
+void TesterScenario::printSummary(FILE *fd, long runNum)
+{
+  fprintf(fd, "After %ld runs\n", runNum);
+  for (int i = 0; i <= SDC; i++)
+  {
+    // estimate, then its 95% Wilson interval
+    Interval ci = wilsonInterval(errorCnt[i], runNum);
+    fprintf(fd, "%s\t%.10f\t[%.10f, %.10f]\n", errorName[i],
+            (double)errorCnt[i] / runNum, ci.lo, ci.hi);
+  }
+  fflush(fd);
+}
+
+//------------------------------------------------------------------------------
+bool TesterScenario::isPrecise(DomainGroup *dg, long runNum)
+{
+  if (!countsPrecise(errorCnt, runNum))
+    return false;
+  // attribution of DUE/SDC to fault types
+  double stats[ERRORENUM];
+  for (int type = DUE; type <= SDC; type++)
+  {
+    if (errorCnt[type] == 0)
+      continue;
+    // setFaultStats(type, 0) adds up with errorCnt, read back as year 1
+    dg->sumFaultStats((ErrorType)type, 1, stats);
+    for (int i = 0; i < ERRORENUM; i++)
+    {
+      if (!wilsonInterval(stats[i], errorCnt[type])
+               .precise(stats[i] / errorCnt[type], targetRelError))
+        return false;
+    }
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+ErrorType TesterScenario::runTrial(DomainGroup *dg, ECC *ecc, int faultCount,
+                                   std::string *faults)
+{
+  ErrorType result = dg->getFD()->genScenarioRandomFaultAndTest(
+      ecc, faultCount, faults, distinctChips);
+  if (result == SDC)
+  {
+    dg->getFD()->setFaultStats(SDC, 0);
+  }
+  else if (result == DUE)
+  {
+    dg->getFD()->setFaultStats(DUE, 0);
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+void TesterScenario::runChunk(DomainGroup *dg, ECC *ecc, long trialCap,
+                              int faultCount, std::string *faults,
+                              ChunkResult *result, std::vector<int> *histogram)
+{
+  // the domain stats and the histogram count this chunk only
+  float *dueStats = dg->getFD()->getFaultStats(DUE, 1);
+  float *sdcStats = dg->getFD()->getFaultStats(SDC, 1);
+  memset(dueStats, 0, sizeof(float) * ERRORENUM);
+  memset(sdcStats, 0, sizeof(float) * ERRORENUM);
+  memset(ecc->getHistogram(), 0, sizeof(int) * ecc->getHistogramSize());
+
+  seedRandom(splitmix64(seed ^ splitmix64(result->chunk)));
+  result->trials =
+      std::min(CHUNK_TRIALS, trialCap - result->chunk * CHUNK_TRIALS);
+  for (int i = 0; i <= SDC; i++)
+    result->errorCnt[i] = 0;
+  for (long trial = 0; trial < result->trials; trial++)
+    result->errorCnt[runTrial(dg, ecc, faultCount, faults)]++;
+
+  memcpy(result->stats[0], dueStats, sizeof(float) * ERRORENUM);
+  memcpy(result->stats[1], sdcStats, sizeof(float) * ERRORENUM);
+  histogram->assign(ecc->getHistogram(),
+                    ecc->getHistogram() + ecc->getHistogramSize());
+}
+
+//------------------------------------------------------------------------------
+long TesterScenario::testParallel(DomainGroup *dg, ECC *ecc, long trialCap,
+                                  FILE *fd, int faultCount,
+                                  std::string *faults)
+{
+  long chunkCnt = (trialCap + CHUNK_TRIALS - 1) / CHUNK_TRIALS;
+  // with adaptive stopping, each round gives every worker one chunk and the
+  // estimates are checked after each merged chunk
+  long roundChunks = (targetRelError > 0) ? jobs : chunkCnt;
+  int histSize = ecc->getHistogramSize();
+  float *dueStats = dg->getFD()->getFaultStats(DUE, 1);
+  float *sdcStats = dg->getFD()->getFaultStats(SDC, 1);
+  long runNum = 0;
+
+  for (long first = 0; first < chunkCnt; first += roundChunks)
+  {
+    long last = std::min(first + roundChunks, chunkCnt);
+    int workers = (int)std::min((long)jobs, last - first);
+    std::vector<ChunkResult> results(last - first);
+    std::vector<std::vector<int>> histograms(last - first);
+
+    // worker w simulates chunks first + w, first + w + workers, ...
+    auto child = [&](int w, int pipe) {
+      ChunkResult result;
+      std::vector<int> histogram;
+      for (long chunk = first + w; chunk < last; chunk += workers)
+      {
+        result.chunk = chunk;
+        runChunk(dg, ecc, trialCap, faultCount, faults, &result, &histogram);
+        if (!writeAll(pipe, &result, sizeof(result)) ||
+            !writeAll(pipe, histogram.data(), sizeof(int) * histSize))
+          _exit(1);
+      }
+    };
+    auto parent = [&](int w, int pipe) {
+      for (long chunk = first + w; chunk < last; chunk += workers)
+      {
+        ChunkResult &result = results[chunk - first];
+        std::vector<int> &histogram = histograms[chunk - first];
+        histogram.resize(histSize);
+        if (!readAll(pipe, &result, sizeof(result)) ||
+            !readAll(pipe, histogram.data(), sizeof(int) * histSize) ||
+            (result.chunk != chunk))
+        {
+          printf("Scenario worker %d failed\n", w);
+          exit(1);
+        }
+      }
+    };
+    runWorkers(workers, child, parent);
+
+    // merge in chunk order
+    for (long chunk = first; chunk < last; chunk++)
+    {
+      const ChunkResult &result = results[chunk - first];
+      for (int i = 0; i <= SDC; i++)
+        errorCnt[i] += result.errorCnt[i];
+      for (int i = 0; i < ERRORENUM; i++)
+      {
+        dueStats[i] += result.stats[0][i];
+        sdcStats[i] += result.stats[1][i];
+      }
+      for (int i = 0; i < histSize; i++)
+        ecc->getHistogram()[i] += histograms[chunk - first][i];
+      if ((runNum / 10000000) != ((runNum + result.trials) / 10000000))
+      {
+        printSummary(fd, runNum + result.trials);
+      }
+      if ((runNum / 1000000) != ((runNum + result.trials) / 1000000))
+      {
+        printf("Processing %ldth iteration\n", runNum + result.trials);
+      }
+      runNum += result.trials;
+      if (stopCheckDue(runNum) && isPrecise(dg, runNum))
+      {
+        printf("Target precision reached after %ld runs\n", runNum);
+        return runNum;
+      }
+    }
+  }
+  return runNum;
+}
+
+//------------------------------------------------------------------------------
+void TesterScenario::test(DomainGroup *dg, ECC *ecc, Scrubber *scrubber,
+                          long runCnt, char *filePrefix, int faultCount,
+                          std::string *faults)
+{
+  assert(faultCount != 0);
+  // create log file
+  std::string nameBuffer = std::string(filePrefix) + "." + faults[0];
+  for (int i = 1; i < faultCount; i++)
+  {
+    nameBuffer = nameBuffer + "." + faults[i];
+  }
+  FILE *fd = fopen(nameBuffer.c_str(), "w");
+  assert(fd != NULL);
+
+  // reset statistics
+  reset();
+
+  // the last two arguments are the module and the DRAM type
+  faultCount -= 2;
+
+  // for runCnt times (or until the estimates are precise enough)
+  long runNum;
+  long trialCap = getTrialCap(runCnt);
+  if (jobs > 0)
+  {
+    runNum = testParallel(dg, ecc, trialCap, fd, faultCount, faults);
+  }
+  else
+  {
+    for (runNum = 0; runNum < trialCap; runNum++)
+    {
+      if ((runNum == 100) || ((runNum != 0) && (runNum % 10000000 == 0)))
+      {
+        printSummary(fd, runNum);
+      }
+      if (runNum % 1000000 == 0)
+      {
+        printf("Processing %ldth iteration\n", runNum);
+      }
+      if (stopCheckDue(runNum) && isPrecise(dg, runNum))
+      {
+        printf("Target precision reached after %ld runs\n", runNum);
+        break;
+      }
+      errorCnt[runTrial(dg, ecc, faultCount, faults)]++;
     }
-    // dg->getFD()->printVisualFaults();
-    errorCnt[result]++;
   }
 
   dg->printFaultStats(stdout, errorCnt[DUE], errorCnt[SDC], 1);
 
-  printSummary(fd, runCnt);
+  printSummary(fd, runNum);
   ecc->printHistogram();
   fclose(fd);
 }
 
 //------------------------------------------------------------------------------
+// outcome names for the matrix output (errorName pads them for the summary)
+static const char *outcomeName[] = {"NE", "CE", "DUE", "SDC"};
+
+//------------------------------------------------------------------------------
+void TesterMatrix::getCellFaults(long cell, std::string *cellFaults)
+{
+  for (int i = order - 1; i >= 0; i--)
+  {
+    cellFaults[i] = types[cell % types.size()];
+    cell /= types.size();
+  }
+}
+
+//------------------------------------------------------------------------------
+void TesterMatrix::runCell(DomainGroup *dg, ECC *ecc, long trialCap,
+                           CellResult *result)
+{
+  std::string cellFaults[3];
+  getCellFaults(result->cell, cellFaults);
+  seedRandom(splitmix64(seed ^ splitmix64(result->cell)));
+  for (int i = 0; i <= SDC; i++)
+    result->errorCnt[i] = 0;
+  long runNum;
+  for (runNum = 0; runNum < trialCap; runNum++)
+  {
+    if (stopCheckDue(runNum) && countsPrecise(result->errorCnt, runNum))
+      break;
+    result->errorCnt[dg->getFD()->genScenarioRandomFaultAndTest(
+        ecc, order, cellFaults, distinctChips)]++;
+  }
+  result->trials = runNum;
+}
+
+//------------------------------------------------------------------------------
+void TesterMatrix::test(DomainGroup *dg, ECC *ecc, Scrubber *scrubber,
+                        long runCnt, char *filePrefix, int faultCount,
+                        std::string *faults)
+{
+  assert((order == 2) || (order == 3));
+  // the last two arguments are the module and the DRAM type
+  assert(faultCount > 2);
+  types.assign(faults, faults + faultCount - 2);
+  long cellCnt = 1;
+  for (int i = 0; i < order; i++)
+    cellCnt *= types.size();
+  cells.assign(cellCnt, CellResult());
+
+  std::string nameBuffer =
+      std::string(filePrefix) + ((order == 2) ? ".pairs" : ".triples");
+  FILE *fd = fopen(nameBuffer.c_str(), "w");
+  assert(fd != NULL);
+
+  long trialCap = getTrialCap(runCnt);
+  printf("Outcome matrix: %ld cells of up to %ld runs\n", cellCnt, trialCap);
+  if (jobs > 0)
+  {
+    // worker w simulates cells w, w + workers, ...
+    int workers = (int)std::min((long)jobs, cellCnt);
+    auto child = [&](int w, int pipe) {
+      for (long cell = w; cell < cellCnt; cell += workers)
+      {
+        cells[cell].cell = cell;
+        runCell(dg, ecc, trialCap, &cells[cell]);
+        if (!writeAll(pipe, &cells[cell], sizeof(CellResult)))
+          _exit(1);
+      }
+    };
+    auto parent = [&](int w, int pipe) {
+      for (long cell = w; cell < cellCnt; cell += workers)
+      {
+        if (!readAll(pipe, &cells[cell], sizeof(CellResult)) ||
+            (cells[cell].cell != cell))
+        {
+          printf("Matrix worker %d failed\n", w);
+          exit(1);
+        }
+      }
+    };
+    runWorkers(workers, child, parent);
+  }
+  else
+  {
+    for (long cell = 0; cell < cellCnt; cell++)
+    {
+      cells[cell].cell = cell;
+      runCell(dg, ecc, trialCap, &cells[cell]);
+    }
+  }
+
+  printCells(fd);
+  for (int type = CE; type <= SDC; type++)
+  {
+    printMatrix(stdout, (ErrorType)type);
+    printMatrix(fd, (ErrorType)type);
+  }
+  fclose(fd);
+}
+
+//------------------------------------------------------------------------------
+uint64_t TesterMatrix::getCounterChecksum()
+{
+  uint64_t hash = FNV_OFFSET_BASIS;
+  for (const CellResult &cell : cells)
+    hash = hashBytes(hash, cell.errorCnt, sizeof(cell.errorCnt));
+  return hash;
+}
+
+//------------------------------------------------------------------------------
+void TesterMatrix::printMatrix(FILE *fd, ErrorType type)
+{
+  long rowCnt = cells.size() / types.size();
+  std::string cellFaults[3];
+  std::vector<std::string> rowNames;
+  int rowWidth = 12;
+  for (long row = 0; row < rowCnt; row++)
+  {
+    getCellFaults(row * types.size(), cellFaults);
+    std::string rowName = cellFaults[0];
+    for (int i = 1; i < order - 1; i++)
+      rowName = rowName + "." + cellFaults[i];
+    rowNames.push_back(rowName);
+    rowWidth = std::max(rowWidth, (int)rowName.size());
+  }
+
+  fprintf(fd, "\n%s probability (rows: %s, columns: fault %d)\n",
+          outcomeName[type], (order == 2) ? "fault 1" : "faults 1.2", order);
+  fprintf(fd, "%-*s", rowWidth, "");
+  for (const std::string &name : types)
+    fprintf(fd, " %12s", name.c_str());
+  fprintf(fd, "\n");
+  for (long row = 0; row < rowCnt; row++)
+  {
+    fprintf(fd, "%-*s", rowWidth, rowNames[row].c_str());
+    for (size_t col = 0; col < types.size(); col++)
+    {
+      const CellResult &cell = cells[row * types.size() + col];
+      fprintf(fd, " %12.10f",
+              (cell.trials > 0) ? (double)cell.errorCnt[type] / cell.trials
+                                : 0.);
+    }
+    fprintf(fd, "\n");
+  }
+  fflush(fd);
+}
+
+//------------------------------------------------------------------------------
+void TesterMatrix::printCells(FILE *fd)
+{
+  std::string cellFaults[3];
+  fprintf(fd, "faults,runs");
+  for (int i = CE; i <= SDC; i++)
+    fprintf(fd, ",%s,%s_lo,%s_hi", outcomeName[i], outcomeName[i],
+            outcomeName[i]);
+  fprintf(fd, "\n");
+  for (const CellResult &cell : cells)
+  {
+    getCellFaults(cell.cell, cellFaults);
+    std::string name = cellFaults[0];
+    for (int i = 1; i < order; i++)
+      name = name + "." + cellFaults[i];
+    fprintf(fd, "%s,%ld", name.c_str(), cell.trials);
+    for (int i = CE; i <= SDC; i++)
+    {
+      Interval ci = wilsonInterval(cell.errorCnt[i], cell.trials);
+      fprintf(fd, ",%.10f,%.10f,%.10f",
+              (double)cell.errorCnt[i] / cell.trials, ci.lo, ci.hi);
+    }
+    fprintf(fd, "\n");
+  }
+  fflush(fd);
+}
+
+//------------------------------------------------------------------------------
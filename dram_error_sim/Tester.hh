@@ -47,12 +47,26 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #include <stdio.h>
 #include <list>
+#include <memory>
 
+#include <algorithm>
+#include <math.h>
+#include <set>
+
+#include "DomainGroup.hh"
 #include "ECC.hh"
+#include "EventQueue.hh"
+#include "FailureHistogram.hh"
+#include "EventLog.hh"
+#include "FaultCorpus.hh"
+#include "RunResult.hh"
+#include "Profile.hh"
 #include "Fault.hh"
+#include "Stats.hh"
 #include "VECC.hh"
 #include "codec.hh"
 #include "common.hh"
+#include "util.hh"
 
 #define MAX_YEAR 6
 
@@ -89,10 +103,81 @@ class Tester {
   */
   virtual void test(DomainGroup *dg, ECC *ecc, Scrubber *scrubber, long runCnt,
                     char *filePrefix, int faultCount, std::string *faults) = 0;
+
+  //! Adaptive stopping: stop once the 95% interval of every tracked estimate
+  //! is within "relError" of it (relative half width); "maxTrials" (if set)
+  //! replaces runCnt as the trial budget.
+  void setStopping(double relError, long _maxTrials) {
+    targetRelError = relError;
+    maxTrials = _maxTrials;
+  }
+  //! Hash of the outcome counters after test(): equal checksums mean
+  //! bit-identical results (see sim_bench.cc)
+  virtual uint64_t getCounterChecksum() = 0;
+
+ protected:
+  //! number of runs to simulate at most
+  long getTrialCap(long runCnt) { return (maxTrials > 0) ? maxTrials : runCnt; }
+  //! whether the estimates should be checked for stopping after runNum runs
+  bool stopCheckDue(long runNum) {
+    return (targetRelError > 0) && (runNum > 0) &&
+           (runNum % STOP_CHECK_INTERVAL == 0);
+  }
+
+  //! whether the "n" estimates (with their intervals) reached
+  //! targetRelError. An estimate of zero only settles once its rule-of-three
+  //! bound is within targetRelError of the smallest non-zero estimate, so a
+  //! rare outcome without hits yet does not stop the run early.
+  bool estimatesPrecise(const double *estimate, const Interval *ci, int n,
+                        long runNum) {
+    double smallest = INFINITY;
+    for (int i = 0; i < n; i++) {
+      if (estimate[i] <= 0) continue;
+      if (!ci[i].precise(estimate[i], targetRelError)) return false;
+      smallest = std::min(smallest, estimate[i]);
+    }
+    // nothing is known before the first hit
+    if (smallest == INFINITY) return false;
+    for (int i = 0; i < n; i++) {
+      if ((estimate[i] <= 0) &&
+          !zeroNegligible(runNum, smallest, targetRelError))
+        return false;
+    }
+    return true;
+  }
+  //! estimatesPrecise() of the NE/CE/DUE/SDC proportions of "cnt"
+  bool countsPrecise(const long *cnt, long runNum) {
+    double estimate[SDC + 1];
+    Interval ci[SDC + 1];
+    for (int i = 0; i <= SDC; i++) {
+      estimate[i] = (double)cnt[i] / runNum;
+      ci[i] = wilsonInterval(cnt[i], runNum);
+    }
+    return estimatesPrecise(estimate, ci, SDC + 1, runNum);
+  }
+
+  static const long STOP_CHECK_INTERVAL = 10000;
+  double targetRelError = 0.;  //!< target relative half width (0: fixed runs)
+  long maxTrials = 0;          //!< trial budget with adaptive stopping
+};
+
+/** @class TrialOutcome
+ * \brief Result of one system-level run (trial)
+ */
+struct TrialOutcome {
+  ErrorType result;  //!< DUE/SDC that ended the run, NE otherwise
+  bool retired;      //!< run ended by exhausting the retirement budget
+  double hr;         //!< time the run ended
+  FaultDomain *fd;   //!< domain that failed (or retired)
+  double weight;     //!< likelihood ratio of the run (1 without biasing)
 };
 
 /** @class TesterSystem
  * \brief Tester class for system level reliability
+ * @details Each run is a discrete-event simulation over a min-heap of typed
+ * future events (see EventQueue.hh). Fault arrivals of the whole group are
+ * drawn from the current group rate and re-drawn whenever the rate changes;
+ * domains schedule their own scrub and retirement events.
  */
 class TesterSystem : public Tester {
  public:
@@ -102,6 +187,23 @@ class TesterSystem : public Tester {
             char *filePrefix, int faultCount,
             std::string *faults);  //!< test run
 
+  //! Parts of test(), for drivers that interleave the runs of several
+  //! systems (see TesterPaired): open the log file and reset the statistics,
+  //! simulate run "runNum", and print the final statistics
+  void begin(DomainGroup *dg, ECC *ecc, Scrubber *scrubber, char *filePrefix,
+             int faultCount, std::string *faults);
+  void step(long runNum);
+  void finish(long runNum);
+  uint64_t getCounterChecksum();
+  //! Retire (kind 0), DUE (1) or SDC (2) weight of the last run by the end
+  //! of the last year
+  double getLastTrialWeight(int kind) { return lastTrialWgt[kind]; }
+  //! arrivals of the last run drawn from its fault count (before any rate
+  //! change, see scheduleArrival()) and a hash of their times and domains
+  int getLastCountedArrivals() { return countedArrivals; }
+  uint64_t getLastArrivalHash() { return arrivalHash; }
+  const std::string &getLogName() { return logName; }
+
   void updateElapsedTime(double hr) { elapsedTime = hr; }
   double getElapsedTime() { return elapsedTime; }
   //! Get activation probability of weak cells; First parameter faults[0] in
@@ -123,23 +225,230 @@ class TesterSystem : public Tester {
   double getRatioFWC() { return ratioFrequentWeakCells; }
   void setRatioFWC(double _p) { ratioFrequentWeakCells = _p; }
 
+  //! schedule a future event in the current run
+  void schedule(SimEventType type, double time, FaultDomain *fd = NULL,
+                double value = 0.) {
+    SimEvent event = {time, type, fd, 0, value};
+    events.push(event);
+  }
+  //! piecewise-constant multiplier of all fault rates (e.g., bathtub or
+  //! aging curves): profile[i].second applies from profile[i].first hours on
+  void setRateProfile(const std::vector<std::pair<double, double>> &profile) {
+    rateProfile = profile;
+  }
+  //! Report the cumulative Retire/DUE/SDC probability at each of "years"
+  //! (e.g. 0.25, 1, 7) from the failure-time histogram; runs are simulated
+  //! up to the longest of them if it exceeds the default lifetime.
+  void setHorizons(const std::vector<double> &years) {
+    curveHr.clear();
+    for (double yr : years) {
+      assert(yr > 0);
+      curveHr.push_back(yr * 24 * 365);
+      horizonHr = std::max(horizonHr, yr * 24 * 365);
+    }
+  }
+  //! Record the fault arrivals of every run to the corpus "fileName"
+  //! (see FaultCorpus.hh); each run then goes on to the horizon, and the
+  //! draws of each arrival are seeded from "seed"
+  void recordCorpus(const char *fileName, uint64_t seed) {
+    corpusWriter.reset(new FaultCorpusWriter());
+    corpusName = fileName;
+    corpusSeed = seed;
+  }
+  //! Replay the fault arrivals of a recorded corpus instead of drawing them
+  bool replayCorpus(const char *fileName) {
+    corpusReader.reset(new FaultCorpusReader());
+    return corpusReader->open(fileName);
+  }
+  //! What is simulated, for the .result file written next to the .S file
+  //! (see RunResult.hh)
+  void setRunInfo(int systemID, const char *system, const char *seed,
+                  int module, const char *dram, const std::string &options) {
+    runInfo.systemID = systemID;
+    runInfo.system = system;
+    runInfo.seed = seed;
+    runInfo.module = module;
+    runInfo.dram = dram;
+    runInfo.options = options;
+  }
+  //! Write the DUE/SDC/retirement events to the binary log "fileName"
+  //! (see EventLog.hh) instead of printing them; every "sample"-th event
+  //! is kept, up to "maxRecords" of them (0: all)
+  void eventLog(const char *fileName, uint64_t sample, uint64_t maxRecords) {
+    eventLogWriter.reset(new EventLogWriter());
+    eventLogName = fileName;
+    eventLogSample = sample;
+    eventLogMax = maxRecords;
+  }
+  //! sample the number of faults of a run up front (see runTrial)
+  void setFastForward(bool _on) { fastForward = _on; }
+
+  //! Importance sampling: scale the overlap probability with weak cells by
+  //! "overlapScale" (capped at 0.5); biased fault rates are set through
+  //! FaultRateCatalog::setRateScale()/setTypeWeight(). Runs are then
+  //! reweighted by their likelihood ratio.
+  void setImportanceSampling(double overlapScale) {
+    assert(overlapScale > 0);
+    isOverlapScale = overlapScale;
+    weighted = true;
+  }
+  //! Multilevel splitting: when a run first reaches a permanent fault
+  //! (level 1) or a permanent fault overlapping another fault or weak cells
+  //! (level 2), continue "factor" copies of it, each with 1/factor weight.
+  void setSplitting(int factor, int levels) {
+    assert((factor >= 1) && (levels >= 0));
+    splitFactor = factor;
+    splitLevels = levels;
+    weighted = true;
+  }
+  //! Conditional Monte Carlo: integrate the arrival time of the first
+  //! fault of each run analytically (see runTrial)
+  void setConditional(bool _on) {
+    conditional = _on;
+    if (_on) weighted = true;
+  }
+  bool isWeighted() { return weighted; }
+  //! biased probability to sample in place of the overlap probability p
+  double biasOverlapProb(double p) {
+    if ((isOverlapScale == 1.) || (p <= 0) || (p >= .5)) return p;
+    return std::min(p * isOverlapScale, .5);
+  }
+  //! account for a biased draw of the current run (p/q)
+  void addLikelihoodRatio(double lr) { logLR += log(lr); }
+
  protected:
   void reset();
   void printSummary(FILE *fd, long runNum);
+  //! write the counters to "<log>.result"
+  void saveResult(long runNum);
   double advance(
       double faultRate);    //!< advance random time according to fault rates
+  //! Retire (kind 0), DUE (1) or SDC (2) probability by year "yr"
+  double getEstimate(int kind, int yr, long runNum);
+  //! 95% interval of getEstimate()
+  Interval getInterval(int kind, int yr, long runNum);
+  //! whether every tracked estimate reached targetRelError
+  bool isPrecise(DomainGroup *dg, long runNum);
+  void printIntervals(FILE *fd, long runNum);
+  //! shares of the fault types in the DUE (k = 0) or SDC (1) outcomes by the
+  //! end of the last year and their 95% intervals; false if there is none
+  bool getTypeShares(DomainGroup *dg, int k, long runNum, double *share,
+                     Interval *ci);
+  //! cumulative probabilities at the horizons of setHorizons()
+  void printCurves(FILE *fd);
+  //! simulate one run from time 0 until a failure or the horizon
+  void runTrial(DomainGroup *dg, ECC *ecc);
+  //! process the events of the current run (or of one of its copies)
+  void continueTrial(DomainGroup *dg, ECC *ecc, int level, double splitWeight);
+  //! splitting level reached by a domain after a fault arrival
+  int getSplitLevel(FaultDomain *fd);
+  //! continue splitFactor copies of the current run from time hr
+  void split(DomainGroup *dg, ECC *ecc, double hr, int level,
+             double splitWeight);
+  //! weight the outcome of a run (or copy) and record it
+  void finishTrial(ECC *ecc, TrialOutcome *outcome, double splitWeight);
+  //! (re)draw the next fault arrival of the group after time "now"
+  void scheduleArrival(DomainGroup *dg, double now);
+  //! accumulate the outcome of a run into the per-year counters
+  void recordTrial(ECC *ecc, const TrialOutcome &outcome);
+  //! add a run ending at "hr" to the failure-time histogram
+  void recordFailure(int kind, double hr, double weight);
+  //! split the weight of a DUE (k = 0) or SDC (1) run over its fault types
+  void addTypeWeights(int k, const TrialOutcome &outcome);
+  //! append the event of a run to the event log
+  void logEvent(int kind, const TrialOutcome &outcome);
   double elapsedTime;       //!< time elapsed so far
   double ratioWeakCells;    //!< ratio of weak cells to whole cells
   double actProbWeakCells;  //!< activation probability faulty cells
   double ratioFrequentWeakCells;  //!< ratio of weak cells to whole cells
   double actProbFWCs;             //!< activation probability faulty cells
 
+  DomainGroup *_dg = NULL;  //!< domain group under test
+  ECC *_ecc = NULL;
+  Fault *inherentFault = NULL;
+  FILE *logFd = NULL;       //!< summary (.S) file
+  std::string logName;
+  double lastTrialWgt[3] = {0};  //!< see getLastTrialWeight()
+  EventQueue events;      //!< future events of the current run
+  long arrivalSeq = 0;    //!< sequence number of the pending fault arrival
+  double rateScale = 1.;  //!< current multiplier from rateProfile
+  std::vector<std::pair<double, double>> rateProfile;
+  double horizonHr = (MAX_YEAR - 1) * 24 * 365;  //!< simulated lifetime
+  FailureHistogram histogram;   //!< first-failure times (hourly bins)
+  std::vector<double> curveHr;  //!< horizons reported by printCurves()
+  long trialIdx = 0;            //!< index of the current run
+  std::unique_ptr<FaultCorpusWriter> corpusWriter;
+  std::unique_ptr<FaultCorpusReader> corpusReader;
+  std::string corpusName;
+  uint64_t corpusSeed = 0;
+  uint64_t replayPos = 0;  //!< next record of the replayed corpus
+  RunResult runInfo;  //!< see setRunInfo()
+  std::unique_ptr<EventLogWriter> eventLogWriter;
+  std::string eventLogName;
+  uint64_t eventLogSample = 1;
+  uint64_t eventLogMax = 0;
+  ProfileCounters profile;   //!< phases of the runs of this system
+  uint64_t profileTotal = 0;  //!< ticks of the runs of this system
+  bool fastForward = true;  //!< Poisson fast-forward of fault arrivals
+  //! faults left to place when the group rate is still poissonRate, or -1
+  //! once arrivals are drawn as exponential inter-arrival times
+  long remainingArrivals = -1;
+  double poissonRate = 0.;
+
+  bool weighted = false;       //!< importance sampling enabled
+  double isOverlapScale = 1.;  //!< overlap probability multiplier
+  double logLR = 0.;           //!< log likelihood ratio of the biased draws
+  double rateBias = 0.;        //!< biased minus unbiased group rate
+  double lastRateHr = 0.;      //!< time rateBias was last accumulated
+  double biasIntegral = 0.;    //!< integral of rateBias over the run
+  int splitFactor = 1;         //!< copies per splitting level
+  int splitLevels = 2;         //!< highest splitting level
+  int errorCounter = 0;        //!< fault arrivals in the current run
+  int countedArrivals = 0;     //!< see getLastCountedArrivals()
+  uint64_t arrivalHash = 0;    //!< see getLastArrivalHash()
+  bool conditional = false;    //!< conditional Monte Carlo enabled
+  double scrubPeriod = 0.;     //!< see Scrubber::getPeriod()
+  double firstRate = 0.;       //!< group rate before the first arrival
+  double firstQ = 0.;          //!< P(no arrival within a scrub period)
+  //! probability of the current run ending before "year" given it ended at
+  //! "hr" (1 or 0 unless conditional)
+  double getEndProb(double hr, int year);
+
+  /** @class TrialState
+   * \brief Saved state of a run, restored by each copy of a split
+   */
+  struct TrialState {
+    DomainGroupState group;
+    std::set<int> correctedPosSet;
+    EventQueue events;
+    double rateScale;
+    double logLR;
+    double biasIntegral;
+    int errorCounter;
+  };
+
  protected:
   // CE + DUE + SDC can be bigger than expected error count?
   long BadCnt = 0;
   long RetireCntYear[MAX_YEAR] = {0};
   long DUECntYear[MAX_YEAR] = {0};
   long SDCCntYear[MAX_YEAR] = {0};
+  // importance sampling: sums of the weights (and squared weights)
+  double RetireWgtYear[MAX_YEAR] = {0};
+  double DUEWgtYear[MAX_YEAR] = {0};
+  double SDCWgtYear[MAX_YEAR] = {0};
+  double RetireWgtSqYear[MAX_YEAR] = {0};
+  double DUEWgtSqYear[MAX_YEAR] = {0};
+  double SDCWgtSqYear[MAX_YEAR] = {0};
+  // weights of the current run (summed over its split copies)
+  double trialRetireWgt[MAX_YEAR] = {0};
+  double trialDUEWgt[MAX_YEAR] = {0};
+  double trialSDCWgt[MAX_YEAR] = {0};
+  // weighted modes: the DUE/SDC weights split over the fault types,
+  // [DUE/SDC][year][type] (the counts are in the domain stats)
+  double typeWgtYear[2][MAX_YEAR][ERRORENUM] = {};
+  double typeWgtSqYear[2][MAX_YEAR][ERRORENUM] = {};
+  double trialTypeWgt[2][MAX_YEAR][ERRORENUM] = {};
 #ifdef DUE_BREAKDOWN
   long DUE_ParityYear[MAX_YEAR] = {0};
   long DUE_NoErasureYear[MAX_YEAR] = {0};
@@ -147,8 +456,61 @@ class TesterSystem : public Tester {
 #endif
 };
 
+/** @class TesterPaired
+ * \brief Common-random-numbers comparison of several systems
+ * @details Run i of every system starts from the same per-run seed. The
+ * decoders draw from their own stream, so systems with the same DomainGroup
+ * geometry draw the same fault timeline and error patterns whatever their
+ * ECCs consume, and only diverge where the outcomes (e.g. retirement) differ.
+ * Each system keeps its own domain state, statistics and log file; the
+ * differences to the first system are reported with paired intervals, which
+ * are much tighter than those of independent simulations.
+ */
+class TesterPaired {
+ public:
+  TesterPaired(uint64_t _seed) : seed(_seed) {}
+  ~TesterPaired();
+
+  //! add a system (deleted with the TesterPaired)
+  void addSystem(TesterSystem *tester, DomainGroup *dg, ECC *ecc,
+                 Scrubber *scrubber, const char *filePrefix);
+  void test(long runCnt, int faultCount, std::string *faults);
+
+ protected:
+  //! seed the fault timeline and the decoders for run "runNum"
+  void reseed(long runNum);
+  void printSummary(FILE *fd, long runNum);
+
+  struct PairedSystem {
+    TesterSystem *tester;
+    DomainGroup *dg;
+    ECC *ecc;
+    Scrubber *scrubber;
+    std::string filePrefix;
+    // per kind (Retire, DUE, SDC) sums of the run weights, and of the
+    // differences to the first system
+    double sum[3];
+    double sqSum[3];
+    double diffSum[3];
+    double diffSqSum[3];
+    // runs without an outcome in both this and the first system that drew
+    // the same number (at least two) of counted arrivals, and those of them
+    // whose arrivals differ
+    long quietRuns;
+    long divergedRuns;
+  };
+  std::vector<PairedSystem> systems;
+  uint64_t seed;
+};
+
 /** @class TesterScenario
  * \brief Tester class for error pattern scenarios
+ * @details By default the trials run one after another in this process. With
+ * setWorkers(), they run in chunks of CHUNK_TRIALS on forked worker
+ * processes (the random engines and the codecs are not thread-safe). Each chunk is seeded
+ * from the seed and its index, and the results are merged in chunk order. So
+ * the counts, and where adaptive stopping ends, depend only on the seed and
+ * not on the number of workers.
  */
 class TesterScenario : public Tester {
  public:
@@ -156,13 +518,95 @@ class TesterScenario : public Tester {
 
   void test(DomainGroup *dg, ECC *ecc, Scrubber *scrubber, long runCnt,
             char *filePrefix, int faultCount, std::string *faults);
+  uint64_t getCounterChecksum();
+  //! run the trials on "_jobs" worker processes (0: serially in this one)
+  void setWorkers(int _jobs, uint64_t _seed) {
+    jobs = _jobs;
+    seed = _seed;
+  }
+  //! place the faults of a trial on distinct chips
+  void setDistinctChips(bool _distinctChips) { distinctChips = _distinctChips; }
 
  protected:
   void reset();
   void printSummary(FILE *fd, long runNum);
+  //! whether every tracked estimate reached targetRelError
+  bool isPrecise(DomainGroup *dg, long runNum);
+  //! one trial; DUE/SDC are attributed to the fault types in the domain stats
+  ErrorType runTrial(DomainGroup *dg, ECC *ecc, int faultCount,
+                     std::string *faults);
+  //! run up to trialCap trials on the worker processes; returns the number
+  //! of trials merged into the statistics
+  long testParallel(DomainGroup *dg, ECC *ecc, long trialCap, FILE *fd,
+                    int faultCount, std::string *faults);
+
+  //! outcome of one chunk, sent from a worker to the parent
+  struct ChunkResult {
+    long chunk;
+    long trials;
+    long errorCnt[SDC + 1];
+    float stats[2][ERRORENUM];  //!< DUE and SDC attribution
+  };
+  //! simulate chunk "result->chunk" in a worker process
+  void runChunk(DomainGroup *dg, ECC *ecc, long trialCap, int faultCount,
+                std::string *faults, ChunkResult *result,
+                std::vector<int> *histogram);
+
+  static const long CHUNK_TRIALS = STOP_CHECK_INTERVAL;
 
  protected:
   long errorCnt[SDC + 1];
+  int jobs = 0;
+  uint64_t seed = 0;
+  bool distinctChips = false;
+};
+
+/** @class TesterMatrix
+ * \brief Outcome matrix of fault type combinations
+ * @details Evaluates every ordered pair (or triple) of the given fault types
+ * against one DomainGroup and ECC, as a TesterScenario run per combination
+ * would. Each cell is seeded from the seed and its index and stops on its
+ * own (adaptive stopping applies per cell), so with setWorkers() the cells
+ * are spread over forked worker processes without changing the results.
+ */
+class TesterMatrix : public Tester {
+ public:
+  //! "_order" faults per cell (2: pairs, 3: triples)
+  TesterMatrix(int _order) : order(_order) {}
+
+  //! faults: the fault types, then the module and the DRAM type
+  void test(DomainGroup *dg, ECC *ecc, Scrubber *scrubber, long runCnt,
+            char *filePrefix, int faultCount, std::string *faults);
+  uint64_t getCounterChecksum();
+  //! spread the cells over "_jobs" worker processes (0: this one)
+  void setWorkers(int _jobs, uint64_t _seed) {
+    jobs = _jobs;
+    seed = _seed;
+  }
+  //! place the faults of a trial on distinct chips
+  void setDistinctChips(bool _distinctChips) { distinctChips = _distinctChips; }
+
+ protected:
+  struct CellResult {
+    long cell;
+    long trials;
+    long errorCnt[SDC + 1];
+  };
+  //! fault types of cell "cell" (the first one varies slowest)
+  void getCellFaults(long cell, std::string *cellFaults);
+  void runCell(DomainGroup *dg, ECC *ecc, long trialCap, CellResult *result);
+  //! rows: all but the last fault of a cell, columns: the last fault
+  void printMatrix(FILE *fd, ErrorType type);
+  //! one line per cell with the estimates and their 95% intervals
+  void printCells(FILE *fd);
+
+ protected:
+  int order;
+  std::vector<std::string> types;
+  std::vector<CellResult> cells;
+  int jobs = 0;
+  uint64_t seed = 0;
+  bool distinctChips = false;
 };
 
 #endif /* __TESTER_HH__ */
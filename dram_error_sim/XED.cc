@@ -208,7 +208,7 @@ ErrorType XED::diagnoseFault(FaultDomain *fd, CacheLine &errorBlk,
     }
   }
   if (overlapFaults.size() != 0) {
-    int faultPos = rand() % overlapFaults.size();
+    int faultPos = decoderRand() % overlapFaults.size();
     int pos = 0;
     int correctCount = 0;
     for (auto it = overlapFaults.cbegin(); it != overlapFaults.cend();) {
@@ -254,8 +254,8 @@ void XED_SDDC::detectInDRAM(CacheLine &errorBlk,
       if ((result == CE) || (result == DUE)) {
         // catch-word collision
         unsigned long long draw =
-            ((unsigned long long)rand() * ((unsigned long long)RAND_MAX + 1)) |
-            rand();
+            ((unsigned long long)decoderRand() * ((unsigned long long)RAND_MAX + 1)) |
+            decoderRand();
         if (draw % 0x100000000ull != 0) {  // 2^-32
           // no collision
           chipLocations.push_back(i);
@@ -383,9 +383,9 @@ unsigned long long XED_SDDC::getInitialRetiredBlkCount(FaultDomain *fd,
     double goodBlkProb =
         pow(goodECCBlkProb, fd->getChannelWidth() / fd->getChipWidth());
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 128;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 128;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -422,8 +422,8 @@ void XED_DDDC::detectInDRAM(CacheLine &errorBlk,
       if ((result == CE) || (result == DUE)) {
         // catch-word collision
         unsigned long long draw =
-            ((unsigned long long)rand() * ((unsigned long long)RAND_MAX + 1)) |
-            rand();
+            ((unsigned long long)decoderRand() * ((unsigned long long)RAND_MAX + 1)) |
+            decoderRand();
         if (draw % 0x100000000ull != 0) {  // 2^-32
           // no collision
           chipLocations.push_back(i);
@@ -590,9 +590,9 @@ unsigned long long XED_DDDC::getInitialRetiredBlkCount(FaultDomain *fd,
                              pow(goodECCBlkProb, fd->getChipCount() - 1) *
                              (1 - goodECCBlkProb);
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 128;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 128;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -635,8 +635,8 @@ void XED_SDDC_NC::detectInDRAM(CacheLine &errorBlk,
       if ((result == CE) || (result == DUE)) {
         // catch-word collision
         unsigned long long draw =
-            ((unsigned long long)rand() * ((unsigned long long)RAND_MAX + 1)) |
-            rand();
+            ((unsigned long long)decoderRand() * ((unsigned long long)RAND_MAX + 1)) |
+            decoderRand();
         if (draw % 0x100000000ull != 0) {  // 2^-32
           // no collision
           chipLocations.push_back(i);
@@ -767,9 +767,9 @@ unsigned long long XED_SDDC_NC::getInitialRetiredBlkCount(FaultDomain *fd,
     double goodBlkProb =
         pow(goodECCBlkProb, fd->getChannelWidth() / fd->getChipWidth());
     unsigned long long totalBlkCount =
-        ((MRANK_MASK ^ DEFAULT_MASK) + 1) * fd->getChipWidth() / 128;
+        (fd->getGeometry()->rankAddrMask() + 1) * fd->getChipWidth() / 128;
     std::binomial_distribution<int> distribution(totalBlkCount, goodBlkProb);
-    unsigned long long goodBlkCount = distribution(randomGenerator);
+    unsigned long long goodBlkCount = distribution(decoderGenerator);
     unsigned long long badBlkCount = totalBlkCount - goodBlkCount;
     return badBlkCount;
   }
@@ -130,7 +130,7 @@ template <int m>
 class BCH : public Codec {
  public:
   BCH(const char *name, int _bitN, int _bitR, int _bitT)
-      : Codec(name, bitN, bitR) {
+      : Codec(name, _bitN, _bitR) {
     bitN = _bitN;
     bitR = _bitR;
     bitT = _bitT;
@@ -142,7 +142,8 @@ class BCH : public Codec {
     // delete
   }
   void encode(Block *data, ECCWord *en){};
-  bool genSyndrome(ECCWord *msg) {}
+  // the syndromes are computed in decode()
+  bool genSyndrome(ECCWord *msg) { return false; }
   ErrorType decode(ECCWord *msg, ECCWord *decoded,
                    std::set<int> *correctedPos = NULL) {
     // step 1: copy the message data
@@ -0,0 +1,152 @@
+#!/bin/bash
+# Short fixed-seed checks of the simulator, run by ctest (see CMakeLists.txt)
+# usage: check_sim.sh FaulterrorsimBinary CheckName
+
+if [ $# -ne 2 ]
+then
+    echo "usage: $0 FaulterrorsimBinary CheckName"
+    exit 1
+fi
+sim=$(realpath "$1")
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+cd "$work" || exit 1
+
+# column 2 of the DUE (or SDC) rows of the .S table: the year-N probability
+# run_system Year Outcome Options... -> prints the probability
+run_system() {
+    local year=$1 outcome=$2
+    shift 2
+    rm -f ./*.S.*
+    "$sim" "$@" > out.txt 2>&1 || { cat out.txt; exit 1; }
+    local f
+    f=$(ls ./*.S.* | grep -v "\.hist$\|\.result$" | head -1)
+    tail -16 "$f" | grep -A"$year" "^$outcome" | tail -1
+}
+
+# the DUE/SDC shares of the fault types in the last block of intervals of
+# the .S file sum to 1 per outcome
+check_shares() {
+    local f
+    f=$(ls ./*.S.* | grep -v "\.hist$\|\.result$" | head -1)
+    awk '/^95% intervals/ { delete sum }
+         / share / { sum[$1] += $(NF - 2) }
+         END {
+             n = 0
+             for (kind in sum) {
+                 printf "%s shares sum to %f\n", kind, sum[kind]
+                 if ((sum[kind] < 0.999) || (sum[kind] > 1.001)) exit 1
+                 n++
+             }
+             exit (n == 0)
+         }' "$f"
+}
+
+case $2 in
+rate_profile)
+    # ten times the fault rates in the first year
+    base=$(run_system 1 DUE 5001 20000 7 S i9 0 1e-5 1e-5 0 DDR5)
+    scaled=$(run_system 1 DUE --rate-profile 0:10,8760:1 5001 20000 7 S i9 0 1e-5 1e-5 0 DDR5)
+    echo "year-1 DUE: $base, with --rate-profile 0:10,8760:1: $scaled"
+    awk -v b="$base" -v s="$scaled" 'BEGIN { exit !(s > 4 * b) }' || exit 1
+    ;;
+shares_sum)
+    # the DUE/SDC shares of the fault types (last block of each) sum to 1
+    run_system 1 DUE 5001 200000 7 S i9 0 1e-5 1e-5 0 DDR5 > /dev/null
+    check_shares || exit 1
+    ;;
+shares_weighted)
+    # under importance sampling the shares are weighted: boosting CDEC 50x
+    # leaves its share near the unbiased ~0.001 (0.015 unweighted)
+    run_system 1 DUE --is-type-scale decoder_multi_col=50 \
+        5001 200000 7 S i9 0 1e-5 1e-5 0 DDR5 > /dev/null
+    check_shares || exit 1
+    f=$(ls ./*.S.* | grep -v "\.hist$\|\.result$" | head -1)
+    grep "^DUE share CDEC" "$f"
+    awk '/^DUE share CDEC/ { found = 1; if ($4 > 0.005) exit 1 }
+         END { exit !found }' "$f" || exit 1
+    ;;
+seed_changes)
+    # RandomSeed reaches every stream: seeds 1 and 2 give different tables
+    for seed in 1 2
+    do
+        rm -f ./*.S.*
+        "$sim" 5001 20000 $seed S i9 0 1e-5 1e-5 0 DDR5 > out.txt 2>&1 ||
+            { cat out.txt; exit 1; }
+        f=$(ls ./*.S.* | grep -v "\.hist$\|\.result$" | head -1)
+        tail -16 "$f" > table.$seed
+    done
+    ! cmp -s table.1 table.2 || { cat table.1; exit 1; }
+    ;;
+paired_identical)
+    # two copies of one system share every draw: zero paired difference
+    "$sim" 5001,5001 50000 7 S i9 0 1e-5 1e-5 0 DDR5 > out.txt 2>&1 ||
+        { cat out.txt; exit 1; }
+    grep " - " out.txt
+    awk -F'\t' '/ - / {
+             for (i = 2; i <= 4; i++) {
+                 split($i, v, /[][ ,]+/)
+                 if ((v[2] != 0) || (v[3] != 0) || (v[4] != 0)) exit 1
+             }
+             diffs++
+         }
+         /^5001/ && !/ - / { split($3, v, " "); if (v[2] > 0) due++ }
+         END { exit !((diffs == 1) && (due == 2)) }' out.txt || exit 1
+    ;;
+report_groups)
+    # the report merges seeds, but not runs of other model options, and
+    # weights the fault type shares of importance-sampled runs
+    for seed in 7 8
+    do
+        "$sim" 5001 20000 $seed S i9 0 1e-5 1e-5 0 DDR5 > out.txt 2>&1 ||
+            { cat out.txt; exit 1; }
+    done
+    "$sim" --rate-profile 0:10,8760:1 5001 20000 9 S i9 0 1e-5 1e-5 0 DDR5 \
+        > out.txt 2>&1 || { cat out.txt; exit 1; }
+    "$sim" --is-type-scale decoder_multi_col=50 \
+        5001 200000 10 S i9 0 1e-5 1e-5 0 DDR5 > out.txt 2>&1 ||
+        { cat out.txt; exit 1; }
+    "$sim" report . > report.csv || exit 1
+    grep ",DUE,ALL,1," report.csv
+    grep ",DUE_SHARE,CDEC,5," report.csv
+    # the options may hold commas: count the columns from the end
+    awk -F, '$(NF - 5) == "DUE" && $(NF - 3) == 1 {
+                 groups++; if (/,"",2,7;8,/) merged++
+             }
+             $(NF - 5) == "DUE_SHARE" && $(NF - 4) == "CDEC" &&
+                 $(NF - 3) == 5 && $(NF - 6) == 1 {
+                 weighted++; if ($(NF - 2) > 0.005) exit 1
+             }
+             END { exit !((groups == 3) && (merged == 1) && (weighted == 1)) }
+            ' report.csv || exit 1
+    ;;
+corpus_replay)
+    # replaying a recorded corpus with the same system reproduces its tables
+    for mode in record replay
+    do
+        mkdir $mode
+        (cd $mode &&
+            "$sim" --$mode-corpus ../corpus.bin 5001 20000 7 S i9 0 1e-5 1e-5 \
+                0 DDR5 > out.txt 2>&1) || { cat $mode/out.txt; exit 1; }
+    done
+    f=$(ls record/*.S.* | grep -v "\.hist$\|\.result$" | head -1)
+    f=${f#record/}
+    tail -16 "record/$f"
+    cmp "record/$f" "replay/$f" || exit 1
+    cmp "record/$f.hist" "replay/$f.hist" || exit 1
+    ;;
+paired_shared)
+    # two ECCs on one geometry draw the same fault arrivals: every run that
+    # reaches the horizon in both saw the same arrival times and domains
+    "$sim" 5001,5002 50000 7 S i9 0 1e-5 1e-5 0 DDR5 > out.txt 2>&1 ||
+        { cat out.txt; exit 1; }
+    grep "^arrivals" out.txt
+    awk '/^arrivals/ { n++; if (($8 != 0) || ($10 == 0)) exit 1 }
+         END { exit !(n == 1) }' out.txt || exit 1
+    ;;
+*)
+    echo "unknown check $2"
+    exit 1
+    ;;
+esac
+echo "$2 passed"
@@ -0,0 +1,438 @@
+/*
+Copyright 2023, The University of Texas at Austin
+All rights reserved.
+
+THIS FILE IS PART OF THE DRAM FAULT ERROR SIMULATION FRAMEWORK
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * @file: codec_bench.cc
+ * @brief Encode/decode throughput and latency of the codecs, printed as JSON
+ * @details Decoders are fed error patterns on the all-zero codeword, as the
+ * ECC classes do, with 0 up to (capability + 2) symbol (bit, for binary
+ * codes) errors. The patterns come from a fixed seed, so two builds decode
+ * exactly the same words: compare "ns_per_call" across commits and check that
+ * the ne/ce/due/sdc counts did not move.
+ *
+ * usage: codec_bench [--seed N] [--patterns N] [--calls N] [--filter STR]
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <list>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "FlipCorrection.hh"
+#include "XED.hh"
+#include "bch.hh"
+#include "hsiao.hh"
+#include "rs.hh"
+#include "sec.hh"
+#include "util.hh"
+
+typedef std::function<ErrorType(ECCWord *, ECCWord *, std::set<int> *,
+                                std::list<int> *)>
+    DecodeFn;
+
+struct BenchCodec
+{
+  std::string label;
+  Codec *codec;
+  int symSize;          //!< bits per symbol, 1 for binary codes
+  int capability;       //!< correctable errors on top of the erasures
+  int erasures;         //!< erased symbols per pattern (RS_DUAL)
+  const char *decodeOp; //!< "syndrome" where decode() is a stub
+  bool hasEncoder;      //!< encode() produces the redundancy
+  DecodeFn decode;
+};
+
+struct ErrorPattern
+{
+  ECCWord *word;
+  std::list<int> erasures;
+};
+
+struct Timing
+{
+  int calls;
+  double nsPerCall;
+  double p50, p99, max;
+};
+
+// slow decoders (e.g. RS<2,16> beyond one error) get fewer throughput calls
+static const double cellBudgetNs = 250e6;
+
+typedef std::chrono::steady_clock Clock;
+
+static double elapsedNs(Clock::time_point from, Clock::time_point to)
+{
+  return std::chrono::duration<double, std::nano>(to - from).count();
+}
+
+// per-call latencies are timed one call at a time; this is the floor
+static double timerOverheadNs()
+{
+  std::vector<double> samples(1000);
+  for (size_t i = 0; i < samples.size(); i++)
+  {
+    Clock::time_point from = Clock::now();
+    samples[i] = elapsedNs(from, Clock::now());
+  }
+  std::sort(samples.begin(), samples.end());
+  return samples[samples.size() / 2];
+}
+
+// also picks the number of throughput calls: "calls", or as many as fit in
+// cellBudgetNs, but at least one pass over the patterns
+static void summarizeLatency(std::vector<double> &latency, int calls,
+                           Timing &timing)
+{
+  double total = 0;
+  for (size_t i = 0; i < latency.size(); i++) total += latency[i];
+  timing.calls = calls;
+  if (total / latency.size() * calls > cellBudgetNs)
+    timing.calls = std::max<int>(latency.size(),
+                                 cellBudgetNs / (total / latency.size()));
+  std::sort(latency.begin(), latency.end());
+  timing.p50 = latency[latency.size() / 2];
+  timing.p99 = latency[latency.size() * 99 / 100];
+  timing.max = latency.back();
+}
+
+//------------------------------------------------------------------------------
+// "weight" random non-zero symbol errors at distinct positions, plus
+// bc.erasures erased symbols holding random (possibly zero) values
+static void genPatterns(const BenchCodec &bc, int weight, uint64_t seed,
+                        int count, std::vector<ErrorPattern> &patterns)
+{
+  std::mt19937_64 rng(seed);
+  int bitN = bc.codec->getBitN();
+  int symCount = bitN / bc.symSize;
+  int symMax = (1 << bc.symSize) - 1;
+  assert(bc.erasures + weight <= symCount);
+
+  std::vector<int> positions(symCount);
+  patterns.resize(count);
+  for (int p = 0; p < count; p++)
+  {
+    ErrorPattern &pattern = patterns[p];
+    pattern.word = new ECCWord(bitN, bc.codec->getBitK());
+    pattern.erasures.clear();
+    for (int i = 0; i < symCount; i++) positions[i] = i;
+    for (int i = 0; i < bc.erasures + weight; i++)
+    {
+      std::swap(positions[i], positions[i + rng() % (symCount - i)]);
+      int value;
+      if (i < bc.erasures)
+      {
+        pattern.erasures.push_back(positions[i]);
+        value = rng() % (symMax + 1);
+      }
+      else
+      {
+        value = 1 + rng() % symMax;
+      }
+      if (value != 0) pattern.word->invSymbol(bc.symSize, positions[i], value);
+    }
+  }
+}
+
+static void freePatterns(std::vector<ErrorPattern> &patterns)
+{
+  for (size_t p = 0; p < patterns.size(); p++) delete patterns[p].word;
+  patterns.clear();
+}
+
+//------------------------------------------------------------------------------
+static Timing benchDecode(const BenchCodec &bc,
+                          std::vector<ErrorPattern> &patterns, int calls,
+                          long long outcomes[NUMERRORTYPES])
+{
+  Timing timing;
+  ECCWord decoded(bc.codec->getBitN(), bc.codec->getBitK());
+  std::set<int> correctedPos;
+  int count = patterns.size();
+
+  // warm-up pass, which also classifies every pattern once
+  for (int t = 0; t < NUMERRORTYPES; t++) outcomes[t] = 0;
+  for (int p = 0; p < count; p++)
+  {
+    correctedPos.clear();
+    outcomes[bc.decode(patterns[p].word, &decoded, &correctedPos,
+                       &patterns[p].erasures)]++;
+  }
+
+  std::vector<double> latency(count);
+  for (int p = 0; p < count; p++)
+  {
+    correctedPos.clear();
+    Clock::time_point from = Clock::now();
+    bc.decode(patterns[p].word, &decoded, &correctedPos,
+              &patterns[p].erasures);
+    latency[p] = elapsedNs(from, Clock::now());
+  }
+  summarizeLatency(latency, calls, timing);
+
+  int sink = 0;
+  Clock::time_point from = Clock::now();
+  for (int i = 0, p = 0; i < timing.calls; i++)
+  {
+    correctedPos.clear();
+    sink += bc.decode(patterns[p].word, &decoded, &correctedPos,
+                      &patterns[p].erasures);
+    if (++p == count) p = 0;
+  }
+  timing.nsPerCall = elapsedNs(from, Clock::now()) / timing.calls;
+  // keeps the loop alive; decoders have no side effects the compiler sees
+  if (sink == -1) printf("%d\n", sink);
+  return timing;
+}
+
+static Timing benchEncode(const BenchCodec &bc, uint64_t seed, int count,
+                          int calls)
+{
+  Timing timing;
+  std::mt19937_64 rng(seed);
+  int bitN = bc.codec->getBitN(), bitK = bc.codec->getBitK();
+  std::vector<ECCWord *> data(count);
+  for (int p = 0; p < count; p++)
+  {
+    data[p] = new ECCWord(bitN, bitK);
+    for (int i = 0; i < bitK; i++) data[p]->setBit(i, rng() & 1);
+  }
+  ECCWord encoded(bitN, bitK);
+
+  for (int p = 0; p < count; p++) bc.codec->encode(data[p], &encoded);
+
+  std::vector<double> latency(count);
+  for (int p = 0; p < count; p++)
+  {
+    Clock::time_point from = Clock::now();
+    bc.codec->encode(data[p], &encoded);
+    latency[p] = elapsedNs(from, Clock::now());
+  }
+  summarizeLatency(latency, calls, timing);
+
+  Clock::time_point from = Clock::now();
+  for (int i = 0, p = 0; i < timing.calls; i++)
+  {
+    bc.codec->encode(data[p], &encoded);
+    if (++p == count) p = 0;
+  }
+  timing.nsPerCall = elapsedNs(from, Clock::now()) / timing.calls;
+
+  for (int p = 0; p < count; p++) delete data[p];
+  return timing;
+}
+
+//------------------------------------------------------------------------------
+static void printResult(bool &first, const BenchCodec &bc, const char *op,
+                        int weight, const Timing &timing,
+                        const long long *outcomes)
+{
+  printf("%s\n    {\"codec\": \"%s\", \"op\": \"%s\", \"n\": %d, \"k\": %d, "
+         "\"symbol_bits\": %d, \"capability\": %d, \"erasures\": %d, "
+         "\"weight\": %d, \"calls\": %d, \"ns_per_call\": %.1f, "
+         "\"mcalls_per_s\": %.3f, \"p50_ns\": %.0f, \"p99_ns\": %.0f, "
+         "\"max_ns\": %.0f",
+         first ? "" : ",", bc.label.c_str(), op, bc.codec->getBitN(),
+         bc.codec->getBitK(), bc.symSize, bc.capability, bc.erasures, weight,
+         timing.calls, timing.nsPerCall, 1e3 / timing.nsPerCall, timing.p50,
+         timing.p99, timing.max);
+  if (outcomes != NULL)
+  {
+    printf(", \"ne\": %lld, \"ce\": %lld, \"due\": %lld, \"sdc\": %lld",
+           outcomes[NE], outcomes[CE], outcomes[DUE], outcomes[SDC]);
+  }
+  printf("}");
+  first = false;
+}
+
+//------------------------------------------------------------------------------
+static DecodeFn plainDecode(Codec *codec)
+{
+  return [codec](ECCWord *msg, ECCWord *decoded, std::set<int> *correctedPos,
+                 std::list<int> *) {
+    return codec->decode(msg, decoded, correctedPos);
+  };
+}
+
+// RS2 only generates syndromes (its decode() always says SDC)
+static DecodeFn syndromeOnly(Codec *codec)
+{
+  return [codec](ECCWord *msg, ECCWord *, std::set<int> *, std::list<int> *) {
+    if (codec->genSyndrome(msg)) return DUE;
+    return msg->isZero() ? NE : SDC;
+  };
+}
+
+static DecodeFn erasureDecode(RS_DUAL<2, 8> *codec)
+{
+  return [codec](ECCWord *msg, ECCWord *decoded, std::set<int> *correctedPos,
+                 std::list<int> *erasures) {
+    return codec->decode(msg, decoded, correctedPos, erasures);
+  };
+}
+
+// the configurations below are the ones the ECC schemes of this tree use
+static void addCodecs(std::vector<BenchCodec> &list)
+{
+  Codec *c;
+
+  c = new RS<2, 8>("SSC", 18, 2, 1);
+  list.push_back({"RS<2,8>(18,16) SSC", c, 8, 1, 0, "decode", false,
+                  plainDecode(c)});
+  c = new RS<2, 8>("DSC", 36, 4, 2);
+  list.push_back({"RS<2,8>(36,32) DSC", c, 8, 2, 0, "decode", false,
+                  plainDecode(c)});
+  c = new RS<2, 8>("QPC", 72, 8, 4);
+  list.push_back({"RS<2,8>(72,64) QPC", c, 8, 4, 0, "decode", false,
+                  plainDecode(c)});
+  c = new RS<2, 16>("3.5PC", 18, 2, 1);
+  list.push_back({"RS<2,16>(18,16) SSC", c, 16, 1, 0, "decode", false,
+                  plainDecode(c)});
+  c = new RS2<2, 8>("RS2", 36, 3, 1, 0, 0, 0);
+  list.push_back({"RS2<2,8>(36,33)", c, 8, 1, 0, "syndrome", false,
+                  syndromeOnly(c)});
+  for (int erasures = 0; erasures <= 8; erasures += 4)
+  {
+    // sized for exactly "erasures" erased symbols, like the two DUO decoders
+    RS_DUAL<2, 8> *dual = new RS_DUAL<2, 8>("RS_DUAL", 76, 12, erasures);
+    list.push_back({"RS_DUAL<2,8>(76,64) " + std::to_string(erasures) +
+                        " erasures",
+                    dual, 8, (12 - erasures) / 2, erasures, "decode", false,
+                    erasureDecode(dual)});
+  }
+  c = new BCH<10>("TEC BCH", 544, 30, 3);
+  list.push_back({"BCH<10>(544,514) TEC", c, 1, 3, 0, "decode", false,
+                  plainDecode(c)});
+  c = new Hsiao("SEC-DED (Hsiao)", 72, 8);
+  list.push_back({"Hsiao(72,64) SEC-DED", c, 1, 1, 0, "decode", true,
+                  plainDecode(c)});
+  c = new SEC("SEC", 136, 8);
+  list.push_back({"SEC(136,128)", c, 1, 1, 0, "decode", true,
+                  plainDecode(c)});
+  c = new b8CRC("BitFlip 8bCRC", 136, 8);
+  list.push_back({"b8CRC(136,128)", c, 1, 1, 0, "decode", true,
+                  plainDecode(c)});
+  c = new b16CRC("BitFlip 16bCRC", 144, 16);
+  list.push_back({"b16CRC(144,128)", c, 1, 1, 0, "decode", true,
+                  plainDecode(c)});
+  c = new CRC8_ATM("CRC8-ATM", 136, 8);
+  list.push_back({"CRC8_ATM(136,128)", c, 1, 1, 0, "decode", true,
+                  plainDecode(c)});
+}
+
+//------------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  uint64_t seed = 1;
+  int patternCnt = 1024;
+  int calls = 20000;
+  const char *filter = NULL;
+  for (int i = 1; i < argc; i++)
+  {
+    if (i + 1 >= argc)
+    {
+      printf("Missing value for %s\n", argv[i]);
+      exit(1);
+    }
+    if (strcmp(argv[i], "--seed") == 0)
+      seed = strtoull(argv[++i], NULL, 10);
+    else if (strcmp(argv[i], "--patterns") == 0)
+      patternCnt = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--calls") == 0)
+      calls = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--filter") == 0)
+      filter = argv[++i];
+    else
+    {
+      printf("Unknown option %s\n", argv[i]);
+      printf("usage: %s [--seed N] [--patterns N] [--calls N] "
+             "[--filter STR]\n", argv[0]);
+      exit(1);
+    }
+  }
+  if (patternCnt <= 0 || calls <= 0)
+  {
+    printf("--patterns and --calls must be positive\n");
+    exit(1);
+  }
+
+  std::vector<BenchCodec> list;
+  addCodecs(list);
+
+  printf("{\"benchmark\": \"codec_bench\", \"seed\": %llu, \"patterns\": %d, "
+         "\"calls\": %d, \"timer_overhead_ns\": %.0f, \"results\": [",
+         (unsigned long long)seed, patternCnt, calls, timerOverheadNs());
+  bool first = true;
+  for (size_t idx = 0; idx < list.size(); idx++)
+  {
+    const BenchCodec &bc = list[idx];
+    if (filter != NULL && bc.label.find(filter) == std::string::npos)
+      continue;
+    uint64_t codecSeed = splitmix64(seed ^ splitmix64(idx));
+
+    if (bc.hasEncoder)
+    {
+      Timing timing = benchEncode(bc, codecSeed, patternCnt, calls);
+      printResult(first, bc, "encode", 0, timing, NULL);
+    }
+    for (int weight = 0; weight <= bc.capability + 2; weight++)
+    {
+      std::vector<ErrorPattern> patterns;
+      genPatterns(bc, weight, splitmix64(codecSeed + weight + 1), patternCnt,
+                  patterns);
+      long long outcomes[NUMERRORTYPES];
+      Timing timing = benchDecode(bc, patterns, calls, outcomes);
+      printResult(first, bc, bc.decodeOp, weight, timing, outcomes);
+      freePatterns(patterns);
+    }
+    fflush(stdout);
+  }
+  printf("\n]}\n");
+
+  for (size_t idx = 0; idx < list.size(); idx++) delete list[idx].codec;
+  return 0;
+}
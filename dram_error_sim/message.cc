@@ -55,6 +55,7 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #include "uint128_t.h"
 #include "message.hh"
+#include "Profile.hh"
 
 //#include "DRAM.hh"
 
@@ -64,7 +65,9 @@ POSSIBILITY OF SUCH DAMAGE.
 Block::Block(int bitSize) {
   bitN = bitSize;
 
-  bitArr = new bool[bitN+4];
+  // the padding past bitN is read by some codecs' symbol extraction;
+  // zero it once here so results never depend on heap contents.
+  bitArr = new bool[bitN+4]();
   errorDQ = 0;
   reset();
 }
@@ -168,6 +171,7 @@ void Block::print() const {
 //----------------------------------------------------------
 void ECCWord::extract(Block* data, ECCLayout layout, int pos,
                       int channelWidth, MSGConfig message_config) {
+  PROFILE_SCOPE(PROF_EXTRACT);
   if (layout == LINEAR) {
     memcpy(bitArr, &(data->bitArr[channelWidth * pos]),
            sizeof(bool) * channelWidth);
@@ -0,0 +1,339 @@
+/*
+Copyright 2023, The University of Texas at Austin
+All rights reserved.
+
+THIS FILE IS PART OF THE DRAM FAULT ERROR SIMULATION FRAMEWORK
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * @file: sim_bench.cc
+ * @brief Trials per second of short, fixed-seed simulations of a set of
+ * representative systems, printed as JSON
+ * @details Each case is the run
+ *   faulterrorsim ID runs seed S i9 0 1e-5 1e-5 module DRAMTYPE  (system)
+ *   faulterrorsim ID runs seed b b module DRAMTYPE               (scenario)
+ * in a child process, so that the global DRAM configuration starts afresh
+ * and the peak RSS is the case's own. The child reports the time spent in
+ * Tester::test() and Tester::getCounterChecksum(); an unchanged checksum
+ * means unchanged DUE/SDC counters. Run it from a directory holding
+ * input_FIT.conf (e.g. build/); the log files go to a scratch directory.
+ *
+ * usage: sim_bench [--runs N] [--scenario-runs N] [--seed N] [--filter STR]
+ *                  [--log-dir DIR]
+ */
+
+#include <assert.h>
+#include <dirent.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "Config.hh"
+#include "DomainGroup.hh"
+#include "ECC.hh"
+#include "Fault.hh"
+#include "Scrubber.hh"
+#include "Systems.hh"
+#include "Tester.hh"
+
+struct BenchCase
+{
+  int id;
+  const char *dramType;
+  const char *faults;  //!< scenario fault types, NULL for system evaluation
+  const char *note;
+};
+
+// 6004 (LPDDR5 on-die RS<2,8>(34,32)) is left out: it aborts in free()
+// during its first runs
+static const BenchCase benchCases[] = {
+    {5001, "DDR5", NULL, "DDR5 AMD chipkill, x4"},
+    {5002, "DDR5", NULL, "DDR5 AMD chipkill, x4, simple model"},
+    {5003, "DDR5", NULL, "DDR5 AMD chipkill, x4 (9 chips)"},
+    {5004, "DDR5", NULL, "DDR5 AMD chipkill, x4 (9 chips), simple model"},
+    {4021, "HBM3", NULL, "HBM3 2xRS8 + AIECC"},
+    {6000, "LPDDR5", NULL, "LPDDR5 on-die SEC"},
+    {6001, "LPDDR5", NULL, "LPDDR5 on-die RS1"},
+    {6002, "LPDDR5", NULL, "LPDDR5 on-die RS2"},
+    {6003, "LPDDR5", NULL, "LPDDR5 on-die SEC"},
+    {6005, "LPDDR5", NULL, "LPDDR5 on-die RS"},
+    {331, "DDR4", NULL, "DUO 36bx4, retirement"},
+    {130, "DDR4", NULL, "XED SDDC"},
+    {5001, "DDR5", "b b", "DDR5 AMD chipkill, x4"},
+    {4021, "HBM3", "b b", "HBM3 2xRS8 + AIECC"},
+    {6002, "LPDDR5", "b b", "LPDDR5 on-die RS2"},
+    {331, "DDR4", "b b", "DUO 36bx4, retirement"},
+    {130, "DDR4", "b b", "XED SDDC"},
+};
+
+//! sent from the child running a case to sim_bench
+struct CaseResult
+{
+  double seconds;     //!< time spent in Tester::test()
+  uint64_t checksum;  //!< Tester::getCounterChecksum()
+};
+
+static std::string caseLabel(const BenchCase &bc)
+{
+  std::string label = std::to_string(bc.id) + " " + bc.dramType;
+  label += (bc.faults == NULL) ? " S" : std::string(" ") + bc.faults;
+  return label;
+}
+
+//------------------------------------------------------------------------------
+// the work of main.cc for one case; never returns
+static void runCase(const BenchCase &bc, long runs, const char *seed,
+                    int resultFd)
+{
+  // the testers print their progress
+  if (freopen("/dev/null", "w", stdout) == NULL) _exit(2);
+
+  char dramType[16];
+  snprintf(dramType, sizeof(dramType), "%s", bc.dramType);
+  setup_configs(dramType);
+  module = 0;
+  seedRandom(atoll(seed));
+
+  char filePrefix[256];
+  DomainGroup *dg = NULL;
+  ECC *ecc = NULL;
+  if (!buildSystem(bc.id, seed, dg, ecc, filePrefix)) _exit(3);
+
+  // trailing module and DRAM type, as main.cc passes them
+  std::vector<std::string> faults;
+  Tester *tester;
+  Scrubber *scrubber;
+  if (bc.faults == NULL)
+  {
+    const char *rates[] = {"i9", "0", "1e-5", "1e-5"};
+    faults.assign(rates, rates + 4);
+    tester = new TesterSystem();
+    scrubber = new PeriodicScrubber(8);
+  }
+  else
+  {
+    std::string types(bc.faults);
+    size_t pos = 0;
+    while (pos < types.size())
+    {
+      size_t space = types.find(' ', pos);
+      if (space == std::string::npos) space = types.size();
+      faults.push_back(types.substr(pos, space - pos));
+      pos = space + 1;
+    }
+    tester = new TesterScenario();
+    scrubber = new NoScrubber();
+  }
+  faults.push_back("0");
+  faults.push_back(bc.dramType);
+
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  tester->test(dg, ecc, scrubber, runs, filePrefix, faults.size(),
+               &faults[0]);
+  CaseResult result;
+  result.seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  result.checksum = tester->getCounterChecksum();
+  if (write(resultFd, &result, sizeof(result)) != sizeof(result)) _exit(4);
+  fflush(stdout);
+  _exit(0);
+}
+
+//------------------------------------------------------------------------------
+static void removeDir(const char *dirName)
+{
+  DIR *dir = opendir(dirName);
+  if (dir == NULL) return;
+  struct dirent *entry;
+  while ((entry = readdir(dir)) != NULL)
+  {
+    if (entry->d_name[0] == '.') continue;
+    unlink((std::string(dirName) + "/" + entry->d_name).c_str());
+  }
+  closedir(dir);
+  rmdir(dirName);
+}
+
+//------------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  long runs = 20000, scenarioRuns = 20000;
+  std::string seed = "7";
+  const char *filter = NULL;
+  const char *logDir = NULL;
+  for (int i = 1; i < argc; i++)
+  {
+    if (i + 1 >= argc)
+    {
+      printf("Missing value for %s\n", argv[i]);
+      exit(1);
+    }
+    if (strcmp(argv[i], "--runs") == 0)
+      runs = atol(argv[++i]);
+    else if (strcmp(argv[i], "--scenario-runs") == 0)
+      scenarioRuns = atol(argv[++i]);
+    else if (strcmp(argv[i], "--seed") == 0)
+      seed = argv[++i];
+    else if (strcmp(argv[i], "--filter") == 0)
+      filter = argv[++i];
+    else if (strcmp(argv[i], "--log-dir") == 0)
+      logDir = argv[++i];
+    else
+    {
+      printf("Unknown option %s\n", argv[i]);
+      printf("usage: %s [--runs N] [--scenario-runs N] [--seed N] "
+             "[--filter STR] [--log-dir DIR]\n", argv[0]);
+      exit(1);
+    }
+  }
+  if (runs <= 0 || scenarioRuns <= 0)
+  {
+    printf("--runs and --scenario-runs must be positive\n");
+    exit(1);
+  }
+
+  // the cases run in the log directory, which links the FIT table
+  char fitPath[PATH_MAX];
+  if (realpath("input_FIT.conf", fitPath) == NULL)
+  {
+    printf("Run sim_bench from a directory holding input_FIT.conf\n");
+    exit(1);
+  }
+  char scratch[] = "/tmp/sim_bench.XXXXXX";
+  std::string runDir;
+  if (logDir != NULL)
+  {
+    mkdir(logDir, 0755);
+    runDir = logDir;
+  }
+  else if (mkdtemp(scratch) != NULL)
+  {
+    runDir = scratch;
+  }
+  else
+  {
+    printf("Cannot create a scratch directory\n");
+    exit(1);
+  }
+  std::string fitLink = runDir + "/input_FIT.conf";
+  unlink(fitLink.c_str());
+  if (symlink(fitPath, fitLink.c_str()) != 0)
+  {
+    printf("Cannot link %s into %s\n", fitPath, runDir.c_str());
+    exit(1);
+  }
+
+  printf("{\"benchmark\": \"sim_bench\", \"seed\": \"%s\", \"runs\": %ld, "
+         "\"scenario_runs\": %ld, \"results\": [",
+         seed.c_str(), runs, scenarioRuns);
+  bool first = true;
+  int failed = 0;
+  uint64_t total = 14695981039346656037ull;
+  for (size_t idx = 0; idx < sizeof(benchCases) / sizeof(benchCases[0]);
+       idx++)
+  {
+    const BenchCase &bc = benchCases[idx];
+    std::string label = caseLabel(bc);
+    if (filter != NULL && label.find(filter) == std::string::npos) continue;
+    long caseRuns = (bc.faults == NULL) ? runs : scenarioRuns;
+
+    int pipeFd[2];
+    if (pipe(pipeFd) != 0)
+    {
+      printf("pipe() failed\n");
+      exit(1);
+    }
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+      printf("fork() failed\n");
+      exit(1);
+    }
+    if (pid == 0)
+    {
+      close(pipeFd[0]);
+      if (chdir(runDir.c_str()) != 0) _exit(2);
+      runCase(bc, caseRuns, seed.c_str(), pipeFd[1]);
+    }
+    close(pipeFd[1]);
+    CaseResult result;
+    bool received = read(pipeFd[0], &result, sizeof(result)) == sizeof(result);
+    close(pipeFd[0]);
+    int status;
+    struct rusage usage;
+    wait4(pid, &status, 0, &usage);
+
+    printf("%s\n    {\"case\": \"%s\", \"id\": %d, \"dram\": \"%s\", "
+           "\"mode\": \"%s\", \"faults\": \"%s\", \"note\": \"%s\", "
+           "\"runs\": %ld, ",
+           first ? "" : ",", label.c_str(), bc.id, bc.dramType,
+           (bc.faults == NULL) ? "system" : "scenario",
+           (bc.faults == NULL) ? "i9 0 1e-5 1e-5" : bc.faults, bc.note,
+           caseRuns);
+    first = false;
+    if (!received || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+      if (WIFSIGNALED(status))
+        printf("\"status\": \"killed by signal %d\"}", WTERMSIG(status));
+      else
+        printf("\"status\": \"exit %d\"}", WEXITSTATUS(status));
+      failed++;
+      continue;
+    }
+    total = (total ^ result.checksum) * 1099511628211ull;
+    printf("\"status\": \"ok\", \"seconds\": %.3f, \"trials_per_s\": %.1f, "
+           "\"peak_rss_kb\": %ld, \"checksum\": \"%016llx\"}",
+           result.seconds, caseRuns / result.seconds, usage.ru_maxrss,
+           (unsigned long long)result.checksum);
+    fflush(stdout);
+  }
+  printf("\n], \"failed\": %d, \"checksum\": \"%016llx\"}\n", failed,
+         (unsigned long long)total);
+
+  if (logDir == NULL) removeDir(runDir.c_str());
+  return (failed == 0) ? 0 : 1;
+}
@@ -47,6 +47,8 @@ POSSIBILITY OF SUCH DAMAGE.
 #define __UTIL_HH__
 
 #include <stdint.h>
+#include <stdlib.h>
+#include <random>
 
 typedef unsigned POLY;
 typedef int INDEX;
@@ -55,6 +57,74 @@ void printPoly(POLY p, int m);
 POLY multiPoly(POLY p1, POLY p2);
 int degreePoly(POLY p);
 
+//! SplitMix64 mixing function: well-spread seeds from consecutive integers
+inline uint64_t splitmix64(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+// randomGenerator draws the fault timeline: the arrivals, their domains and
+// types, and the faults with their errors (see FaultDraws). The decoders draw
+// from decoderGenerator only, so ECCs that consume a different number of
+// draws still see the same faults.
+extern std::default_random_engine randomGenerator;
+extern std::default_random_engine decoderGenerator;
+//! rand() of the fault timeline: uniform in [0, RAND_MAX]
+inline int timelineRand() {
+  return std::uniform_int_distribution<int>(0, RAND_MAX)(randomGenerator);
+}
+//! rand() of the decoders: uniform in [0, RAND_MAX]
+inline int decoderRand() {
+  return std::uniform_int_distribution<int>(0, RAND_MAX)(decoderGenerator);
+}
+//! seed rand(), randomGenerator and decoderGenerator from one 64-bit seed
+void seedRandom(uint64_t seed);
+
+//! 64 bits of the fault timeline, e.g. the seed of a FaultDraws
+inline uint64_t timelineSeed() {
+  uint64_t hi = randomGenerator();
+  return (hi << 32) ^ randomGenerator();
+}
+
+/** @class FaultDraws
+ * \brief Draws of one fault and its errors from a seed of their own
+ * @details Within the scope, the random engines continue from "seed" (see
+ * seedRandom()) and the fault timeline is restored on exit. So the timeline
+ * advances by the same draws per fault whatever the fault model and the ECC
+ * consume, and systems run on one seed keep sharing their arrivals.
+ */
+class FaultDraws {
+ public:
+  FaultDraws(uint64_t seed) : timeline(randomGenerator) { seedRandom(seed); }
+  ~FaultDraws() { randomGenerator = timeline; }
+
+ private:
+  std::default_random_engine timeline;
+};
+
+/** @class DecoderDraws
+ * \brief Lends the fault methods to a decoder within its scope
+ * @details A decoder that regenerates errors of its own (e.g. of a second
+ * block) calls the fault methods, which draw from randomGenerator. Within the
+ * scope, randomGenerator continues decoderGenerator and the fault timeline is
+ * restored on exit.
+ */
+class DecoderDraws {
+ public:
+  DecoderDraws() : timeline(randomGenerator) {
+    randomGenerator = decoderGenerator;
+  }
+  ~DecoderDraws() {
+    decoderGenerator = randomGenerator;
+    randomGenerator = timeline;
+  }
+
+ private:
+  std::default_random_engine timeline;
+};
+
 typedef bool DataArrType;
 // typedef uint16_t DataArrType;
 // typedef uint8_t DataArrType;